@@ -0,0 +1,180 @@
+// Bench.cpp
+// ベンチマークの共通部品の実装
+
+#include "Bench.h"
+#include <stdio.h>
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+#include "infrastructure/MemoryManager.h"
+
+namespace Bench
+{
+    using Infrastructure::MemoryManager;
+
+    void Summary::add(double value)
+    {
+        if (count == 0 || value < minimum)
+        {
+            minimum = value;
+        }
+        if (count == 0 || value > maximum)
+        {
+            maximum = value;
+        }
+        total += value;
+        count++;
+    }
+
+    Report::Report(const char *name) : json("{"), needsComma(false)
+    {
+        add("name", name);
+    }
+
+    void Report::addKey(const char *key)
+    {
+        if (needsComma)
+        {
+            json += ",";
+        }
+        json += "\"";
+        json += key;
+        json += "\":";
+        needsComma = true;
+    }
+
+    void Report::add(const char *key, double value)
+    {
+        char text[32];
+        snprintf(text, sizeof(text), "%.1f", value);
+        addKey(key);
+        json += text;
+    }
+
+    void Report::add(const char *key, unsigned long value)
+    {
+        addKey(key);
+        json += std::to_string(value);
+    }
+
+    void Report::add(const char *key, const char *value)
+    {
+        addKey(key);
+        json += "\"";
+        json += value;
+        json += "\"";
+    }
+
+    void Report::add(const char *key, const Summary &summary)
+    {
+        beginObject(key);
+        add("mean", summary.getMean());
+        add("min", summary.getMin());
+        add("max", summary.getMax());
+        endObject();
+    }
+
+    void Report::beginObject(const char *key)
+    {
+        addKey(key);
+        json += "{";
+        needsComma = false;
+    }
+
+    void Report::endObject()
+    {
+        json += "}";
+        needsComma = true;
+    }
+
+    void Report::print()
+    {
+        printf("BENCH %s}\n", json.c_str());
+        fflush(stdout);
+    }
+
+    RefreshSample measureRefresh(Application::ScheduleApplicationService &app)
+    {
+        MemoryManager::PhaseStats fetchBefore = MemoryManager::getPhaseStats(MemoryManager::Phase::FETCH);
+        MemoryManager::PhaseStats parseBefore = MemoryManager::getPhaseStats(MemoryManager::Phase::PARSE);
+        MemoryManager::PhaseStats renderBefore = MemoryManager::getPhaseStats(MemoryManager::Phase::RENDER);
+        unsigned long bytesBefore = TFT_eSPI::panelStats().bytes();
+        ESP.resetMinFreeHeap();
+
+        RefreshSample sample;
+        Domain::ScheduleSnapshot snapshot;
+
+        Stopwatch fetchWatch;
+        Application::ScheduleApplicationService::RefreshMetrics metrics = app.fetchAllData(snapshot);
+        sample.fetchMicros = fetchWatch.elapsedMicros();
+
+        Stopwatch renderWatch;
+        app.applyFetchedData(snapshot, metrics);
+        sample.renderMicros = renderWatch.elapsedMicros();
+
+        const MemoryManager::PhaseStats &fetch = MemoryManager::getPhaseStats(MemoryManager::Phase::FETCH);
+        const MemoryManager::PhaseStats &parse = MemoryManager::getPhaseStats(MemoryManager::Phase::PARSE);
+        const MemoryManager::PhaseStats &render = MemoryManager::getPhaseStats(MemoryManager::Phase::RENDER);
+
+        sample.result = metrics.result;
+        sample.fetchMillis = metrics.fetchMillis;
+        sample.requests = metrics.updateStats.requestCount;
+        sample.handshakes = metrics.updateStats.handshakeCount;
+        sample.requestBytes = metrics.updateStats.requestBytes;
+        sample.headerBytes = metrics.updateStats.headerBytes;
+        sample.bodyBytes = metrics.updateStats.bodyBytes;
+        sample.fetchAllocations = fetch.allocations - fetchBefore.allocations;
+        sample.parseAllocations = parse.allocations - parseBefore.allocations;
+        sample.renderAllocations = render.allocations - renderBefore.allocations;
+        // 解析は取得の段階の中で行うため、取得と描画の合計が更新全体になる
+        sample.allocatedBytes = (fetch.allocatedBytes - fetchBefore.allocatedBytes) +
+                                (render.allocatedBytes - renderBefore.allocatedBytes);
+        sample.heapHighWater = EspClass::HEAP_SIZE - ESP.getMinFreeHeap();
+        sample.jsonPeakBytes = metrics.updateStats.jsonPeakBytes;
+        sample.bytesDrawn = TFT_eSPI::panelStats().bytes() - bytesBefore;
+        sample.directDraws = app.getLastRefreshMetrics().directDraws;
+        return sample;
+    }
+
+    void RefreshSummary::add(const RefreshSample &sample)
+    {
+        fetchMicros.add(sample.fetchMicros);
+        fetchMillis.add(sample.fetchMillis);
+        renderMicros.add(sample.renderMicros);
+        requests.add(sample.requests);
+        handshakes.add(sample.handshakes);
+        requestBytes.add(sample.requestBytes);
+        headerBytes.add(sample.headerBytes);
+        bodyBytes.add(sample.bodyBytes);
+        fetchAllocations.add(sample.fetchAllocations);
+        parseAllocations.add(sample.parseAllocations);
+        renderAllocations.add(sample.renderAllocations);
+        allocatedBytes.add(sample.allocatedBytes);
+        heapHighWater.add(sample.heapHighWater);
+        jsonPeakBytes.add(sample.jsonPeakBytes);
+        bytesDrawn.add(sample.bytesDrawn);
+        directDraws.add(sample.directDraws);
+    }
+
+    void RefreshSummary::write(Report &report, const char *key) const
+    {
+        report.beginObject(key);
+        report.add("refreshes", getCount());
+        report.add("fetch_us", fetchMicros);
+        report.add("fetch_ms", fetchMillis);
+        report.add("render_us", renderMicros);
+        report.add("requests", requests);
+        report.add("handshakes", handshakes);
+        report.add("request_bytes", requestBytes);
+        report.add("header_bytes", headerBytes);
+        report.add("body_bytes", bodyBytes);
+        report.add("fetch_allocs", fetchAllocations);
+        report.add("parse_allocs", parseAllocations);
+        report.add("render_allocs", renderAllocations);
+        report.add("alloc_bytes", allocatedBytes);
+        report.add("heap_high_water", heapHighWater);
+        report.add("json_peak", jsonPeakBytes);
+        report.add("bytes_drawn", bytesDrawn);
+        report.add("direct_draws", directDraws);
+        report.endObject();
+    }
+}
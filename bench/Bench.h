@@ -0,0 +1,145 @@
+// Bench.h
+// ホストで動かすベンチマークの共通部品（計時、集計、1行のJSONでの出力）
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+#include <time.h>
+#include <chrono>
+#include <string>
+#include "application/ScheduleApplicationService.h"
+
+namespace Bench
+{
+    // 記録したレスポンスの最初のスロット（2024-06-01 09:00 JST）と、スロットの長さ
+    constexpr time_t FIXTURE_FIRST_SLOT = 1717200000;
+    constexpr long SLOT_SECONDS = 2 * 60 * 60;
+
+    // コマンドラインで指定する設定
+    struct Options
+    {
+        unsigned int iterations; // 繰り返しの回数（ベンチマークごとに意味が決まる）
+
+        Options() : iterations(20) {}
+    };
+
+    // ホストの実時間での経過時間（仮想の時計を進めるdelay()の影響を受けない）
+    class Stopwatch
+    {
+    public:
+        Stopwatch() : start(std::chrono::steady_clock::now()) {}
+
+        double elapsedMicros() const
+        {
+            return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        }
+
+    private:
+        std::chrono::steady_clock::time_point start;
+    };
+
+    // サンプルの平均・最小・最大
+    class Summary
+    {
+    public:
+        Summary() : count(0), total(0), minimum(0), maximum(0) {}
+
+        void add(double value);
+        unsigned long getCount() const { return count; }
+        double getMean() const { return count > 0 ? total / count : 0; }
+        double getMin() const { return minimum; }
+        double getMax() const { return maximum; }
+
+    private:
+        unsigned long count;
+        double total;
+        double minimum;
+        double maximum;
+    };
+
+    // 結果を"BENCH {...}"の1行で出力する（ログからgrepしてjqなどで比較できるように）
+    class Report
+    {
+    public:
+        explicit Report(const char *name);
+
+        void add(const char *key, double value);
+        void add(const char *key, unsigned long value);
+        void add(const char *key, const char *value);
+        void add(const char *key, const Summary &summary);
+
+        // 入れ子のオブジェクト
+        void beginObject(const char *key);
+        void endObject();
+
+        void print();
+
+    private:
+        std::string json;
+        bool needsComma;
+
+        void addKey(const char *key);
+    };
+
+    // 1回のデータ更新（取得・解析・描画）の計測値
+    struct RefreshSample
+    {
+        Application::ScheduleApplicationService::RefreshResult result;
+        double fetchMicros;          // 取得と解析
+        unsigned long fetchMillis;   // millis()で測った取得と解析（模擬した応答時間を含む）
+        double renderMicros;         // 描画（再描画しなかった場合は下部情報バーだけ）
+        unsigned long requests;      // HTTPリクエスト数
+        unsigned long handshakes;    // ハンドシェイク数
+        unsigned long requestBytes;  // 送信したリクエスト行とヘッダのバイト数
+        unsigned long headerBytes;   // 受信したステータス行とヘッダのバイト数
+        unsigned long bodyBytes;     // 受信したボディのバイト数
+        uint32_t fetchAllocations;   // 取得段階の確保回数（解析を含む）
+        uint32_t parseAllocations;   // 解析段階の確保回数
+        uint32_t renderAllocations;  // 描画段階の確保回数
+        uint32_t allocatedBytes;     // 更新全体で確保したバイト数
+        uint32_t heapHighWater;      // 更新中のヒープの最大使用量（ESP32相当の空きヒープの最小値から）
+        unsigned long jsonPeakBytes; // 解析に使ったメモリの最大値
+        unsigned long bytesDrawn;    // パネルに送ったバイト数
+        unsigned long directDraws;   // スプライトを確保できず直接描画した回数
+    };
+
+    // データ更新を1回行って計測する
+    RefreshSample measureRefresh(Application::ScheduleApplicationService &app);
+
+    // RefreshSampleの項目ごとの集計
+    class RefreshSummary
+    {
+    public:
+        void add(const RefreshSample &sample);
+        unsigned long getCount() const { return fetchMicros.getCount(); }
+
+        // 集計をkeyのオブジェクトとして書き出す
+        void write(Report &report, const char *key) const;
+
+    private:
+        Summary fetchMicros;
+        Summary fetchMillis;
+        Summary renderMicros;
+        Summary requests;
+        Summary handshakes;
+        Summary requestBytes;
+        Summary headerBytes;
+        Summary bodyBytes;
+        Summary fetchAllocations;
+        Summary parseAllocations;
+        Summary renderAllocations;
+        Summary allocatedBytes;
+        Summary heapHighWater;
+        Summary jsonPeakBytes;
+        Summary bytesDrawn;
+        Summary directDraws;
+    };
+
+    // 各ベンチマーク
+    void runReplay(const Options &options);
+    void runNameLookup(const Options &options);
+    void runFetchLatency(const Options &options);
+}
+
+#endif // BENCH_H
@@ -0,0 +1,76 @@
+// FetchLatencyBench.cpp
+// サーバーの応答時間を模擬し、一括取得とエンドポイントごとの取得を比べる
+
+#include "Bench.h"
+#include <NativeHal.h>
+#include "application/ScheduleService.h"
+#include "infrastructure/APIScheduleRepository.h"
+#include "infrastructure/TFTDisplayService.h"
+#include "support/FileNetworkService.h"
+
+namespace Bench
+{
+    using Infrastructure::APIScheduleRepository;
+
+    namespace
+    {
+        // 1リクエストあたりの応答時間（TLSの往復を含めた実機のおおよその値）
+        constexpr unsigned long LATENCY_MILLIS = 150;
+
+        struct FetchConfig
+        {
+            const char *name;
+            APIScheduleRepository::FetchMode mode;
+            size_t maxInFlight;
+        };
+
+        const FetchConfig CONFIGS[] = {
+            {"bulk", APIScheduleRepository::FetchMode::BULK, 2},
+            {"per_endpoint_serial", APIScheduleRepository::FetchMode::PER_ENDPOINT, 1},
+            {"per_endpoint", APIScheduleRepository::FetchMode::PER_ENDPOINT, 2},
+            {"per_endpoint_3", APIScheduleRepository::FetchMode::PER_ENDPOINT, 3},
+        };
+    }
+
+    // 時計を止め、応答時間はmillis()の仮想の進みで測る（fetch_ms）
+    void runFetchLatency(const Options &options)
+    {
+        Report report("fetch_latency");
+        report.add("latency_ms", LATENCY_MILLIS);
+
+        for (const FetchConfig &config : CONFIGS)
+        {
+            RefreshSummary updated;
+            RefreshSummary notModified;
+
+            for (unsigned int session = 0; session < options.iterations; session++)
+            {
+                NativeHal::reset();
+                NativeHal::freezeClock(1000);
+                NativeHal::setEpoch(FIXTURE_FIRST_SLOT + 10 * 60);
+
+                TestSupport::FileNetworkService network("spla3");
+                network.setLatency(LATENCY_MILLIS);
+                network.setMaxInFlight(config.maxInFlight);
+                APIScheduleRepository repository(network);
+                repository.setFetchMode(config.mode);
+                Application::ScheduleService scheduleService(repository);
+                Infrastructure::TFTDisplayService display(21, 0);
+                Application::ScheduleApplicationService app(scheduleService, display, network);
+                display.initialize();
+
+                updated.add(measureRefresh(app));
+
+                NativeHal::advanceMillis(60 * 1000);
+                notModified.add(measureRefresh(app));
+            }
+
+            report.beginObject(config.name);
+            updated.write(report, "updated");
+            notModified.write(report, "not_modified");
+            report.endObject();
+        }
+
+        report.print();
+    }
+}
@@ -0,0 +1,222 @@
+// NameLookupBench.cpp
+// 日本語名からのStage/Ruleの検索を、名前を順に比較する方法と比べる
+
+#include "Bench.h"
+#include <string.h>
+#include <string>
+#include <vector>
+#include "domain/NameHash.h"
+#include "domain/Rule.h"
+#include "domain/Stage.h"
+
+// 要素数を変えたときの傾向を見るための合成カタログ（実際の名前と同じく共通の接頭辞を持つ）
+#define BENCH_NAMES_8(prefix) \
+    prefix "0", prefix "1", prefix "2", prefix "3", prefix "4", prefix "5", prefix "6", prefix "7"
+#define BENCH_NAMES_32(prefix) \
+    BENCH_NAMES_8(prefix "A"), BENCH_NAMES_8(prefix "B"), BENCH_NAMES_8(prefix "C"), BENCH_NAMES_8(prefix "D")
+#define BENCH_NAMES_128(prefix) \
+    BENCH_NAMES_32(prefix "1"), BENCH_NAMES_32(prefix "2"), BENCH_NAMES_32(prefix "3"), BENCH_NAMES_32(prefix "4")
+
+namespace Bench
+{
+    namespace
+    {
+        // 以前の実装と同じく、UNKNOWN以外の名前を順に比較する
+        Domain::Stage::Type findStageByComparison(const char *name)
+        {
+            for (int i = 0; i < static_cast<int>(Domain::Stage::Type::UNKNOWN); i++)
+            {
+                Domain::Stage::Type type = static_cast<Domain::Stage::Type>(i);
+                if (strcmp(name, Domain::Stage::fromType(type).getJapaneseName()) == 0)
+                {
+                    return type;
+                }
+            }
+            return Domain::Stage::Type::UNKNOWN;
+        }
+
+        Domain::Rule::Type findRuleByComparison(const char *name)
+        {
+            for (int i = 0; i < static_cast<int>(Domain::Rule::Type::UNKNOWN); i++)
+            {
+                Domain::Rule::Type type = static_cast<Domain::Rule::Type>(i);
+                if (strcmp(name, Domain::Rule::fromType(type).getJapaneseName()) == 0)
+                {
+                    return type;
+                }
+            }
+            return Domain::Rule::Type::UNKNOWN;
+        }
+
+        // 計測対象の結果を捨てられないよう足し込む
+        volatile unsigned long sink = 0;
+
+        constexpr const char *SYNTHETIC_NAMES_8[] = {BENCH_NAMES_8("バンカラ街")};
+        constexpr const char *SYNTHETIC_NAMES_32[] = {BENCH_NAMES_32("バンカラ街")};
+        constexpr const char *SYNTHETIC_NAMES_128[] = {BENCH_NAMES_128("バンカラ街")};
+
+        constexpr Domain::NameHashTable<8> SYNTHETIC_TABLE_8 = Domain::makeNameHashTable(SYNTHETIC_NAMES_8);
+        constexpr Domain::NameHashTable<32> SYNTHETIC_TABLE_32 = Domain::makeNameHashTable(SYNTHETIC_NAMES_32);
+        constexpr Domain::NameHashTable<128> SYNTHETIC_TABLE_128 = Domain::makeNameHashTable(SYNTHETIC_NAMES_128);
+        static_assert(Domain::findsEveryName(SYNTHETIC_TABLE_8, SYNTHETIC_NAMES_8), "Synthetic names collide");
+        static_assert(Domain::findsEveryName(SYNTHETIC_TABLE_32, SYNTHETIC_NAMES_32), "Synthetic names collide");
+        static_assert(Domain::findsEveryName(SYNTHETIC_TABLE_128, SYNTHETIC_NAMES_128), "Synthetic names collide");
+
+        // Stage/Ruleと同じ手順：表を1回引き、候補を1回だけ比較する
+        template <size_t N>
+        size_t findByHash(const Domain::NameHashTable<N> &table, const char *const (&names)[N], const char *name)
+        {
+            size_t index = table.find(Domain::hashName(name));
+            if (index == N || strcmp(name, names[index]) != 0)
+            {
+                return N;
+            }
+            return index;
+        }
+
+        template <size_t N>
+        size_t findByComparison(const char *const (&names)[N], const char *name)
+        {
+            for (size_t i = 0; i < N; i++)
+            {
+                if (strcmp(name, names[i]) == 0)
+                {
+                    return i;
+                }
+            }
+            return N;
+        }
+
+        // 全要素の名前と、カタログにない名前1つを検索する
+        // 要素数によらず検索の総数がほぼ同じになるよう、周回数を要素数で割る
+        template <size_t N>
+        void runSyntheticLookup(const Options &options, const Domain::NameHashTable<N> &table,
+                                const char *const (&names)[N], Report &report)
+        {
+            std::vector<std::string> queries(names, names + N);
+            queries.push_back("バンカラ街");
+
+            const unsigned long rounds = (unsigned long)options.iterations * 160000 / N;
+            const unsigned long lookups = rounds * queries.size();
+            unsigned long mismatches = 0;
+
+            Stopwatch hashWatch;
+            for (unsigned long round = 0; round < rounds; round++)
+            {
+                for (const std::string &query : queries)
+                {
+                    sink += findByHash(table, names, query.c_str());
+                }
+            }
+            double hashMicros = hashWatch.elapsedMicros();
+
+            Stopwatch compareWatch;
+            for (unsigned long round = 0; round < rounds; round++)
+            {
+                for (const std::string &query : queries)
+                {
+                    sink += findByComparison(names, query.c_str());
+                }
+            }
+            double compareMicros = compareWatch.elapsedMicros();
+
+            for (const std::string &query : queries)
+            {
+                if (findByHash(table, names, query.c_str()) != findByComparison(names, query.c_str()))
+                {
+                    mismatches++;
+                }
+            }
+
+            std::string key = "n" + std::to_string(N);
+            report.beginObject(key.c_str());
+            report.add("table_slots", (unsigned long)Domain::NameHashTable<N>::SIZE);
+            report.add("lookups", lookups);
+            report.add("hash_ns", hashMicros * 1000.0 / lookups);
+            report.add("compare_ns", compareMicros * 1000.0 / lookups);
+            report.add("mismatches", mismatches);
+            report.endObject();
+        }
+    }
+
+    // 全ステージ・全ルールの名前と、APIにない名前を混ぜて検索する
+    void runNameLookup(const Options &options)
+    {
+        std::vector<std::string> stageNames;
+        for (int i = 0; i < static_cast<int>(Domain::Stage::Type::UNKNOWN); i++)
+        {
+            stageNames.push_back(Domain::Stage::fromType(static_cast<Domain::Stage::Type>(i)).getJapaneseName());
+        }
+        stageNames.push_back("Bエリア");
+        stageNames.push_back("");
+
+        std::vector<std::string> ruleNames;
+        for (int i = 0; i < static_cast<int>(Domain::Rule::Type::UNKNOWN); i++)
+        {
+            ruleNames.push_back(Domain::Rule::fromType(static_cast<Domain::Rule::Type>(i)).getJapaneseName());
+        }
+        ruleNames.push_back("トリカラバトル");
+
+        const unsigned long rounds = (unsigned long)options.iterations * 5000;
+        const unsigned long lookups = rounds * (stageNames.size() + ruleNames.size());
+        unsigned long mismatches = 0;
+
+        Stopwatch hashWatch;
+        for (unsigned long round = 0; round < rounds; round++)
+        {
+            for (const std::string &name : stageNames)
+            {
+                sink += static_cast<unsigned long>(Domain::Stage::fromJapaneseName(name.c_str()).getType());
+            }
+            for (const std::string &name : ruleNames)
+            {
+                sink += static_cast<unsigned long>(Domain::Rule::fromJapaneseName(name.c_str()).getType());
+            }
+        }
+        double hashMicros = hashWatch.elapsedMicros();
+
+        Stopwatch compareWatch;
+        for (unsigned long round = 0; round < rounds; round++)
+        {
+            for (const std::string &name : stageNames)
+            {
+                sink += static_cast<unsigned long>(findStageByComparison(name.c_str()));
+            }
+            for (const std::string &name : ruleNames)
+            {
+                sink += static_cast<unsigned long>(findRuleByComparison(name.c_str()));
+            }
+        }
+        double compareMicros = compareWatch.elapsedMicros();
+
+        // 両方の方法が同じ結果を返すことも確かめる
+        for (const std::string &name : stageNames)
+        {
+            if (Domain::Stage::fromJapaneseName(name.c_str()).getType() != findStageByComparison(name.c_str()))
+            {
+                mismatches++;
+            }
+        }
+        for (const std::string &name : ruleNames)
+        {
+            if (Domain::Rule::fromJapaneseName(name.c_str()).getType() != findRuleByComparison(name.c_str()))
+            {
+                mismatches++;
+            }
+        }
+
+        Report report("name_lookup");
+        report.add("lookups", lookups);
+        report.add("hash_ns", hashMicros * 1000.0 / lookups);
+        report.add("compare_ns", compareMicros * 1000.0 / lookups);
+        report.add("mismatches", mismatches);
+
+        // 要素数を増やしても、ハッシュ表の検索時間は一定で、順に比較する方法だけが伸びる
+        report.beginObject("scaling");
+        runSyntheticLookup(options, SYNTHETIC_TABLE_8, SYNTHETIC_NAMES_8, report);
+        runSyntheticLookup(options, SYNTHETIC_TABLE_32, SYNTHETIC_NAMES_32, report);
+        runSyntheticLookup(options, SYNTHETIC_TABLE_128, SYNTHETIC_NAMES_128, report);
+        report.endObject();
+        report.print();
+    }
+}
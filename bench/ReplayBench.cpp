@@ -0,0 +1,57 @@
+// ReplayBench.cpp
+// 記録したレスポンスでデータ更新を再生し、段階ごとの時間・確保・描画量を測る
+
+#include "Bench.h"
+#include <stdlib.h>
+#include <NativeHal.h>
+#include "application/ScheduleService.h"
+#include "infrastructure/APIScheduleRepository.h"
+#include "infrastructure/TFTDisplayService.h"
+#include "support/FileNetworkService.h"
+
+namespace Bench
+{
+    using Application::ScheduleApplicationService;
+
+    // 1回のセッションは実機の2時間分の更新を再生する
+    // 起動直後の取得、1分後の変化なし（304）、次のスロットでの取得、その1分後の変化なし
+    void runReplay(const Options &options)
+    {
+        RefreshSummary updated;
+        RefreshSummary notModified;
+        RefreshSummary first;
+
+        for (unsigned int session = 0; session < options.iterations; session++)
+        {
+            NativeHal::reset();
+            NativeHal::setEpoch(FIXTURE_FIRST_SLOT + 10 * 60);
+
+            TestSupport::FileNetworkService network("spla3");
+            Infrastructure::APIScheduleRepository repository(network);
+            Application::ScheduleService scheduleService(repository);
+            Infrastructure::TFTDisplayService display(21, 0);
+            ScheduleApplicationService app(scheduleService, display, network);
+            display.initialize();
+
+            // 最初の取得はスプライトの作成などを含むため分けて集計する
+            first.add(measureRefresh(app));
+
+            NativeHal::advanceMillis(60 * 1000);
+            notModified.add(measureRefresh(app));
+
+            NativeHal::advanceMillis(SLOT_SECONDS * 1000);
+            network.setScenario("spla3_next");
+            updated.add(measureRefresh(app));
+
+            NativeHal::advanceMillis(60 * 1000);
+            notModified.add(measureRefresh(app));
+        }
+
+        Report report("replay");
+        report.add("sessions", (unsigned long)options.iterations);
+        first.write(report, "first");
+        updated.write(report, "updated");
+        notModified.write(report, "not_modified");
+        report.print();
+    }
+}
@@ -0,0 +1,73 @@
+// main.cpp
+// ホストで動かすベンチマークの入口（pio run -e bench -t exec）
+// 引数でベンチマーク名と繰り返し回数（--iterations N）を指定できる。名前を省略すると全て実行する
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <Arduino.h>
+#include "Bench.h"
+#include "infrastructure/MemoryManager.h"
+
+namespace
+{
+    struct BenchEntry
+    {
+        const char *name;
+        void (*run)(const Bench::Options &options);
+    };
+
+    const BenchEntry BENCHES[] = {
+        {"replay", Bench::runReplay},
+        {"name_lookup", Bench::runNameLookup},
+        {"fetch_latency", Bench::runFetchLatency},
+    };
+
+    bool isSelected(const char *name, int argc, char **argv)
+    {
+        bool anyName = false;
+        for (int i = 1; i < argc; i++)
+        {
+            if (strcmp(argv[i], "--iterations") == 0)
+            {
+                i++;
+                continue;
+            }
+            anyName = true;
+            if (strcmp(argv[i], name) == 0)
+            {
+                return true;
+            }
+        }
+        return !anyName;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Bench::Options options;
+    for (int i = 1; i + 1 < argc; i++)
+    {
+        if (strcmp(argv[i], "--iterations") == 0)
+        {
+            options.iterations = (unsigned int)strtoul(argv[i + 1], nullptr, 10);
+        }
+    }
+
+    // 記録したレスポンスの時刻は日本時間で表示する
+    setenv("TZ", "JST-9", 1);
+    tzset();
+
+    // アプリのシリアル出力は捨て、結果の行だけを標準出力に出す
+    Serial.setEcho(false);
+    Infrastructure::MemoryManager::begin();
+
+    for (const BenchEntry &entry : BENCHES)
+    {
+        if (isSelected(entry.name, argc, argv))
+        {
+            entry.run(options);
+        }
+    }
+    return 0;
+}
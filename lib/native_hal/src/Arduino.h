@@ -0,0 +1,59 @@
+// Arduino.h
+// ホスト（ネイティブ環境）でアプリケーション層とドメイン層を動かすためのArduino-ESP32の代替
+
+#ifndef NATIVE_HAL_ARDUINO_H
+#define NATIVE_HAL_ARDUINO_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <algorithm>
+
+#include "WString.h"
+#include "Print.h"
+#include "Stream.h"
+#include "Client.h"
+#include "HardwareSerial.h"
+#include "Esp.h"
+#include "NativeHal.h"
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define PROGMEM
+#define PSTR(text) (text)
+#define F(text) (text)
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x01
+#define OUTPUT 0x03
+
+using std::max;
+using std::min;
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+
+// バックライトのPWM（値は記録するだけ）
+uint32_t ledcSetup(uint8_t channel, uint32_t frequency, uint8_t resolutionBits);
+void ledcAttachPin(uint8_t pin, uint8_t channel);
+void ledcWrite(uint8_t channel, uint32_t duty);
+uint32_t ledcRead(uint8_t channel);
+
+uint32_t getCpuFrequencyMhz();
+void randomSeed(unsigned long seed);
+long random(long maxValue);
+long random(long minValue, long maxValue);
+uint32_t esp_random();
+
+#endif // NATIVE_HAL_ARDUINO_H
@@ -0,0 +1,40 @@
+// Esp.h
+// ホスト用のESPクラス（ヒープはESP32相当の大きさとしてプロセスの使用量から求める）
+
+#ifndef NATIVE_HAL_ESP_H
+#define NATIVE_HAL_ESP_H
+
+#include <stdint.h>
+
+class EspClass
+{
+public:
+    // ESP32の内部RAMのうちアプリが使えるおおよその大きさ
+    static constexpr uint32_t HEAP_SIZE = 320 * 1024;
+
+    uint32_t getHeapSize() { return HEAP_SIZE; }
+    uint32_t getFreeHeap();
+    uint32_t getMinFreeHeap();
+    uint32_t getMaxAllocHeap() { return getFreeHeap(); }
+
+    uint32_t getFlashChipSize() { return 4 * 1024 * 1024; }
+    uint32_t getFlashChipSpeed() { return 40000000; }
+    const char *getChipModel() { return "ESP32-D0WDQ6"; }
+    uint8_t getChipRevision() { return 3; }
+
+    void restart();
+
+    // ホストのみ：空きヒープの最小値を現在の値からやり直す（ベンチマークで区間ごとの最大使用量を測る）
+    void resetMinFreeHeap()
+    {
+        minFreeHeap = HEAP_SIZE;
+        getFreeHeap();
+    }
+
+private:
+    uint32_t minFreeHeap = HEAP_SIZE;
+};
+
+extern EspClass ESP;
+
+#endif // NATIVE_HAL_ESP_H
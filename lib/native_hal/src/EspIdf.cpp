@@ -0,0 +1,142 @@
+// EspIdf.cpp
+// ホスト用のESP-IDF API（heap_caps、ROM CRC、チップ情報、FreeRTOSのタスクなど）の実装
+
+#include "Arduino.h"
+#include "esp_chip_info.h"
+#include "esp_flash.h"
+#include "esp_heap_caps.h"
+#include "esp_rom_crc.h"
+#include "esp_system.h"
+#include "freertos/task.h"
+#include <new>
+#include <stdlib.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+namespace
+{
+    esp_alloc_failed_hook_t failedAllocCallback = nullptr;
+}
+
+esp_flash_t *esp_flash_default_chip = nullptr;
+
+esp_err_t heap_caps_register_failed_alloc_callback(esp_alloc_failed_hook_t callback)
+{
+    failedAllocCallback = callback;
+    return ESP_OK;
+}
+
+void heap_caps_notify_failed_alloc(size_t size, uint32_t caps, const char *function_name)
+{
+    if (failedAllocCallback != nullptr)
+    {
+        failedAllocCallback(size, caps, function_name);
+    }
+}
+
+size_t heap_caps_get_allocated_size(void *ptr)
+{
+#ifdef __GLIBC__
+    return ptr != nullptr ? malloc_usable_size(ptr) : 0;
+#else
+    (void)ptr;
+    return 0;
+#endif
+}
+
+size_t heap_caps_get_free_size(uint32_t caps)
+{
+    (void)caps;
+    return ESP.getFreeHeap();
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t caps)
+{
+    (void)caps;
+    return ESP.getMaxAllocHeap();
+}
+
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len)
+{
+    // 反射多項式0xEDB88320（zlibのcrc32と同じ結果になる）
+    crc = ~crc;
+    for (uint32_t i = 0; i < len; i++)
+    {
+        crc ^= buf[i];
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+void esp_chip_info(esp_chip_info_t *out_info)
+{
+    out_info->model = CHIP_ESP32;
+    out_info->features = CHIP_FEATURE_WIFI_BGN | CHIP_FEATURE_BLE | CHIP_FEATURE_BT;
+    out_info->revision = 3;
+    out_info->cores = 2;
+}
+
+int esp_flash_get_size(esp_flash_t *chip, uint32_t *out_size)
+{
+    (void)chip;
+    *out_size = ESP.getFlashChipSize();
+    return ESP_OK;
+}
+
+esp_reset_reason_t esp_reset_reason(void)
+{
+    return ESP_RST_POWERON;
+}
+
+uint32_t esp_get_free_heap_size(void)
+{
+    return ESP.getFreeHeap();
+}
+
+uint32_t esp_get_minimum_free_heap_size(void)
+{
+    return ESP.getMinFreeHeap();
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle()
+{
+    // スレッドごとの変数のアドレスをハンドルとして使う
+    static thread_local char taskMarker;
+    return &taskMarker;
+}
+
+#ifdef NATIVE_HAL_WRAP_NEW
+// ホストではlibstdc++が共有ライブラリのため、operator newはmallocの--wrapを通らない
+// --wrap=_Znwmなどでoperator new/deleteをmalloc/freeに回し、実機と同じく確保として数えられるようにする
+extern "C"
+{
+    void *__wrap__Znwm(size_t size)
+    {
+        void *ptr = malloc(size > 0 ? size : 1);
+        if (ptr == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return ptr;
+    }
+
+    void *__wrap__Znam(size_t size)
+    {
+        return __wrap__Znwm(size);
+    }
+
+    void __wrap__ZdlPv(void *ptr)
+    {
+        free(ptr);
+    }
+
+    void __wrap__ZdaPv(void *ptr)
+    {
+        free(ptr);
+    }
+}
+#endif
@@ -0,0 +1,42 @@
+// HardwareSerial.h
+// ホスト用のシリアルポート（出力を記録し、必要なら標準出力に流す）
+
+#ifndef NATIVE_HAL_HARDWARE_SERIAL_H
+#define NATIVE_HAL_HARDWARE_SERIAL_H
+
+#include <string>
+#include "Stream.h"
+
+class HardwareSerial : public Stream
+{
+public:
+    void begin(unsigned long baud) { (void)baud; }
+    void end() {}
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+
+    // 入力はinjectInputで与えたものを返す
+    int available() override { return (int)(input.length() - inputPosition); }
+    int read() override { return inputPosition < input.length() ? (unsigned char)input[inputPosition++] : -1; }
+    int peek() override { return inputPosition < input.length() ? (unsigned char)input[inputPosition] : -1; }
+
+    operator bool() const { return true; }
+
+    // テストから使う（echoがtrueの場合は出力を標準出力にも書く）
+    void setEcho(bool enabled) { echo = enabled; }
+    const std::string &getOutput() const { return output; }
+    void clearOutput() { output.clear(); }
+    void injectInput(const char *text);
+
+private:
+    std::string output;
+    std::string input;
+    size_t inputPosition = 0;
+    bool echo = false;
+};
+
+extern HardwareSerial Serial;
+
+#endif // NATIVE_HAL_HARDWARE_SERIAL_H
@@ -0,0 +1,338 @@
+// NativeHal.cpp
+// ホスト用HALの時計、シリアル、ESPクラスなどの実装
+
+#include "Arduino.h"
+#include "esp_timer.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <chrono>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+HardwareSerial Serial;
+EspClass ESP;
+
+namespace
+{
+    // 時計の状態（止めている間はfrozenMicrosとvirtualMicrosだけで決まる）
+    bool clockFrozen = false;
+    uint64_t frozenMicros = 0;
+    uint64_t virtualMicros = 0;
+
+    time_t epochBase = 0;
+    uint64_t epochBaseMicros = 0;
+
+    uint32_t ledcDuty[16] = {};
+    uint32_t randomState = 1;
+
+    // ホストの起動からの経過時間
+    uint64_t hostMicros()
+    {
+        static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now() - start)
+            .count();
+    }
+
+    uint64_t nowMicros()
+    {
+        return (clockFrozen ? frozenMicros : hostMicros()) + virtualMicros;
+    }
+
+#ifdef __GLIBC__
+    // 起動時点で使われていた分はESP32のヒープには含めない
+    size_t hostHeapInUse()
+    {
+#if __GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33)
+        return mallinfo2().uordblks;
+#else
+        return (size_t)mallinfo().uordblks;
+#endif
+    }
+    const size_t heapBaseline = hostHeapInUse();
+#endif
+
+    // シリアル出力は長時間のベンチマークでも膨らみすぎないよう後半だけを残す
+    constexpr size_t SERIAL_OUTPUT_LIMIT = 1024 * 1024;
+}
+
+// 他のホスト用実装（Preferences、TFT_eSPI）の状態を戻す
+void resetPreferencesStorage();
+void resetTftRecorder();
+
+namespace NativeHal
+{
+    void freezeClock(unsigned long millis)
+    {
+        clockFrozen = true;
+        frozenMicros = (uint64_t)millis * 1000;
+        virtualMicros = 0;
+    }
+
+    void unfreezeClock()
+    {
+        clockFrozen = false;
+        virtualMicros = 0;
+    }
+
+    void advanceMillis(unsigned long millis)
+    {
+        virtualMicros += (uint64_t)millis * 1000;
+    }
+
+    void setEpoch(time_t epoch)
+    {
+        epochBase = epoch;
+        epochBaseMicros = nowMicros();
+    }
+
+    void reset()
+    {
+        unfreezeClock();
+        setEpoch(0);
+        Serial.clearOutput();
+        for (uint32_t &duty : ledcDuty)
+        {
+            duty = 0;
+        }
+        randomState = 1;
+        resetPreferencesStorage();
+        resetTftRecorder();
+        ESP.resetMinFreeHeap();
+    }
+}
+
+// ESP32ではmillis()は32ビットで約49日ごとに一周する
+unsigned long millis()
+{
+    return (unsigned long)(uint32_t)(nowMicros() / 1000);
+}
+
+unsigned long micros()
+{
+    return (unsigned long)(uint32_t)nowMicros();
+}
+
+int64_t esp_timer_get_time(void)
+{
+    return (int64_t)nowMicros();
+}
+
+void delay(uint32_t ms)
+{
+    virtualMicros += (uint64_t)ms * 1000;
+}
+
+void delayMicroseconds(uint32_t us)
+{
+    virtualMicros += us;
+}
+
+void yield()
+{
+}
+
+// time()を差し替え、setEpochで固定した時刻を返す
+extern "C" time_t time(time_t *result) noexcept
+{
+    time_t now;
+    if (epochBase != 0)
+    {
+        now = epochBase + (time_t)((nowMicros() - epochBaseMicros) / 1000000);
+    }
+    else
+    {
+        now = (time_t)std::chrono::duration_cast<std::chrono::seconds>(
+                  std::chrono::system_clock::now().time_since_epoch())
+                  .count();
+    }
+
+    if (result != nullptr)
+    {
+        *result = now;
+    }
+    return now;
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    (void)pin;
+    (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+    (void)pin;
+    (void)value;
+}
+
+int digitalRead(uint8_t pin)
+{
+    (void)pin;
+    return LOW;
+}
+
+uint32_t ledcSetup(uint8_t channel, uint32_t frequency, uint8_t resolutionBits)
+{
+    (void)channel;
+    (void)resolutionBits;
+    return frequency;
+}
+
+void ledcAttachPin(uint8_t pin, uint8_t channel)
+{
+    (void)pin;
+    (void)channel;
+}
+
+void ledcWrite(uint8_t channel, uint32_t duty)
+{
+    ledcDuty[channel % 16] = duty;
+}
+
+uint32_t ledcRead(uint8_t channel)
+{
+    return ledcDuty[channel % 16];
+}
+
+uint32_t getCpuFrequencyMhz()
+{
+    return 240;
+}
+
+void randomSeed(unsigned long seed)
+{
+    randomState = seed != 0 ? (uint32_t)seed : 1;
+}
+
+uint32_t esp_random()
+{
+    // xorshift32（テストで再現できるようrandomSeedで決まる系列にする）
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+long random(long maxValue)
+{
+    return maxValue > 0 ? (long)(esp_random() % (uint32_t)maxValue) : 0;
+}
+
+long random(long minValue, long maxValue)
+{
+    return minValue < maxValue ? minValue + random(maxValue - minValue) : minValue;
+}
+
+size_t Print::write(const uint8_t *buffer, size_t size)
+{
+    size_t written = 0;
+    while (written < size && write(buffer[written]) == 1)
+    {
+        written++;
+    }
+    return written;
+}
+
+size_t Print::printf(const char *format, ...)
+{
+    char buffer[256];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+
+    if (length < 0)
+    {
+        return 0;
+    }
+    return write(buffer, (size_t)length < sizeof(buffer) ? (size_t)length : sizeof(buffer) - 1);
+}
+
+int Stream::timedRead()
+{
+    unsigned long start = millis();
+    do
+    {
+        int c = read();
+        if (c >= 0)
+        {
+            return c;
+        }
+        delay(1);
+    } while (millis() - start < timeout);
+    return -1;
+}
+
+size_t Stream::readBytes(char *buffer, size_t length)
+{
+    size_t count = 0;
+    while (count < length)
+    {
+        int c = timedRead();
+        if (c < 0)
+        {
+            break;
+        }
+        buffer[count++] = (char)c;
+    }
+    return count;
+}
+
+size_t HardwareSerial::write(uint8_t c)
+{
+    return write(&c, 1);
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size)
+{
+    if (output.length() + size > SERIAL_OUTPUT_LIMIT)
+    {
+        output.erase(0, output.length() / 2);
+    }
+    output.append((const char *)buffer, size);
+
+    if (echo)
+    {
+        fwrite(buffer, 1, size, stdout);
+    }
+    return size;
+}
+
+void HardwareSerial::injectInput(const char *text)
+{
+    input.erase(0, inputPosition);
+    inputPosition = 0;
+    input += text;
+}
+
+uint32_t EspClass::getFreeHeap()
+{
+#ifdef __GLIBC__
+    size_t inUse = hostHeapInUse();
+    size_t used = inUse > heapBaseline ? inUse - heapBaseline : 0;
+    uint32_t freeHeap = used < HEAP_SIZE ? HEAP_SIZE - (uint32_t)used : 0;
+#else
+    uint32_t freeHeap = HEAP_SIZE;
+#endif
+
+    if (freeHeap < minFreeHeap)
+    {
+        minFreeHeap = freeHeap;
+    }
+    return freeHeap;
+}
+
+uint32_t EspClass::getMinFreeHeap()
+{
+    getFreeHeap();
+    return minFreeHeap;
+}
+
+void EspClass::restart()
+{
+    // ホストでは再起動できないため、呼ばれたこと自体を失敗として扱う
+    fprintf(stderr, "ESP.restart() called\n");
+    abort();
+}
@@ -0,0 +1,27 @@
+// NativeHal.h
+// ホスト用HALの時計と状態をテストやベンチマークから操作する
+
+#ifndef NATIVE_HAL_H
+#define NATIVE_HAL_H
+
+#include <stdint.h>
+#include <time.h>
+
+namespace NativeHal
+{
+    // millis()/micros()はホストの経過時間に仮想の進みを足したもの
+    // delay()は待たずに仮想の進みを加える
+    // 時計を止めると、delay()とadvanceMillis()でしか進まなくなる
+    void freezeClock(unsigned long millis);
+    void unfreezeClock();
+    void advanceMillis(unsigned long millis);
+
+    // time()が返すUNIX時間を固定する（以降はmillis()の進みに合わせて進む）
+    // 0を渡すとホストの時刻に戻る
+    void setEpoch(time_t epoch);
+
+    // 全ての状態（時計、シリアル、Preferences、画面の記録）を初期状態に戻す
+    void reset();
+}
+
+#endif // NATIVE_HAL_H
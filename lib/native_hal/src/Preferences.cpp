@@ -0,0 +1,129 @@
+// Preferences.cpp
+// ホスト用のPreferencesの実装
+
+#include "Preferences.h"
+#include <string.h>
+#include <map>
+
+namespace
+{
+    using Namespace = std::map<std::string, std::string>;
+
+    std::map<std::string, Namespace> &storage()
+    {
+        static std::map<std::string, Namespace> namespaces;
+        return namespaces;
+    }
+
+    unsigned long writeCount = 0;
+}
+
+void resetPreferencesStorage()
+{
+    storage().clear();
+    writeCount = 0;
+}
+
+bool Preferences::begin(const char *namespaceName, bool readOnlyMode, const char *partitionLabel)
+{
+    (void)partitionLabel;
+
+    if (opened || namespaceName == nullptr || strlen(namespaceName) > 15)
+    {
+        return false;
+    }
+    if (readOnlyMode && storage().find(namespaceName) == storage().end())
+    {
+        return false;
+    }
+
+    name = namespaceName;
+    opened = true;
+    readOnly = readOnlyMode;
+    return true;
+}
+
+void Preferences::end()
+{
+    opened = false;
+}
+
+bool Preferences::clear()
+{
+    if (!opened || readOnly)
+    {
+        return false;
+    }
+    storage()[name].clear();
+    writeCount++;
+    return true;
+}
+
+bool Preferences::remove(const char *key)
+{
+    if (!opened || readOnly)
+    {
+        return false;
+    }
+    writeCount++;
+    return storage()[name].erase(key) > 0;
+}
+
+bool Preferences::isKey(const char *key)
+{
+    return getBytesLength(key) > 0;
+}
+
+size_t Preferences::putBytes(const char *key, const void *value, size_t length)
+{
+    if (!opened || readOnly || key == nullptr || value == nullptr)
+    {
+        return 0;
+    }
+    storage()[name][key] = std::string((const char *)value, length);
+    writeCount++;
+    return length;
+}
+
+size_t Preferences::getBytes(const char *key, void *buffer, size_t maxLength)
+{
+    size_t length = getBytesLength(key);
+    if (length == 0 || length > maxLength)
+    {
+        return 0;
+    }
+    memcpy(buffer, storage()[name][key].data(), length);
+    return length;
+}
+
+size_t Preferences::getBytesLength(const char *key)
+{
+    if (!opened || key == nullptr)
+    {
+        return 0;
+    }
+
+    Namespace &entries = storage()[name];
+    Namespace::const_iterator entry = entries.find(key);
+    return entry != entries.end() ? entry->second.length() : 0;
+}
+
+size_t Preferences::putString(const char *key, const char *value)
+{
+    return value != nullptr ? putBytes(key, value, strlen(value) + 1) : 0;
+}
+
+String Preferences::getString(const char *key, const String &defaultValue)
+{
+    size_t length = getBytesLength(key);
+    if (length == 0)
+    {
+        return defaultValue;
+    }
+    return String(storage()[name][key].c_str());
+}
+
+unsigned long Preferences::getWriteCount()
+{
+    return writeCount;
+}
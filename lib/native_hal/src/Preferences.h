@@ -0,0 +1,57 @@
+// Preferences.h
+// ホスト用のPreferences（NVSの代わりにプロセス内のメモリに保存する）
+// インスタンスを作り直しても内容は残るため、再起動をまたぐ保存と復元を確かめられる
+
+#ifndef NATIVE_HAL_PREFERENCES_H
+#define NATIVE_HAL_PREFERENCES_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include "WString.h"
+
+class Preferences
+{
+public:
+    // 読み取り専用で開く場合、ネームスペースが一度も書かれていなければ失敗する（NVSと同じ）
+    bool begin(const char *name, bool readOnly = false, const char *partitionLabel = nullptr);
+    void end();
+
+    bool clear();
+    bool remove(const char *key);
+    bool isKey(const char *key);
+
+    size_t putBytes(const char *key, const void *value, size_t length);
+    size_t getBytes(const char *key, void *buffer, size_t maxLength);
+    size_t getBytesLength(const char *key);
+
+    size_t putString(const char *key, const char *value);
+    size_t putString(const char *key, const String &value) { return putString(key, value.c_str()); }
+    String getString(const char *key, const String &defaultValue = String());
+
+    size_t putBool(const char *key, bool value) { return putBytes(key, &value, sizeof(value)); }
+    bool getBool(const char *key, bool defaultValue = false) { return getValue(key, defaultValue); }
+    size_t putUChar(const char *key, uint8_t value) { return putBytes(key, &value, sizeof(value)); }
+    uint8_t getUChar(const char *key, uint8_t defaultValue = 0) { return getValue(key, defaultValue); }
+    size_t putInt(const char *key, int32_t value) { return putBytes(key, &value, sizeof(value)); }
+    int32_t getInt(const char *key, int32_t defaultValue = 0) { return getValue(key, defaultValue); }
+    size_t putUInt(const char *key, uint32_t value) { return putBytes(key, &value, sizeof(value)); }
+    uint32_t getUInt(const char *key, uint32_t defaultValue = 0) { return getValue(key, defaultValue); }
+
+    // 書き込み回数（フラッシュの摩耗を確かめるテスト用、全ネームスペースの合計）
+    static unsigned long getWriteCount();
+
+private:
+    std::string name;
+    bool opened = false;
+    bool readOnly = false;
+
+    template <typename T>
+    T getValue(const char *key, T defaultValue)
+    {
+        T value;
+        return getBytesLength(key) == sizeof(T) && getBytes(key, &value, sizeof(T)) == sizeof(T) ? value : defaultValue;
+    }
+};
+
+#endif // NATIVE_HAL_PREFERENCES_H
@@ -0,0 +1,58 @@
+// Print.h
+// ホスト用のArduino Print（文字列化して派生クラスのwriteに渡す）
+
+#ifndef NATIVE_HAL_PRINT_H
+#define NATIVE_HAL_PRINT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "WString.h"
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+class Print
+{
+public:
+    virtual ~Print() = default;
+
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    virtual void flush() {}
+
+    size_t write(const char *text) { return text != nullptr ? write((const uint8_t *)text, strlen(text)) : 0; }
+    size_t write(const char *buffer, size_t size) { return write((const uint8_t *)buffer, size); }
+
+    size_t print(const char *text) { return write(text); }
+    size_t print(const String &text) { return write(text.c_str(), text.length()); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned char number, int base = DEC) { return print(String(number, (unsigned char)base)); }
+    size_t print(int number, int base = DEC) { return print(String(number, (unsigned char)base)); }
+    size_t print(unsigned int number, int base = DEC) { return print(String(number, (unsigned char)base)); }
+    size_t print(long number, int base = DEC) { return print(String(number, (unsigned char)base)); }
+    size_t print(unsigned long number, int base = DEC) { return print(String(number, (unsigned char)base)); }
+    size_t print(long long number, int base = DEC) { return print(String(number, (unsigned char)base)); }
+    size_t print(unsigned long long number, int base = DEC) { return print(String(number, (unsigned char)base)); }
+    size_t print(double number, int decimalPlaces = 2) { return print(String(number, (unsigned int)decimalPlaces)); }
+
+    // Arduinoと同じく型ごとの多重定義にする（テンプレートにすると定数の参照でODR使用になる）
+    size_t println() { return write("\r\n"); }
+    size_t println(const char *text) { return print(text) + println(); }
+    size_t println(const String &text) { return print(text) + println(); }
+    size_t println(char c) { return print(c) + println(); }
+    size_t println(unsigned char number, int base = DEC) { return print(number, base) + println(); }
+    size_t println(int number, int base = DEC) { return print(number, base) + println(); }
+    size_t println(unsigned int number, int base = DEC) { return print(number, base) + println(); }
+    size_t println(long number, int base = DEC) { return print(number, base) + println(); }
+    size_t println(unsigned long number, int base = DEC) { return print(number, base) + println(); }
+    size_t println(long long number, int base = DEC) { return print(number, base) + println(); }
+    size_t println(unsigned long long number, int base = DEC) { return print(number, base) + println(); }
+    size_t println(double number, int decimalPlaces = 2) { return print(number, decimalPlaces) + println(); }
+
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+#endif // NATIVE_HAL_PRINT_H
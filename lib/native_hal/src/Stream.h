@@ -0,0 +1,29 @@
+// Stream.h
+// ホスト用のArduino Stream（タイムアウト付きのreadBytesを備える）
+
+#ifndef NATIVE_HAL_STREAM_H
+#define NATIVE_HAL_STREAM_H
+
+#include "Print.h"
+
+class Stream : public Print
+{
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    // 1バイトずつread()し、timeoutの間データが来なければ打ち切る
+    virtual size_t readBytes(char *buffer, size_t length);
+    size_t readBytes(uint8_t *buffer, size_t length) { return readBytes((char *)buffer, length); }
+
+    void setTimeout(unsigned long timeoutMillis) { timeout = timeoutMillis; }
+    unsigned long getTimeout() const { return timeout; }
+
+protected:
+    unsigned long timeout = 1000;
+
+    int timedRead();
+};
+
+#endif // NATIVE_HAL_STREAM_H
@@ -0,0 +1,337 @@
+// TFT_eSPI.cpp
+// ホスト用のTFT_eSPIの実装
+
+#include "TFT_eSPI.h"
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+namespace
+{
+    // GLCDフォントの1文字のセル
+    constexpr int GLYPH_WIDTH = 6;
+    constexpr int GLYPH_HEIGHT = 8;
+
+    int spriteCreateLimit = -1;
+    int spritesCreated = 0;
+
+    // 領域を確保したスプライト（パネルに送った画像がどのスプライトのものかを調べる）
+    std::vector<TFT_eSprite *> &liveSprites()
+    {
+        static std::vector<TFT_eSprite *> sprites;
+        return sprites;
+    }
+
+    unsigned long area(int32_t w, int32_t h)
+    {
+        return w > 0 && h > 0 ? (unsigned long)w * (unsigned long)h : 0;
+    }
+}
+
+void resetTftRecorder()
+{
+    TFT_eSPI::resetPanelStats();
+    spriteCreateLimit = -1;
+    spritesCreated = 0;
+}
+
+TftPanelStats &TFT_eSPI::panelStats()
+{
+    static TftPanelStats stats = {};
+    return stats;
+}
+
+void TFT_eSPI::resetPanelStats()
+{
+    panelStats() = TftPanelStats();
+}
+
+TFT_eSPI::TFT_eSPI(int16_t width, int16_t height)
+    : baseWidth(width), baseHeight(height), currentWidth(width), currentHeight(height),
+      rotation(0), cursorX(0), cursorY(0), textColor(TFT_WHITE), textSize(1)
+{
+}
+
+void TFT_eSPI::init(uint8_t tabColor)
+{
+    (void)tabColor;
+    setRotation(0);
+}
+
+void TFT_eSPI::setRotation(uint8_t value)
+{
+    rotation = value % 4;
+    bool landscape = rotation % 2 == 1;
+    currentWidth = landscape ? baseHeight : baseWidth;
+    currentHeight = landscape ? baseWidth : baseHeight;
+}
+
+void TFT_eSPI::invertDisplay(bool invert)
+{
+    (void)invert;
+    if (isPanel())
+    {
+        panelStats().inversions++;
+    }
+}
+
+bool TFT_eSPI::initDMA(bool ctrlCs)
+{
+    (void)ctrlCs;
+    return true;
+}
+
+void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t *data, uint16_t *buffer)
+{
+    (void)x;
+    (void)y;
+    (void)buffer;
+    record(area(w, h));
+    if (isPanel())
+    {
+        panelStats().dmaTransfers++;
+        recordSpriteText(data);
+    }
+}
+
+void TFT_eSPI::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t *data)
+{
+    (void)x;
+    (void)y;
+    record(area(w, h));
+    if (isPanel())
+    {
+        recordSpriteText(data);
+    }
+}
+
+void TFT_eSPI::fillScreen(uint32_t color)
+{
+    fillRect(0, 0, currentWidth, currentHeight, color);
+}
+
+void TFT_eSPI::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color)
+{
+    (void)x;
+    (void)y;
+    (void)color;
+    record(area(w, h));
+}
+
+void TFT_eSPI::drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color)
+{
+    (void)x;
+    (void)y;
+    (void)color;
+    record(w > 0 && h > 0 ? 2UL * (unsigned long)(w + h) : 0);
+}
+
+void TFT_eSPI::drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color)
+{
+    fillRect(x, y, w, 1, color);
+}
+
+void TFT_eSPI::drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color)
+{
+    fillRect(x, y, 1, h, color);
+}
+
+void TFT_eSPI::drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color)
+{
+    (void)color;
+    int32_t dx = abs(x1 - x0);
+    int32_t dy = abs(y1 - y0);
+    record((unsigned long)(dx > dy ? dx : dy) + 1);
+}
+
+void TFT_eSPI::drawPixel(int32_t x, int32_t y, uint32_t color)
+{
+    (void)x;
+    (void)y;
+    (void)color;
+    record(1);
+}
+
+void TFT_eSPI::fillCircle(int32_t x, int32_t y, int32_t r, uint32_t color)
+{
+    (void)x;
+    (void)y;
+    (void)color;
+    record(area(2 * r + 1, 2 * r + 1));
+}
+
+void TFT_eSPI::drawCircle(int32_t x, int32_t y, int32_t r, uint32_t color)
+{
+    (void)x;
+    (void)y;
+    (void)color;
+    record(r > 0 ? (unsigned long)(8 * r) : 1);
+}
+
+int16_t TFT_eSPI::drawChar(uint16_t c, int32_t x, int32_t y, uint8_t font)
+{
+    (void)font;
+    drawChar(x, y, c, textColor, TFT_BLACK, textSize);
+    return (int16_t)(GLYPH_WIDTH * textSize);
+}
+
+void TFT_eSPI::drawChar(int32_t x, int32_t y, uint16_t c, uint32_t color, uint32_t background, uint8_t size)
+{
+    (void)x;
+    (void)y;
+    (void)color;
+    (void)background;
+    record(area(GLYPH_WIDTH * size, GLYPH_HEIGHT * size));
+    if (isPanel())
+    {
+        panelStats().glyphs++;
+    }
+    recordText((char)c);
+}
+
+int16_t TFT_eSPI::textWidth(const char *text, uint8_t font)
+{
+    (void)font;
+    return text != nullptr ? (int16_t)(strlen(text) * GLYPH_WIDTH * textSize) : 0;
+}
+
+size_t TFT_eSPI::write(uint8_t c)
+{
+    if (c == '\n')
+    {
+        cursorX = 0;
+        cursorY += GLYPH_HEIGHT * textSize;
+        recordText('\n');
+        return 1;
+    }
+    if (c == '\r')
+    {
+        return 1;
+    }
+
+    drawChar(cursorX, cursorY, c, textColor, TFT_BLACK, textSize);
+    cursorX += GLYPH_WIDTH * textSize;
+    return 1;
+}
+
+void TFT_eSPI::record(unsigned long pixels)
+{
+    if (!isPanel())
+    {
+        return;
+    }
+
+    TftPanelStats &stats = panelStats();
+    stats.drawCalls++;
+    stats.pixels += pixels;
+}
+
+void TFT_eSPI::recordText(char c)
+{
+    if (isPanel())
+    {
+        panelStats().text += c;
+    }
+    else
+    {
+        spriteText += c;
+    }
+}
+
+void TFT_eSPI::recordSpriteText(const uint16_t *data)
+{
+    for (TFT_eSprite *sprite : liveSprites())
+    {
+        if (sprite->getPointer() == data)
+        {
+            panelStats().text += sprite->spriteText;
+            return;
+        }
+    }
+}
+
+TFT_eSprite::TFT_eSprite(TFT_eSPI *parent)
+    : TFT_eSPI(0, 0), parent(parent), buffer(nullptr), colorDepth(16)
+{
+}
+
+TFT_eSprite::~TFT_eSprite()
+{
+    deleteSprite();
+}
+
+void *TFT_eSprite::setColorDepth(int8_t depth)
+{
+    colorDepth = depth;
+    return buffer;
+}
+
+void *TFT_eSprite::createSprite(int16_t width, int16_t height, uint8_t frames)
+{
+    (void)frames;
+    if (buffer != nullptr)
+    {
+        return buffer;
+    }
+    if (spriteCreateLimit >= 0 && spritesCreated >= spriteCreateLimit)
+    {
+        return nullptr;
+    }
+
+    // 実機と同じ大きさの領域を確保し、ヒープの計測に反映させる
+    size_t bytes = (size_t)width * (size_t)height * (size_t)(colorDepth > 8 ? 2 : 1);
+    buffer = (uint16_t *)calloc(bytes > 0 ? bytes : 1, 1);
+    if (buffer == nullptr)
+    {
+        return nullptr;
+    }
+
+    spritesCreated++;
+    liveSprites().push_back(this);
+    baseWidth = width;
+    baseHeight = height;
+    currentWidth = width;
+    currentHeight = height;
+    return buffer;
+}
+
+void TFT_eSprite::deleteSprite()
+{
+    if (buffer == nullptr)
+    {
+        return;
+    }
+
+    free(buffer);
+    buffer = nullptr;
+    spritesCreated--;
+
+    std::vector<TFT_eSprite *> &sprites = liveSprites();
+    for (size_t index = 0; index < sprites.size(); index++)
+    {
+        if (sprites[index] == this)
+        {
+            sprites.erase(sprites.begin() + (long)index);
+            break;
+        }
+    }
+}
+
+void TFT_eSprite::fillSprite(uint32_t color)
+{
+    spriteText.clear();
+    fillRect(0, 0, currentWidth, currentHeight, color);
+}
+
+void TFT_eSprite::pushSprite(int32_t x, int32_t y)
+{
+    if (buffer != nullptr && parent != nullptr)
+    {
+        parent->pushImage(x, y, currentWidth, currentHeight, buffer);
+    }
+}
+
+void TFT_eSprite::setCreateLimit(int limit)
+{
+    spriteCreateLimit = limit;
+}
@@ -0,0 +1,171 @@
+// TFT_eSPI.h
+// ホスト用のTFT_eSPI（描画を行わず、パネルに送ったピクセル数と文字を記録する）
+
+#ifndef NATIVE_HAL_TFT_ESPI_H
+#define NATIVE_HAL_TFT_ESPI_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include "Arduino.h"
+
+#define TFT_BLACK 0x0000
+#define TFT_NAVY 0x000F
+#define TFT_DARKGREEN 0x03E0
+#define TFT_MAROON 0x7800
+#define TFT_DARKGREY 0x7BEF
+#define TFT_LIGHTGREY 0xD69A
+#define TFT_BLUE 0x001F
+#define TFT_GREEN 0x07E0
+#define TFT_CYAN 0x07FF
+#define TFT_RED 0xF800
+#define TFT_MAGENTA 0xF81F
+#define TFT_YELLOW 0xFFE0
+#define TFT_ORANGE 0xFDA0
+#define TFT_WHITE 0xFFFF
+
+#ifndef TFT_WIDTH
+#define TFT_WIDTH 240
+#endif
+#ifndef TFT_HEIGHT
+#define TFT_HEIGHT 320
+#endif
+
+// パネル（スプライト以外のTFT_eSPI）に送った描画の累計
+struct TftPanelStats
+{
+    unsigned long drawCalls;     // 描画命令の数
+    unsigned long pixels;        // 塗った（送った）ピクセル数
+    unsigned long glyphs;        // 描いた文字の数
+    unsigned long dmaTransfers;  // pushImageDMAの回数
+    unsigned long inversions;    // invertDisplayの呼び出し回数
+    std::string text;            // パネルに届いた文字列（改行を含む、スプライトの文字はパネルに送った時に加える）
+
+    // パネルへの転送量（16ビットカラー）
+    unsigned long bytes() const { return pixels * 2; }
+};
+
+class TFT_eSprite;
+
+class TFT_eSPI : public Print
+{
+public:
+    TFT_eSPI(int16_t width = TFT_WIDTH, int16_t height = TFT_HEIGHT);
+    ~TFT_eSPI() override = default;
+
+    void init(uint8_t tabColor = 0);
+    void begin(uint8_t tabColor = 0) { init(tabColor); }
+    void setRotation(uint8_t rotation);
+    uint8_t getRotation() const { return rotation; }
+    int16_t width() const { return currentWidth; }
+    int16_t height() const { return currentHeight; }
+    void invertDisplay(bool invert);
+
+    bool initDMA(bool ctrlCs = false);
+    void deInitDMA() {}
+    void pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t *data, uint16_t *buffer = nullptr);
+    void dmaWait() {}
+    void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t *data);
+    bool dmaBusy() { return false; }
+    void startWrite() {}
+    void endWrite() {}
+
+    void fillScreen(uint32_t color);
+    void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+    void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+    void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color);
+    void drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color);
+    void drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color);
+    void drawPixel(int32_t x, int32_t y, uint32_t color);
+    void fillCircle(int32_t x, int32_t y, int32_t r, uint32_t color);
+    void drawCircle(int32_t x, int32_t y, int32_t r, uint32_t color);
+    int16_t drawChar(uint16_t c, int32_t x, int32_t y, uint8_t font = 1);
+    void drawChar(int32_t x, int32_t y, uint16_t c, uint32_t color, uint32_t background, uint8_t size);
+
+    void setCursor(int16_t x, int16_t y)
+    {
+        cursorX = x;
+        cursorY = y;
+    }
+    int16_t getCursorX() const { return cursorX; }
+    int16_t getCursorY() const { return cursorY; }
+    void setTextColor(uint16_t color) { textColor = color; }
+    void setTextColor(uint16_t color, uint16_t background, bool fillBackground = false)
+    {
+        (void)background;
+        (void)fillBackground;
+        textColor = color;
+    }
+    void setTextSize(uint8_t size) { textSize = size > 0 ? size : 1; }
+    void setTextFont(uint8_t font) { (void)font; }
+    void setTextWrap(bool wrapX, bool wrapY = false)
+    {
+        (void)wrapX;
+        (void)wrapY;
+    }
+
+    // GLCDフォント（6x8ドット）で計算する
+    int16_t textWidth(const char *text, uint8_t font = 1);
+    int16_t textWidth(const String &text, uint8_t font = 1) { return textWidth(text.c_str(), font); }
+    int16_t fontHeight(uint8_t font = 1)
+    {
+        (void)font;
+        return (int16_t)(8 * textSize);
+    }
+
+    size_t write(uint8_t c) override;
+    using Print::write;
+
+    // パネルへの描画の累計（全インスタンス共通）
+    static TftPanelStats &panelStats();
+    static void resetPanelStats();
+
+protected:
+    // スプライトへの描画はパネルに送らないため数えない
+    virtual bool isPanel() const { return true; }
+    void record(unsigned long pixels);
+    void recordText(char c);
+    void recordSpriteText(const uint16_t *data);
+
+    // スプライトに描いた文字（パネルに送るまで保持する）
+    std::string spriteText;
+
+    int16_t baseWidth;
+    int16_t baseHeight;
+    int16_t currentWidth;
+    int16_t currentHeight;
+    uint8_t rotation;
+    int16_t cursorX;
+    int16_t cursorY;
+    uint16_t textColor;
+    uint8_t textSize;
+};
+
+class TFT_eSprite : public TFT_eSPI
+{
+public:
+    explicit TFT_eSprite(TFT_eSPI *parent);
+    ~TFT_eSprite() override;
+
+    void *setColorDepth(int8_t depth);
+    void *createSprite(int16_t width, int16_t height, uint8_t frames = 1);
+    void deleteSprite();
+    bool created() const { return buffer != nullptr; }
+    void *getPointer() { return buffer; }
+
+    void fillSprite(uint32_t color);
+    void pushSprite(int32_t x, int32_t y);
+
+    // スプライトを作成できる数の上限（メモリ不足時の経路を試すため、負の値で無制限）
+    static void setCreateLimit(int limit);
+
+protected:
+    bool isPanel() const override { return false; }
+
+private:
+    TFT_eSPI *parent;
+    uint16_t *buffer;
+    int8_t colorDepth;
+};
+
+#endif // NATIVE_HAL_TFT_ESPI_H
@@ -0,0 +1,114 @@
+// WString.cpp
+// ホスト用のArduino Stringの実装
+
+#include "WString.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+void String::trim()
+{
+    size_t begin = 0;
+    while (begin < value.length() && isspace((unsigned char)value[begin]))
+    {
+        begin++;
+    }
+
+    size_t end = value.length();
+    while (end > begin && isspace((unsigned char)value[end - 1]))
+    {
+        end--;
+    }
+
+    value = value.substr(begin, end - begin);
+}
+
+void String::toLowerCase()
+{
+    for (char &c : value)
+    {
+        c = (char)tolower((unsigned char)c);
+    }
+}
+
+void String::toUpperCase()
+{
+    for (char &c : value)
+    {
+        c = (char)toupper((unsigned char)c);
+    }
+}
+
+void String::replace(const String &from, const String &to)
+{
+    if (from.value.empty())
+    {
+        return;
+    }
+
+    size_t position = 0;
+    while ((position = value.find(from.value, position)) != std::string::npos)
+    {
+        value.replace(position, from.value.length(), to.value);
+        position += to.value.length();
+    }
+}
+
+void String::remove(unsigned int index, unsigned int count)
+{
+    if (index < value.length())
+    {
+        value.erase(index, count);
+    }
+}
+
+long String::toInt() const
+{
+    return strtol(value.c_str(), nullptr, 10);
+}
+
+float String::toFloat() const
+{
+    return strtof(value.c_str(), nullptr);
+}
+
+std::string String::formatSigned(long long number, unsigned char base)
+{
+    // Arduinoと同じく、10進以外の負数は2の補数のまま表示する
+    if (base == 10 && number < 0)
+    {
+        return "-" + formatUnsigned(0ULL - (unsigned long long)number, 10);
+    }
+    return formatUnsigned((unsigned long long)number, base);
+}
+
+std::string String::formatUnsigned(unsigned long long number, unsigned char base)
+{
+    if (base < 2 || base > 36)
+    {
+        base = 10;
+    }
+
+    char digits[65];
+    size_t length = 0;
+    do
+    {
+        unsigned int digit = (unsigned int)(number % base);
+        digits[length++] = (char)(digit < 10 ? '0' + digit : 'a' + digit - 10);
+        number /= base;
+    } while (number > 0);
+
+    std::string text;
+    while (length > 0)
+    {
+        text += digits[--length];
+    }
+    return text;
+}
+
+std::string String::formatFloat(double number, unsigned int decimalPlaces)
+{
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.*f", (int)decimalPlaces, number);
+    return buffer;
+}
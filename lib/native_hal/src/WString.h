@@ -0,0 +1,139 @@
+// WString.h
+// ホスト用のArduino String（std::stringで実装し、使っている機能だけを備える）
+
+#ifndef NATIVE_HAL_WSTRING_H
+#define NATIVE_HAL_WSTRING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+class String
+{
+public:
+    String(const char *text = "") : value(text != nullptr ? text : "") {}
+    String(const std::string &text) : value(text) {}
+    explicit String(char c) : value(1, c) {}
+    explicit String(unsigned char number, unsigned char base = 10) : value(formatUnsigned(number, base)) {}
+    explicit String(int number, unsigned char base = 10) : value(formatSigned(number, base)) {}
+    explicit String(unsigned int number, unsigned char base = 10) : value(formatUnsigned(number, base)) {}
+    explicit String(long number, unsigned char base = 10) : value(formatSigned(number, base)) {}
+    explicit String(unsigned long number, unsigned char base = 10) : value(formatUnsigned(number, base)) {}
+    explicit String(long long number, unsigned char base = 10) : value(formatSigned(number, base)) {}
+    explicit String(unsigned long long number, unsigned char base = 10) : value(formatUnsigned(number, base)) {}
+    explicit String(float number, unsigned int decimalPlaces = 2) : value(formatFloat(number, decimalPlaces)) {}
+    explicit String(double number, unsigned int decimalPlaces = 2) : value(formatFloat(number, decimalPlaces)) {}
+
+    const char *c_str() const { return value.c_str(); }
+    unsigned int length() const { return (unsigned int)value.length(); }
+    bool isEmpty() const { return value.empty(); }
+    void clear() { value.clear(); }
+    bool reserve(unsigned int size)
+    {
+        value.reserve(size);
+        return true;
+    }
+
+    String &operator=(const char *text)
+    {
+        value = text != nullptr ? text : "";
+        return *this;
+    }
+
+    bool concat(const String &text)
+    {
+        value += text.value;
+        return true;
+    }
+    bool concat(const char *text)
+    {
+        value += text != nullptr ? text : "";
+        return true;
+    }
+    bool concat(char c)
+    {
+        value += c;
+        return true;
+    }
+
+    String &operator+=(const String &text) { return append(text.value); }
+    String &operator+=(const char *text) { return append(text != nullptr ? text : ""); }
+    String &operator+=(char c) { return append(std::string(1, c)); }
+    String &operator+=(int number) { return append(formatSigned(number, 10)); }
+    String &operator+=(unsigned int number) { return append(formatUnsigned(number, 10)); }
+    String &operator+=(long number) { return append(formatSigned(number, 10)); }
+    String &operator+=(unsigned long number) { return append(formatUnsigned(number, 10)); }
+
+    char charAt(unsigned int index) const { return index < value.length() ? value[index] : '\0'; }
+    char operator[](unsigned int index) const { return charAt(index); }
+
+    int indexOf(char c, unsigned int fromIndex = 0) const { return toIndex(value.find(c, fromIndex)); }
+    int indexOf(const char *text, unsigned int fromIndex = 0) const { return toIndex(value.find(text, fromIndex)); }
+    int indexOf(const String &text, unsigned int fromIndex = 0) const { return toIndex(value.find(text.value, fromIndex)); }
+    int lastIndexOf(char c) const { return toIndex(value.rfind(c)); }
+    int lastIndexOf(const char *text) const { return toIndex(value.rfind(text)); }
+
+    String substring(unsigned int beginIndex) const
+    {
+        return beginIndex < value.length() ? String(value.substr(beginIndex)) : String();
+    }
+    String substring(unsigned int beginIndex, unsigned int endIndex) const
+    {
+        if (beginIndex > endIndex)
+        {
+            unsigned int swap = beginIndex;
+            beginIndex = endIndex;
+            endIndex = swap;
+        }
+        if (beginIndex >= value.length())
+        {
+            return String();
+        }
+        return String(value.substr(beginIndex, endIndex - beginIndex));
+    }
+
+    bool startsWith(const String &prefix) const { return value.compare(0, prefix.value.length(), prefix.value) == 0; }
+    bool endsWith(const String &suffix) const
+    {
+        return value.length() >= suffix.value.length() &&
+               value.compare(value.length() - suffix.value.length(), suffix.value.length(), suffix.value) == 0;
+    }
+    bool equals(const String &text) const { return value == text.value; }
+    bool equals(const char *text) const { return value == (text != nullptr ? text : ""); }
+
+    void trim();
+    void toLowerCase();
+    void toUpperCase();
+    void replace(const String &from, const String &to);
+    void remove(unsigned int index, unsigned int count = (unsigned int)-1);
+    long toInt() const;
+    float toFloat() const;
+
+    bool operator==(const String &text) const { return value == text.value; }
+    bool operator==(const char *text) const { return equals(text); }
+    bool operator!=(const String &text) const { return value != text.value; }
+    bool operator!=(const char *text) const { return !equals(text); }
+    bool operator<(const String &text) const { return value < text.value; }
+
+    friend String operator+(const String &left, const String &right) { return String(left.value + right.value); }
+    friend String operator+(const String &left, const char *right) { return left + String(right); }
+    friend String operator+(const char *left, const String &right) { return String(left) + right; }
+    friend String operator+(const String &left, char right) { return String(left.value + right); }
+
+private:
+    std::string value;
+
+    String &append(const std::string &text)
+    {
+        value += text;
+        return *this;
+    }
+
+    static int toIndex(size_t position) { return position == std::string::npos ? -1 : (int)position; }
+
+    static std::string formatSigned(long long number, unsigned char base);
+    static std::string formatUnsigned(unsigned long long number, unsigned char base);
+    static std::string formatFloat(double number, unsigned int decimalPlaces);
+};
+
+#endif // NATIVE_HAL_WSTRING_H
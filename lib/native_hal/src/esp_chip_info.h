@@ -0,0 +1,33 @@
+// esp_chip_info.h
+// ホスト用のチップ情報（ESP32、2コアとして返す）
+
+#ifndef NATIVE_HAL_ESP_CHIP_INFO_H
+#define NATIVE_HAL_ESP_CHIP_INFO_H
+
+#include <stdint.h>
+
+typedef enum
+{
+    CHIP_ESP32 = 1,
+    CHIP_ESP32S2 = 2,
+    CHIP_ESP32S3 = 9,
+    CHIP_ESP32C3 = 5,
+    CHIP_ESP32H2 = 16
+} esp_chip_model_t;
+
+#define CHIP_FEATURE_EMB_FLASH (1UL << 0)
+#define CHIP_FEATURE_WIFI_BGN (1UL << 1)
+#define CHIP_FEATURE_BLE (1UL << 4)
+#define CHIP_FEATURE_BT (1UL << 5)
+
+typedef struct
+{
+    esp_chip_model_t model;
+    uint32_t features;
+    uint16_t revision;
+    uint8_t cores;
+} esp_chip_info_t;
+
+void esp_chip_info(esp_chip_info_t *out_info);
+
+#endif // NATIVE_HAL_ESP_CHIP_INFO_H
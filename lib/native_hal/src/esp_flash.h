@@ -0,0 +1,14 @@
+// esp_flash.h
+// ホスト用のesp_flash（フラッシュの大きさはESP.getFlashChipSizeと同じ4MB）
+
+#ifndef NATIVE_HAL_ESP_FLASH_H
+#define NATIVE_HAL_ESP_FLASH_H
+
+#include <stdint.h>
+
+typedef struct esp_flash_t esp_flash_t;
+extern esp_flash_t *esp_flash_default_chip;
+
+int esp_flash_get_size(esp_flash_t *chip, uint32_t *out_size);
+
+#endif // NATIVE_HAL_ESP_FLASH_H
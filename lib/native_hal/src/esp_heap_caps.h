@@ -0,0 +1,32 @@
+// esp_heap_caps.h
+// ホスト用のheap_caps（確保失敗のコールバックと確保済みサイズの取得だけを備える）
+
+#ifndef NATIVE_HAL_ESP_HEAP_CAPS_H
+#define NATIVE_HAL_ESP_HEAP_CAPS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MALLOC_CAP_8BIT (1 << 2)
+#define MALLOC_CAP_DMA (1 << 3)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_DEFAULT (1 << 12)
+
+typedef int esp_err_t;
+#ifndef ESP_OK
+#define ESP_OK 0
+#define ESP_FAIL -1
+#endif
+
+typedef void (*esp_alloc_failed_hook_t)(size_t size, uint32_t caps, const char *function_name);
+
+esp_err_t heap_caps_register_failed_alloc_callback(esp_alloc_failed_hook_t callback);
+
+// 確保に失敗したことを登録済みのコールバックに伝える（テストから使う）
+void heap_caps_notify_failed_alloc(size_t size, uint32_t caps, const char *function_name);
+
+size_t heap_caps_get_allocated_size(void *ptr);
+size_t heap_caps_get_free_size(uint32_t caps);
+size_t heap_caps_get_largest_free_block(uint32_t caps);
+
+#endif // NATIVE_HAL_ESP_HEAP_CAPS_H
@@ -0,0 +1,11 @@
+// esp_rom_crc.h
+// ホスト用のROM CRC（ESP32のROMと同じCRC-32、反転込みの入出力）
+
+#ifndef NATIVE_HAL_ESP_ROM_CRC_H
+#define NATIVE_HAL_ESP_ROM_CRC_H
+
+#include <stdint.h>
+
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len);
+
+#endif // NATIVE_HAL_ESP_ROM_CRC_H
@@ -0,0 +1,28 @@
+// esp_system.h
+// ホスト用のesp_system（再起動とリセット要因）
+
+#ifndef NATIVE_HAL_ESP_SYSTEM_H
+#define NATIVE_HAL_ESP_SYSTEM_H
+
+#include <stdint.h>
+
+typedef enum
+{
+    ESP_RST_UNKNOWN,
+    ESP_RST_POWERON,
+    ESP_RST_EXT,
+    ESP_RST_SW,
+    ESP_RST_PANIC,
+    ESP_RST_INT_WDT,
+    ESP_RST_TASK_WDT,
+    ESP_RST_WDT,
+    ESP_RST_DEEPSLEEP,
+    ESP_RST_BROWNOUT,
+    ESP_RST_SDIO
+} esp_reset_reason_t;
+
+esp_reset_reason_t esp_reset_reason(void);
+uint32_t esp_get_free_heap_size(void);
+uint32_t esp_get_minimum_free_heap_size(void);
+
+#endif // NATIVE_HAL_ESP_SYSTEM_H
@@ -0,0 +1,11 @@
+// esp_timer.h
+// ホスト用のesp_timer（micros()と同じ時計を64ビットで返す）
+
+#ifndef NATIVE_HAL_ESP_TIMER_H
+#define NATIVE_HAL_ESP_TIMER_H
+
+#include <stdint.h>
+
+int64_t esp_timer_get_time(void);
+
+#endif // NATIVE_HAL_ESP_TIMER_H
@@ -0,0 +1,20 @@
+// FreeRTOS.h
+// ホスト用のFreeRTOS（タスクはスレッドに対応させる）
+
+#ifndef NATIVE_HAL_FREERTOS_H
+#define NATIVE_HAL_FREERTOS_H
+
+#include <stdint.h>
+
+typedef void *TaskHandle_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS pdTRUE
+#define portMAX_DELAY ((TickType_t)0xffffffffUL)
+#define portTICK_PERIOD_MS 1
+
+#endif // NATIVE_HAL_FREERTOS_H
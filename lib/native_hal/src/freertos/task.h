@@ -0,0 +1,12 @@
+// task.h
+// ホスト用のFreeRTOSのタスク関数
+
+#ifndef NATIVE_HAL_FREERTOS_TASK_H
+#define NATIVE_HAL_FREERTOS_TASK_H
+
+#include "FreeRTOS.h"
+
+// 呼び出したスレッドごとに異なるハンドルを返す
+TaskHandle_t xTaskGetCurrentTaskHandle();
+
+#endif // NATIVE_HAL_FREERTOS_TASK_H
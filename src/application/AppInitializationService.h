@@ -5,6 +5,7 @@
 #define APP_INITIALIZATION_SERVICE_H
 
 #include <Arduino.h>
+#include "EventScheduler.h"
 
 namespace Application
 {
@@ -20,8 +21,8 @@ namespace Application
         // セットアップフェーズの処理
         virtual void performSetup() = 0;
 
-        // 定期実行されるロジック
-        virtual void performLoop(unsigned long currentMillis) = 0;
+        // メインループに届いたイベントの処理
+        virtual void handleEvent(AppEvent event, unsigned long currentMillis) = 0;
     };
 }
 
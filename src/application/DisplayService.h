@@ -4,7 +4,7 @@
 #ifndef DISPLAY_SERVICE_H
 #define DISPLAY_SERVICE_H
 
-#include "../domain/BattleSchedule.h"
+#include "../domain/ScheduleSnapshot.h"
 #include "../domain/DisplaySettings.h"
 
 namespace Application
@@ -37,16 +37,12 @@ namespace Application
         // 表示状態をリセットする
         virtual void resetDisplayState() = 0;
 
+        // スケジュール画面が表示されているかどうか（他の画面で上書きされていないか）
+        virtual bool isShowingSchedules() = 0;
+
         // Update the entire screen with all schedule data
         virtual void updateScreen(
-            const Domain::BattleSchedule &regularSchedule,
-            const Domain::BattleSchedule &regularNextSchedule,
-            const Domain::BattleSchedule &xMatchSchedule,
-            const Domain::BattleSchedule &xMatchNextSchedule,
-            const Domain::BattleSchedule &bankaraChallengeSchedule,
-            const Domain::BattleSchedule &bankaraChallengeNextSchedule,
-            const Domain::BattleSchedule &bankaraOpenSchedule,
-            const Domain::BattleSchedule &bankaraOpenNextSchedule,
+            const Domain::ScheduleSnapshot &snapshot,
             const char *currentDateTime,
             const char *lastUpdateTime,
             const Domain::DisplaySettings &displaySettings) = 0;
@@ -74,16 +70,16 @@ namespace Application
         // Update time display at bottom of screen
         virtual void updateTimeDisplay() = 0;
 
-        // Update display with the specified schedules
+        // Number of pixels sent to the panel by the last updateScreen
+        virtual unsigned long getLastUpdatePixelsPushed() const = 0;
+
+        // Number of updateScreen calls since boot that drew straight to the panel
+        // because the off-screen buffers could not be allocated
+        virtual unsigned long getDirectDrawCount() const = 0;
+
+        // Update display with the schedules in the snapshot
         virtual void updateDisplay(
-            const Domain::BattleSchedule &regularSchedule,
-            const Domain::BattleSchedule &xSchedule,
-            const Domain::BattleSchedule &anarchyChallengeSchedule,
-            const Domain::BattleSchedule &anarchyOpenSchedule,
-            const Domain::BattleSchedule &regularNextSchedule,
-            const Domain::BattleSchedule &xNextSchedule,
-            const Domain::BattleSchedule &anarchyChallengeNextSchedule,
-            const Domain::BattleSchedule &anarchyOpenNextSchedule,
+            const Domain::ScheduleSnapshot &snapshot,
             const Domain::DisplaySettings &displaySettings) = 0;
     };
 
@@ -0,0 +1,199 @@
+// EventScheduler.h
+// メインループのイベントとタイマーを管理するスケジューラ
+
+#ifndef EVENT_SCHEDULER_H
+#define EVENT_SCHEDULER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace Application
+{
+    // メインループが処理するイベント
+    // 同じ種類のイベントは処理されるまで1つにまとめられる
+    enum class AppEvent : uint8_t
+    {
+        WIFI_POLL,        // WiFi接続処理（接続待ち・ポータル表示中のみ周期実行）
+        WIFI_CHANGED,     // WiFiの接続・切断の通知
+        INITIALIZE_CHECK, // アプリケーションの初期化チェック（初期化完了まで周期実行）
+        FETCH_COMPLETED,  // 取得タスクが結果を公開した
+        REFRESH_DUE,      // データ更新の時刻になった
+        TIME_DISPLAY,     // 時刻表示の更新
+        MEMORY_CHECK,     // 定期的なメモリ監視
+        SERIAL_INPUT,     // シリアルコンソールへの入力
+        TIME_SYNCED,      // NTPで時刻が同期された
+        COUNT
+    };
+
+    // Timer queue and pending-event set for the main loop.
+    // Times are always passed in by the caller, so the scheduler has no hardware
+    // dependency and can be driven by a virtual clock. Not thread-safe: other tasks
+    // hand events to the loop task, which is the only one calling post().
+    class EventScheduler
+    {
+    public:
+        // 有効なタイマーがない場合の待ち時間
+        static constexpr unsigned long NO_DEADLINE = 0xFFFFFFFFUL;
+
+        EventScheduler() : pendingEvents(0)
+        {
+            for (size_t i = 0; i < EVENT_COUNT; i++)
+            {
+                timers[i].armed = false;
+            }
+        }
+
+        // 一度だけ、delayMillis後にイベントを発生させる（設定済みのタイマーは置き換える）
+        void scheduleAfter(AppEvent event, unsigned long nowMillis, unsigned long delayMillis)
+        {
+            arm(event, nowMillis, delayMillis, 0);
+        }
+
+        // periodMillisごとにイベントを発生させる（最初の発生はperiodMillis後）
+        void scheduleEvery(AppEvent event, unsigned long nowMillis, unsigned long periodMillis)
+        {
+            arm(event, nowMillis, periodMillis, periodMillis);
+        }
+
+        // タイマーを止める（発生済みで未処理のイベントは残る）
+        void cancel(AppEvent event)
+        {
+            timers[index(event)].armed = false;
+        }
+
+        bool isScheduled(AppEvent event) const
+        {
+            return timers[index(event)].armed;
+        }
+
+        // 周期タイマーの間隔（止まっている場合は0）
+        unsigned long getPeriod(AppEvent event) const
+        {
+            const Timer &timer = timers[index(event)];
+            return timer.armed ? timer.period : 0;
+        }
+
+        // イベントをすぐに発生させる
+        void post(AppEvent event)
+        {
+            pendingEvents |= bit(event);
+        }
+
+        // 処理すべきイベントを1つ取り出す（なければfalse）
+        // 発生済みのイベントを列挙順に返した後、期限の来たタイマーを期限の早い順に返す
+        bool takeNext(unsigned long nowMillis, AppEvent &event)
+        {
+            for (size_t i = 0; i < EVENT_COUNT; i++)
+            {
+                if (pendingEvents & (1UL << i))
+                {
+                    pendingEvents &= ~(1UL << i);
+                    event = static_cast<AppEvent>(i);
+                    return true;
+                }
+            }
+
+            size_t dueIndex = EVENT_COUNT;
+            unsigned long mostOverdue = 0;
+            for (size_t i = 0; i < EVENT_COUNT; i++)
+            {
+                const Timer &timer = timers[i];
+                if (!timer.armed)
+                {
+                    continue;
+                }
+
+                unsigned long elapsed = nowMillis - timer.start;
+                if (elapsed >= timer.delay && (dueIndex == EVENT_COUNT || elapsed - timer.delay > mostOverdue))
+                {
+                    dueIndex = i;
+                    mostOverdue = elapsed - timer.delay;
+                }
+            }
+
+            if (dueIndex == EVENT_COUNT)
+            {
+                return false;
+            }
+
+            fire(timers[dueIndex], nowMillis);
+            event = static_cast<AppEvent>(dueIndex);
+            return true;
+        }
+
+        // 次にイベントを処理するまでの待ち時間
+        // 発生済みのイベントか期限切れのタイマーがあれば0、タイマーがなければNO_DEADLINE
+        unsigned long getMillisUntilNextEvent(unsigned long nowMillis) const
+        {
+            if (pendingEvents != 0)
+            {
+                return 0;
+            }
+
+            unsigned long earliest = NO_DEADLINE;
+            for (size_t i = 0; i < EVENT_COUNT; i++)
+            {
+                const Timer &timer = timers[i];
+                if (!timer.armed)
+                {
+                    continue;
+                }
+
+                unsigned long elapsed = nowMillis - timer.start;
+                unsigned long remaining = elapsed >= timer.delay ? 0 : timer.delay - elapsed;
+                if (remaining < earliest)
+                {
+                    earliest = remaining;
+                }
+            }
+
+            return earliest;
+        }
+
+    private:
+        static constexpr size_t EVENT_COUNT = static_cast<size_t>(AppEvent::COUNT);
+
+        // millis()の桁あふれに耐えるよう、期限は開始時刻と待ち時間で持つ
+        struct Timer
+        {
+            unsigned long start;
+            unsigned long delay;
+            unsigned long period; // 0は一度だけ
+            bool armed;
+        };
+
+        Timer timers[EVENT_COUNT];
+        uint32_t pendingEvents;
+
+        static size_t index(AppEvent event) { return static_cast<size_t>(event); }
+        static uint32_t bit(AppEvent event) { return 1UL << index(event); }
+
+        void arm(AppEvent event, unsigned long nowMillis, unsigned long delayMillis, unsigned long periodMillis)
+        {
+            Timer &timer = timers[index(event)];
+            timer.start = nowMillis;
+            timer.delay = delayMillis;
+            timer.period = periodMillis;
+            timer.armed = true;
+        }
+
+        void fire(Timer &timer, unsigned long nowMillis)
+        {
+            if (timer.period == 0)
+            {
+                timer.armed = false;
+                return;
+            }
+
+            // 周期を保ったまま次の期限に進め、大きく遅れた場合は取りこぼした分をまとめて捨てる
+            timer.start += timer.delay;
+            timer.delay = timer.period;
+            if (nowMillis - timer.start >= timer.period)
+            {
+                timer.start = nowMillis;
+            }
+        }
+    };
+}
+
+#endif // EVENT_SCHEDULER_H
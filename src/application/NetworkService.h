@@ -5,6 +5,7 @@
 #define NETWORK_SERVICE_H
 
 #include <Arduino.h>
+#include <functional>
 
 namespace Application
 {
@@ -13,6 +14,45 @@ namespace Application
     class NetworkService
     {
     public:
+        // Callback that consumes a response body directly from the connection
+        using StreamHandler = std::function<bool(Stream &stream)>;
+
+        // Validators remembered from a previous response for conditional requests
+        struct CacheValidators
+        {
+            char etag[64];         // ETag header value (sent as If-None-Match)
+            char lastModified[32]; // Last-Modified header value (sent as If-Modified-Since)
+
+            CacheValidators()
+            {
+                etag[0] = '\0';
+                lastModified[0] = '\0';
+            }
+        };
+
+        // Result of a conditional request
+        enum class FetchResult
+        {
+            FAILED,       // Request or handler failed
+            NOT_MODIFIED, // Server answered 304, handler was not called
+            UPDATED       // Handler consumed a new response body
+        };
+
+        // Called when an asynchronous request finishes
+        using CompletionHandler = std::function<void(FetchResult result)>;
+
+        // Request statistics for HTTP traffic
+        struct ConnectionStats
+        {
+            unsigned long requestCount;
+            unsigned long handshakeCount;
+            unsigned long requestBytes; // Request lines and headers sent
+            unsigned long headerBytes;  // Status lines and headers received
+            unsigned long bodyBytes;    // Response bodies received, without chunk framing
+
+            ConnectionStats() : requestCount(0), handshakeCount(0), requestBytes(0), headerBytes(0), bodyBytes(0) {}
+        };
+
         virtual ~NetworkService() = default;
 
         // Connect to WiFi network
@@ -27,7 +67,43 @@ namespace Application
         // Perform HTTP GET request and return response body
         virtual String httpGet(const char *url) = 0;
 
-        // Configure time service (NTP)
+        // Perform HTTP GET request and hand the response body stream to the handler
+        // without buffering it. Returns false if the request failed, otherwise the
+        // handler's result.
+        virtual bool httpGetStream(const char *url, const StreamHandler &handler) = 0;
+
+        // Perform a conditional HTTP GET using the stored validators. The handler is
+        // only called for a new body, and the validators are replaced only when the
+        // handler succeeds.
+        virtual FetchResult httpGetStreamIfModified(
+            const char *url,
+            CacheValidators &validators,
+            const StreamHandler &handler) = 0;
+
+        // Start a conditional HTTP GET and return without waiting for the response.
+        // poll() advances the request and calls onComplete when it finishes; the
+        // validators must stay valid until then. Several requests may be in flight
+        // and complete in any order. Returns false if the request could not be
+        // started (every connection is busy, or the URL is invalid).
+        virtual bool startHttpGetIfModified(
+            const char *url,
+            CacheValidators &validators,
+            const StreamHandler &handler,
+            const CompletionHandler &onComplete) = 0;
+
+        // Advance every in-flight request by one step. Returns true while any is in flight
+        virtual bool poll() = 0;
+
+        // Get request, TLS handshake and byte counts since the last reset
+        virtual ConnectionStats getConnectionStats() = 0;
+
+        // Reset request, TLS handshake and byte counts
+        virtual void resetConnectionStats() = 0;
+
+        // Close kept-alive connections and release their resources
+        virtual void closeConnections() = 0;
+
+        // Configure time service (NTP). Returns without waiting for the first sync
         virtual void configureTimeService() = 0;
 
         // Get current local time formatted as YYYY/MM/DD HH:MM
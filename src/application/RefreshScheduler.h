@@ -0,0 +1,106 @@
+// RefreshScheduler.h
+// スケジュールの切り替わり時刻に合わせてデータ更新のタイミングを決めるスケジューラ
+
+#ifndef REFRESH_SCHEDULER_H
+#define REFRESH_SCHEDULER_H
+
+#include <stdint.h>
+
+namespace Application
+{
+    // スロット境界に合わせて次回のデータ取得時刻を決めるスケジューラ
+    // 時刻はすべて呼び出し側から渡すため、ハードウェアに依存しない
+    class RefreshScheduler
+    {
+    public:
+        // スロット境界から取得までの待ち時間（APIの切り替わりを待つ）
+        static constexpr unsigned long SETTLE_DELAY = 60UL * 1000;
+
+        // 境界が分からない場合でもこの間隔で必ず取得する
+        static constexpr unsigned long MAX_REFRESH_INTERVAL = 2UL * 60 * 60 * 1000;
+
+        // 再試行の初回待ち時間と上限
+        static constexpr unsigned long RETRY_BASE_DELAY = 30UL * 1000;
+        static constexpr unsigned long RETRY_MAX_DELAY = 10UL * 60 * 1000;
+
+        explicit RefreshScheduler(uint32_t randomSeed = 1)
+            : nextRefreshMillis(0),
+              failureCount(0),
+              randomState(randomSeed != 0 ? randomSeed : 1)
+        {
+        }
+
+        // 次回の取得時刻を過ぎているかどうか
+        bool isRefreshDue(unsigned long nowMillis) const
+        {
+            return (long)(nowMillis - nextRefreshMillis) >= 0;
+        }
+
+        // 取得後に現在のスロットが有効な場合：次の境界の少し後に取得する
+        // secondsUntilBoundaryは最も早く終わるスロットの終了までの秒数
+        void scheduleAtBoundary(unsigned long nowMillis, long secondsUntilBoundary)
+        {
+            failureCount = 0;
+
+            unsigned long delayMillis = (unsigned long)secondsUntilBoundary * 1000 + SETTLE_DELAY;
+            if (delayMillis > MAX_REFRESH_INTERVAL)
+            {
+                delayMillis = MAX_REFRESH_INTERVAL;
+            }
+
+            scheduleAfter(nowMillis, delayMillis);
+        }
+
+        // 取得に失敗した、または取得したデータが既に古い場合：ジッター付き指数バックオフで再試行する
+        void scheduleRetry(unsigned long nowMillis)
+        {
+            unsigned long delayMillis = RETRY_BASE_DELAY;
+            for (unsigned int i = 0; i < failureCount && delayMillis < RETRY_MAX_DELAY; i++)
+            {
+                delayMillis *= 2;
+            }
+            if (delayMillis > RETRY_MAX_DELAY)
+            {
+                delayMillis = RETRY_MAX_DELAY;
+            }
+
+            // 複数台が同時に再試行しないよう±25%の揺らぎを加える
+            unsigned long jitterRange = delayMillis / 2;
+            delayMillis = delayMillis - jitterRange / 2 + nextRandom() % (jitterRange + 1);
+
+            failureCount++;
+            scheduleAfter(nowMillis, delayMillis);
+        }
+
+        // すぐに取得するよう要求する
+        void requestImmediateRefresh(unsigned long nowMillis)
+        {
+            scheduleAfter(nowMillis, 0);
+        }
+
+        // 状態の取得
+        unsigned long getNextRefreshMillis() const { return nextRefreshMillis; }
+        unsigned int getFailureCount() const { return failureCount; }
+
+    private:
+        unsigned long nextRefreshMillis;
+        unsigned int failureCount;
+        uint32_t randomState;
+
+        void scheduleAfter(unsigned long nowMillis, unsigned long delayMillis)
+        {
+            nextRefreshMillis = nowMillis + delayMillis;
+        }
+
+        // xorshift32による疑似乱数（ジッター用）
+        uint32_t nextRandom()
+        {
+            randomState ^= randomState << 13;
+            randomState ^= randomState >> 17;
+            randomState ^= randomState << 5;
+            return randomState;
+        }
+    };
+}
+
+#endif // REFRESH_SCHEDULER_H
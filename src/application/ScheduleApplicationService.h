@@ -4,6 +4,7 @@
 #ifndef SCHEDULE_APPLICATION_SERVICE_H
 #define SCHEDULE_APPLICATION_SERVICE_H
 
+#include <Arduino.h>
 #include "ScheduleService.h"
 #include "DisplayService.h"
 #include "NetworkService.h"
@@ -17,6 +18,29 @@ namespace Application
     class ScheduleApplicationService
     {
     public:
+        // データ更新の結果（次回の更新時刻の決め方が変わる）
+        enum class RefreshResult
+        {
+            FAILED,       // 確認できなかったバトルタイプがある（再試行する）
+            NOT_MODIFIED, // 全バトルタイプを確認でき、変化はなかった
+            UPDATED       // 全バトルタイプを確認でき、スケジュールが変化した
+        };
+
+        // 直近のデータ更新の各段階の計測値
+        struct RefreshMetrics
+        {
+            unsigned long fetchMillis;  // 取得と解析（updateAllSchedules）
+            unsigned long renderMillis; // 画面の更新（再描画しなかった場合は0）
+            unsigned long pixelsPushed; // 画面に送ったピクセル数
+            unsigned long directDraws;  // スプライトを確保できず画面に直接描画した回数
+            bool updated;               // スケジュールが変化したかどうか（失敗時に保持分で次のスロットへ進んだ場合を含む）
+            RefreshResult result;
+            ScheduleRepository::UpdateStats updateStats;
+
+            RefreshMetrics() : fetchMillis(0), renderMillis(0), pixelsPushed(0), directDraws(0), updated(false),
+                               result(RefreshResult::FAILED) {}
+        };
+
         ScheduleApplicationService(
             ScheduleService &scheduleService,
             DisplayService &displayService,
@@ -47,10 +71,11 @@ namespace Application
 
                 // Initial data fetch - 初回データ取得なのでフルスクリーン表示
                 displayService.showLoadingMessage("Fetching data...", false);
-                scheduleService.updateAllSchedules();
+                Domain::ScheduleSnapshot snapshot;
+                RefreshMetrics metrics = fetchAllData(snapshot);
 
                 // Update display
-                updateDisplay();
+                applyFetchedData(snapshot, metrics);
             }
 
             return connected;
@@ -87,10 +112,11 @@ namespace Application
 
             // Initial data fetch - 初回データ取得なのでフルスクリーン表示
             displayService.showLoadingMessage("Fetching data...", false);
-            scheduleService.updateAllSchedules();
+            Domain::ScheduleSnapshot snapshot;
+            RefreshMetrics metrics = fetchAllData(snapshot);
 
             // Update display
-            updateDisplay();
+            applyFetchedData(snapshot, metrics);
 
             return true;
         }
@@ -101,11 +127,96 @@ namespace Application
             // アプリケーションが初期化済みの場合はバックグラウンド更新を使用
             displayService.showLoadingMessage("Updating data...", true);
 
-            // Update all schedule data
-            scheduleService.updateAllSchedules();
+            Domain::ScheduleSnapshot snapshot;
+            RefreshMetrics metrics = fetchAllData(snapshot);
+            applyFetchedData(snapshot, metrics);
+        }
+
+        // スケジュールを取得・解析してスナップショットに書き出す
+        // 画面には触れないため、描画とは別のタスクから呼び出せる（リポジトリはこのタスクだけが使うこと）
+        RefreshMetrics fetchAllData(Domain::ScheduleSnapshot &snapshot)
+        {
+            RefreshMetrics metrics;
+
+            unsigned long fetchStart = millis();
+            metrics.updated = scheduleService.updateAllSchedules();
+            metrics.fetchMillis = millis() - fetchStart;
+            metrics.updateStats = scheduleService.getLastUpdateStats();
+
+            // 変化の有無とは別に、サーバーで確認できなかった場合は失敗として再試行させる
+            if (!metrics.updateStats.confirmed)
+            {
+                metrics.result = RefreshResult::FAILED;
+            }
+            else
+            {
+                metrics.result = metrics.updated ? RefreshResult::UPDATED : RefreshResult::NOT_MODIFIED;
+            }
+
+            snapshot = scheduleService.getSnapshot();
+            return metrics;
+        }
+
+        // 再起動前に保存したスケジュールを取得側に戻し、そのまま表示する
+        // 取得タスクを起動する前に呼び出すこと（起動後はリポジトリを取得タスクだけが使う）
+        void showSavedSnapshot(const Domain::ScheduleSnapshot &saved)
+        {
+            scheduleService.restoreSnapshot(saved);
+            currentSnapshot = scheduleService.getSnapshot();
+            updateDisplay();
+        }
+
+        // 取得したスナップショットを表示中のものとして保持し、画面を更新する
+        void applyFetchedData(const Domain::ScheduleSnapshot &snapshot, const RefreshMetrics &metrics)
+        {
+            // 取得に失敗し続けて古いことを示す区画が変わった場合も描き直す
+            bool stalenessChanged = !currentSnapshot.hasSameStaleness(snapshot);
+            currentSnapshot = snapshot;
+            lastRefreshMetrics = metrics;
+
+            // 変更がなく、スケジュール画面が表示されたままなら再描画しない
+            // 下部情報バーだけは描き直し、取得中に出した更新インジケータを消す
+            if (!metrics.updated && !stalenessChanged && displayService.isShowingSchedules())
+            {
+                displayService.updateTimeDisplay();
+                return;
+            }
 
             // Update display
+            unsigned long renderStart = millis();
+            unsigned long directDrawsBefore = displayService.getDirectDrawCount();
             updateDisplay();
+            lastRefreshMetrics.renderMillis = millis() - renderStart;
+            lastRefreshMetrics.pixelsPushed = displayService.getLastUpdatePixelsPushed();
+            lastRefreshMetrics.directDraws = displayService.getDirectDrawCount() - directDrawsBefore;
+        }
+
+        // 表示中のスケジュールが古いかどうかを現在の時刻で判定し直し、変わった区画があれば描き直す
+        // 取得が止まっている間も古いことを示せるよう、毎分の時刻表示の更新で呼ぶ
+        bool refreshStaleness(unsigned long nowMillis)
+        {
+            if (!currentSnapshot.updateStaleness(nowMillis))
+            {
+                return false;
+            }
+
+            if (displayService.isShowingSchedules())
+            {
+                updateDisplay();
+            }
+            return true;
+        }
+
+        // 直近に反映した取得結果の計測値
+        const RefreshMetrics &getLastRefreshMetrics() const
+        {
+            return lastRefreshMetrics;
+        }
+
+        // 現在のスロットのうち最も早く終わるものまでの秒数（0以下ならデータが古い）
+        long getSecondsUntilNextSlotChange(time_t now)
+        {
+            return currentSnapshot.getSecondsUntilNextSlotChange(now);
         }
 
         // Update only the time display (for more efficient updates)
@@ -117,29 +228,8 @@ namespace Application
         // Update display with current schedule data
         void updateDisplay()
         {
-            // Get current schedules
-            Domain::BattleSchedule regularSchedule = scheduleService.getCurrentRegularSchedule();
-            Domain::BattleSchedule xSchedule = scheduleService.getCurrentXMatchSchedule();
-            Domain::BattleSchedule anarchyChallengeSchedule = scheduleService.getCurrentBankaraChallengeSchedule();
-            Domain::BattleSchedule anarchyOpenSchedule = scheduleService.getCurrentBankaraOpenSchedule();
-
-            // Get next schedules
-            Domain::BattleSchedule regularNextSchedule = scheduleService.getNextRegularSchedule();
-            Domain::BattleSchedule xNextSchedule = scheduleService.getNextXMatchSchedule();
-            Domain::BattleSchedule anarchyChallengeNextSchedule = scheduleService.getNextBankaraChallengeSchedule();
-            Domain::BattleSchedule anarchyOpenNextSchedule = scheduleService.getNextBankaraOpenSchedule();
-
-            // Update display with schedules
-            displayService.updateDisplay(
-                regularSchedule,
-                xSchedule,
-                anarchyChallengeSchedule,
-                anarchyOpenSchedule,
-                regularNextSchedule,
-                xNextSchedule,
-                anarchyChallengeNextSchedule,
-                anarchyOpenNextSchedule,
-                displaySettings);
+            // Update display with the last fetched schedules of every battle type
+            displayService.updateDisplay(currentSnapshot, displaySettings);
         }
 
         // Set display settings
@@ -153,6 +243,10 @@ namespace Application
         DisplayService &displayService;
         NetworkService &networkService;
         Domain::DisplaySettings displaySettings;
+        RefreshMetrics lastRefreshMetrics;
+
+        // 画面に表示しているスケジュール（取得側のリポジトリとは独立に保持する）
+        Domain::ScheduleSnapshot currentSnapshot;
     };
 
 } // namespace Application
@@ -4,8 +4,7 @@
 #ifndef SCHEDULE_REPOSITORY_H
 #define SCHEDULE_REPOSITORY_H
 
-#include "../domain/BattleSchedule.h"
-#include "../domain/BattleType.h"
+#include "../domain/ScheduleSnapshot.h"
 
 namespace Application
 {
@@ -16,14 +15,37 @@ namespace Application
     public:
         virtual ~ScheduleRepository() = default;
 
-        // Fetch current schedule for a battle type
-        virtual Domain::BattleSchedule fetchCurrentSchedule(const Domain::BattleType &battleType) = 0;
-
-        // Fetch next schedule for a battle type
-        virtual Domain::BattleSchedule fetchNextSchedule(const Domain::BattleType &battleType) = 0;
+        // Statistics of the last updateAllSchedules call
+        struct UpdateStats
+        {
+            unsigned long requestCount;   // HTTPリクエスト数
+            unsigned long handshakeCount; // TLSハンドシェイク数
+            unsigned long requestBytes;   // 送信したリクエスト行とヘッダのバイト数
+            unsigned long headerBytes;    // 受信したステータス行とヘッダのバイト数
+            unsigned long bodyBytes;      // 受信したボディのバイト数
+            unsigned long parseMillis;    // JSON解析に費やした時間（ストリーミング解析のため本文の受信時間を含む）
+            unsigned long jsonPeakBytes;  // 解析に使ったメモリの最大値
+            unsigned long heapFallbacks;  // 専用領域に収まらず汎用ヒープから確保した回数
+            bool confirmed;               // 全バトルタイプのスロットをサーバーで確認できたか（304を含む）
+
+            UpdateStats() : requestCount(0), handshakeCount(0), requestBytes(0), headerBytes(0), bodyBytes(0),
+                            parseMillis(0), jsonPeakBytes(0), heapFallbacks(0), confirmed(false) {}
+        };
+
+        // Copy the current and next schedules of every battle type into the snapshot
+        virtual void readSnapshot(Domain::ScheduleSnapshot &snapshot) = 0;
+
+        // Seed the repository with a snapshot saved before the last reboot
+        // The restored slots count as unconfirmed until the next successful update
+        virtual void restoreSnapshot(const Domain::ScheduleSnapshot &snapshot) = 0;
 
         // Update all schedules for all battle types
-        virtual void updateAllSchedules() = 0;
+        // Returns false if nothing changed since the previous update
+        // Whether the server could be reached is reported separately in UpdateStats::confirmed
+        virtual bool updateAllSchedules() = 0;
+
+        // Get statistics of the last updateAllSchedules call
+        virtual UpdateStats getLastUpdateStats() const = 0;
     };
 
 } // namespace Application
@@ -4,8 +4,7 @@
 #ifndef SCHEDULE_SERVICE_H
 #define SCHEDULE_SERVICE_H
 
-#include "../domain/BattleSchedule.h"
-#include "../domain/BattleType.h"
+#include "../domain/ScheduleSnapshot.h"
 #include "ScheduleRepository.h"
 
 namespace Application
@@ -18,62 +17,38 @@ namespace Application
         explicit ScheduleService(ScheduleRepository &repository)
             : repository(repository) {}
 
-        // Get current schedule for regular battles
-        Domain::BattleSchedule getCurrentRegularSchedule()
+        // Get the current and next schedules of every battle type in one batch
+        // The returned reference stays valid until the next call
+        const Domain::ScheduleSnapshot &getSnapshot()
         {
-            return repository.fetchCurrentSchedule(Domain::BattleType::regular());
+            repository.readSnapshot(snapshot);
+            return snapshot;
         }
 
-        // Get next schedule for regular battles
-        Domain::BattleSchedule getNextRegularSchedule()
+        // Restore the schedules saved before the last reboot
+        void restoreSnapshot(const Domain::ScheduleSnapshot &saved)
         {
-            return repository.fetchNextSchedule(Domain::BattleType::regular());
+            repository.restoreSnapshot(saved);
         }
 
-        // Get current schedule for X matches
-        Domain::BattleSchedule getCurrentXMatchSchedule()
-        {
-            return repository.fetchCurrentSchedule(Domain::BattleType::xMatch());
-        }
-
-        // Get next schedule for X matches
-        Domain::BattleSchedule getNextXMatchSchedule()
-        {
-            return repository.fetchNextSchedule(Domain::BattleType::xMatch());
-        }
-
-        // Get current schedule for Bankara Challenge
-        Domain::BattleSchedule getCurrentBankaraChallengeSchedule()
-        {
-            return repository.fetchCurrentSchedule(Domain::BattleType::bankaraChallenge());
-        }
-
-        // Get next schedule for Bankara Challenge
-        Domain::BattleSchedule getNextBankaraChallengeSchedule()
-        {
-            return repository.fetchNextSchedule(Domain::BattleType::bankaraChallenge());
-        }
-
-        // Get current schedule for Bankara Open
-        Domain::BattleSchedule getCurrentBankaraOpenSchedule()
-        {
-            return repository.fetchCurrentSchedule(Domain::BattleType::bankaraOpen());
-        }
-
-        // Get next schedule for Bankara Open
-        Domain::BattleSchedule getNextBankaraOpenSchedule()
+        // Update all schedules
+        // Returns false if nothing changed since the previous update
+        bool updateAllSchedules()
         {
-            return repository.fetchNextSchedule(Domain::BattleType::bankaraOpen());
+            return repository.updateAllSchedules();
         }
 
-        // Update all schedules
-        void updateAllSchedules()
+        // Get statistics of the last update
+        ScheduleRepository::UpdateStats getLastUpdateStats() const
         {
-            repository.updateAllSchedules();
+            return repository.getLastUpdateStats();
         }
 
     private:
         ScheduleRepository &repository;
+
+        // 最後に読み出したスケジュール（getSnapshotのたびに上書きする）
+        Domain::ScheduleSnapshot snapshot;
     };
 
 } // namespace Application
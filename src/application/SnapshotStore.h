@@ -0,0 +1,25 @@
+// SnapshotStore.h
+// 最後に取得したスケジュールを再起動後も表示できるよう保存するサービスインターフェース
+
+#ifndef SNAPSHOT_STORE_H
+#define SNAPSHOT_STORE_H
+
+#include "../domain/ScheduleSnapshot.h"
+
+namespace Application
+{
+    // 最後に取得したスケジュールを保存するサービスインターフェース
+    class SnapshotStore
+    {
+    public:
+        virtual ~SnapshotStore() = default;
+
+        // スケジュールを保存する（前回保存したものは置き換える）
+        virtual bool save(const Domain::ScheduleSnapshot &snapshot) = 0;
+
+        // 保存したスケジュールを読み込む（保存されていない、または壊れている場合はfalse）
+        virtual bool load(Domain::ScheduleSnapshot &snapshot) = 0;
+    };
+}
+
+#endif // SNAPSHOT_STORE_H
@@ -26,6 +26,9 @@ namespace Application
     public:
         virtual ~WiFiConnectionManager() = default;
 
+        // 保存済みの設定があれば、画面を変えずに接続を始める（起動画面の表示と並行して進める）
+        virtual bool startConnecting() = 0;
+
         // WiFi接続の初期セットアップ
         virtual void setupWiFiConnection() = 0;
 
@@ -30,6 +30,9 @@ namespace Application
         // WiFiに接続する
         virtual bool connect(const Domain::WiFiSettings &settings) = 0;
 
+        // WiFiへの接続を始め、完了を待たずに戻る（この後にキャプティブポータルを開いても接続を続ける）
+        virtual bool beginConnect(const Domain::WiFiSettings &settings) = 0;
+
         // WiFiの接続状態を確認する
         virtual bool isConnected() = 0;
 
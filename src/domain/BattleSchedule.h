@@ -4,7 +4,10 @@
 #ifndef BATTLE_SCHEDULE_H
 #define BATTLE_SCHEDULE_H
 
-#include <Arduino.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
 #include "Rule.h"
 #include "Stage.h"
 #include "BattleType.h"
@@ -13,17 +16,22 @@ namespace Domain
 {
 
     // BattleSchedule Entity - represents a scheduled battle timeslot with stages and rule
+    // 値オブジェクトは1バイトの種別、時刻はUNIX時間の分で保持し、1スロットを12バイトに詰める
+    // 表示用の"HH:MM"は描画時に必要な分だけ組み立てる
     class BattleSchedule
     {
     public:
-        // Create a battle schedule
+        // Buffer size for a formatted "HH:MM" time
+        static constexpr size_t TIME_TEXT_SIZE = 6;
+
+        // Create a battle schedule (times are UNIX time, 0 if unknown)
         static BattleSchedule create(
             const BattleType &battleType,
             const Rule &rule,
             const Stage &stage1,
             const Stage &stage2,
-            const char *startTime,
-            const char *endTime)
+            time_t startTime,
+            time_t endTime)
         {
             return BattleSchedule(battleType, rule, stage1, stage2, startTime, endTime);
         }
@@ -35,37 +43,45 @@ namespace Domain
         }
 
         // Default constructor - creates an empty/invalid schedule for Regular Battle
-        BattleSchedule() : battleType(BattleType::regular()),
-                           rule(Rule::unknown()),
-                           stage1(Stage::fromJapaneseName("不明")),
-                           stage2(Stage::fromJapaneseName("不明")),
-                           valid(false)
-        {
-            strcpy(startTime, "--:--");
-            strcpy(endTime, "--:--");
-        }
+        BattleSchedule() : BattleSchedule(BattleType::regular()) {}
 
         // Value getters
-        const BattleType &getBattleType() const { return battleType; }
-        const Rule &getRule() const { return rule; }
-        const Stage &getStage1() const { return stage1; }
-        const Stage &getStage2() const { return stage2; }
+        BattleType getBattleType() const { return BattleType::fromType(static_cast<BattleType::Type>(battleType)); }
+        Rule getRule() const { return Rule::fromType(static_cast<Rule::Type>(rule)); }
+        Stage getStage1() const { return Stage::fromType(static_cast<Stage::Type>(stage1)); }
+        Stage getStage2() const { return Stage::fromType(static_cast<Stage::Type>(stage2)); }
 
-        // Get the start and end time strings
-        const char *getStartTime() const { return startTime; }
-        const char *getEndTime() const { return endTime; }
+        // Get the start and end as UNIX time (0 if unknown)
+        time_t getStartEpoch() const { return (time_t)startMinutes * 60; }
+        time_t getEndEpoch() const { return (time_t)endMinutes * 60; }
+
+        // Format the start and end as local "HH:MM" ("--:--" if unknown)
+        void formatStartTime(char *buffer, size_t bufferSize) const { formatTime(startMinutes, buffer, bufferSize); }
+        void formatEndTime(char *buffer, size_t bufferSize) const { formatTime(endMinutes, buffer, bufferSize); }
 
         // Check if this schedule is valid (has been properly populated)
         bool isValid() const { return valid; }
 
+        // Seconds from the given UNIX time until this slot ends.
+        // Zero or negative means the slot has ended or its end is unknown.
+        long getSecondsUntilEnd(time_t now) const
+        {
+            if (!valid || endMinutes == 0)
+            {
+                return 0;
+            }
+
+            return (long)(getEndEpoch() - now);
+        }
+
     private:
-        BattleType battleType;
-        Rule rule;
-        Stage stage1;
-        Stage stage2;
-        char startTime[6]; // "HH:MM\0"
-        char endTime[6];   // "HH:MM\0"
-        bool valid;
+        uint32_t startMinutes; // UNIX時間の分（0は不明）
+        uint32_t endMinutes;   // UNIX時間の分（0は不明）
+        uint8_t battleType : 7;
+        uint8_t valid : 1;
+        uint8_t rule;
+        uint8_t stage1;
+        uint8_t stage2;
 
         // Private constructor to enforce creation via factory methods
         BattleSchedule(
@@ -73,32 +89,52 @@ namespace Domain
             const Rule &rule,
             const Stage &stage1,
             const Stage &stage2,
-            const char *startTimeStr,
-            const char *endTimeStr) : battleType(battleType),
-                                      rule(rule),
-                                      stage1(stage1),
-                                      stage2(stage2),
-                                      valid(true)
+            time_t startTime,
+            time_t endTime) : startMinutes(toMinutes(startTime)),
+                              endMinutes(toMinutes(endTime)),
+                              battleType(static_cast<uint8_t>(battleType.getType())),
+                              valid(1),
+                              rule(static_cast<uint8_t>(rule.getType())),
+                              stage1(static_cast<uint8_t>(stage1.getType())),
+                              stage2(static_cast<uint8_t>(stage2.getType()))
         {
-            strncpy(startTime, startTimeStr, sizeof(startTime) - 1);
-            startTime[sizeof(startTime) - 1] = '\0';
-
-            strncpy(endTime, endTimeStr, sizeof(endTime) - 1);
-            endTime[sizeof(endTime) - 1] = '\0';
         }
 
         // Private constructor for invalid/empty schedule
-        explicit BattleSchedule(const BattleType &battleType) : battleType(battleType),
-                                                                rule(Rule::unknown()),
-                                                                stage1(Stage::fromJapaneseName("不明")),
-                                                                stage2(Stage::fromJapaneseName("不明")),
-                                                                valid(false)
+        explicit BattleSchedule(const BattleType &battleType) : startMinutes(0),
+                                                                endMinutes(0),
+                                                                battleType(static_cast<uint8_t>(battleType.getType())),
+                                                                valid(0),
+                                                                rule(static_cast<uint8_t>(Rule::Type::UNKNOWN)),
+                                                                stage1(static_cast<uint8_t>(Stage::Type::UNKNOWN)),
+                                                                stage2(static_cast<uint8_t>(Stage::Type::UNKNOWN))
         {
-            strcpy(startTime, "--:--");
-            strcpy(endTime, "--:--");
+        }
+
+        // 負の時刻（不明）は0として保持する
+        static uint32_t toMinutes(time_t time)
+        {
+            return time > 0 ? (uint32_t)(time / 60) : 0;
+        }
+
+        static void formatTime(uint32_t minutes, char *buffer, size_t bufferSize)
+        {
+            if (minutes == 0)
+            {
+                snprintf(buffer, bufferSize, "--:--");
+                return;
+            }
+
+            time_t time = (time_t)minutes * 60;
+            struct tm timeinfo;
+            localtime_r(&time, &timeinfo);
+            snprintf(buffer, bufferSize, "%02d:%02d", timeinfo.tm_hour, timeinfo.tm_min);
         }
     };
 
+    // 先読みするスロットを増やしても負担にならないよう、1スロットの大きさを保つ
+    static_assert(sizeof(BattleSchedule) <= 12, "BattleSchedule should stay packed");
+
 } // namespace Domain
 
-#endif // BATTLE_SCHEDULE_H
\ No newline at end of file
+#endif // BATTLE_SCHEDULE_H
@@ -1,57 +1,101 @@
 #include "BattleType.h"
+#include "Catalog.h"
 
 namespace Domain
 {
+    constexpr size_t BattleType::TYPE_COUNT;
 
-    const char *BattleType::getJapaneseName() const
+    namespace
     {
-        switch (type)
+        // BattleType::Typeの数
+        constexpr size_t BATTLE_TYPE_COUNT = BattleType::TYPE_COUNT;
+
+        // バトルタイプの名前などを項目ごとの配列にまとめたカタログ（各配列はBattleType::Typeの順）
+        struct BattleTypeCatalog
         {
-        case Type::REGULAR:
-            return "レギュラーマッチ";
-        case Type::X_MATCH:
-            return "Xマッチ";
-        case Type::BANKARA_CHALLENGE:
-            return "バンカラマッチ チャレンジ";
-        case Type::BANKARA_OPEN:
-            return "バンカラマッチ オープン";
-        default:
-            return "Unknown";
-        }
+            const char *japaneseNames[BATTLE_TYPE_COUNT];
+            const char *englishNames[BATTLE_TYPE_COUNT];
+            const char *romajiNames[BATTLE_TYPE_COUNT];
+            uint16_t colors[BATTLE_TYPE_COUNT];
+            const char *currentScheduleUrls[BATTLE_TYPE_COUNT];
+            const char *nextScheduleUrls[BATTLE_TYPE_COUNT];
+            const char *apiKeys[BATTLE_TYPE_COUNT];
+        };
+
+        constexpr BattleTypeCatalog BATTLE_TYPE_CATALOG PROGMEM = {
+            // japaneseNames
+            {
+                "レギュラーマッチ", // REGULAR
+                "Xマッチ", // X_MATCH
+                "バンカラマッチ チャレンジ", // BANKARA_CHALLENGE
+                "バンカラマッチ オープン", // BANKARA_OPEN
+            },
+            // englishNames
+            {
+                "Regular Battle", // REGULAR
+                "X Battle", // X_MATCH
+                "Anarchy Challenge", // BANKARA_CHALLENGE
+                "Anarchy Open", // BANKARA_OPEN
+            },
+            // romajiNames
+            {
+                "Regular Match", // REGULAR
+                "X Match", // X_MATCH
+                "Bankara Challenge", // BANKARA_CHALLENGE
+                "Bankara Open", // BANKARA_OPEN
+            },
+            // colors
+            {
+                0x7FE0, // REGULAR: Chartreuse (#7FFF00)
+                0x3E9C, // X_MATCH: MediumTurquoise (#48D1CC)
+                0xFD00, // BANKARA_CHALLENGE: Orange (#FFA500)
+                0xFD00, // BANKARA_OPEN: Orange (#FFA500)
+            },
+            // currentScheduleUrls
+            {
+                "https://spla3.yuu26.com/api/regular/now", // REGULAR
+                "https://spla3.yuu26.com/api/x/now", // X_MATCH
+                "https://spla3.yuu26.com/api/bankara-challenge/now", // BANKARA_CHALLENGE
+                "https://spla3.yuu26.com/api/bankara-open/now", // BANKARA_OPEN
+            },
+            // nextScheduleUrls
+            {
+                "https://spla3.yuu26.com/api/regular/next", // REGULAR
+                "https://spla3.yuu26.com/api/x/next", // X_MATCH
+                "https://spla3.yuu26.com/api/bankara-challenge/next", // BANKARA_CHALLENGE
+                "https://spla3.yuu26.com/api/bankara-open/next", // BANKARA_OPEN
+            },
+            // apiKeys
+            {
+                "regular", // REGULAR
+                "x", // X_MATCH
+                "bankara_challenge", // BANKARA_CHALLENGE
+                "bankara_open", // BANKARA_OPEN
+            }
+        };
+
+        // すべての種類に値が設定されていることをコンパイル時に確認する
+        static_assert(isCatalogComplete(BATTLE_TYPE_CATALOG.japaneseNames, BATTLE_TYPE_COUNT), "BattleType catalog is missing a Japanese name");
+        static_assert(isCatalogComplete(BATTLE_TYPE_CATALOG.englishNames, BATTLE_TYPE_COUNT), "BattleType catalog is missing an English name");
+        static_assert(isCatalogComplete(BATTLE_TYPE_CATALOG.romajiNames, BATTLE_TYPE_COUNT), "BattleType catalog is missing a romaji name");
+        static_assert(isCatalogComplete(BATTLE_TYPE_CATALOG.currentScheduleUrls, BATTLE_TYPE_COUNT), "BattleType catalog is missing a current schedule URL");
+        static_assert(isCatalogComplete(BATTLE_TYPE_CATALOG.nextScheduleUrls, BATTLE_TYPE_COUNT), "BattleType catalog is missing a next schedule URL");
+        static_assert(isCatalogComplete(BATTLE_TYPE_CATALOG.apiKeys, BATTLE_TYPE_COUNT), "BattleType catalog is missing an API key");
+    }
+
+    const char *BattleType::getJapaneseName() const
+    {
+        return BATTLE_TYPE_CATALOG.japaneseNames[static_cast<size_t>(type)];
     }
 
     const char *BattleType::getEnglishName() const
     {
-        switch (type)
-        {
-        case Type::REGULAR:
-            return "Regular Battle";
-        case Type::X_MATCH:
-            return "X Battle";
-        case Type::BANKARA_CHALLENGE:
-            return "Anarchy Challenge";
-        case Type::BANKARA_OPEN:
-            return "Anarchy Open";
-        default:
-            return "Unknown";
-        }
+        return BATTLE_TYPE_CATALOG.englishNames[static_cast<size_t>(type)];
     }
 
     const char *BattleType::getRomajiName() const
     {
-        switch (type)
-        {
-        case Type::REGULAR:
-            return "Regular Match";
-        case Type::X_MATCH:
-            return "X Match";
-        case Type::BANKARA_CHALLENGE:
-            return "Bankara Challenge";
-        case Type::BANKARA_OPEN:
-            return "Bankara Open";
-        default:
-            return "Unknown";
-        }
+        return BATTLE_TYPE_CATALOG.romajiNames[static_cast<size_t>(type)];
     }
 
     const char *BattleType::getDisplayName(bool useRomaji) const
@@ -61,52 +105,22 @@ namespace Domain
 
     uint16_t BattleType::getColor() const
     {
-        switch (type)
-        {
-        case Type::REGULAR:
-            return 0x7FE0; // Chartreuse (#7FFF00)
-        case Type::X_MATCH:
-            return 0x3E9C; // MediumTurquoise (#48D1CC)
-        case Type::BANKARA_CHALLENGE:
-        case Type::BANKARA_OPEN:
-            return 0xFD00; // Orange (#FFA500)
-        default:
-            return 0xFFFF; // White
-        }
+        return BATTLE_TYPE_CATALOG.colors[static_cast<size_t>(type)];
     }
 
     const char *BattleType::getCurrentScheduleUrl() const
     {
-        switch (type)
-        {
-        case Type::REGULAR:
-            return "https://spla3.yuu26.com/api/regular/now";
-        case Type::X_MATCH:
-            return "https://spla3.yuu26.com/api/x/now";
-        case Type::BANKARA_CHALLENGE:
-            return "https://spla3.yuu26.com/api/bankara-challenge/now";
-        case Type::BANKARA_OPEN:
-            return "https://spla3.yuu26.com/api/bankara-open/now";
-        default:
-            return "";
-        }
+        return BATTLE_TYPE_CATALOG.currentScheduleUrls[static_cast<size_t>(type)];
     }
 
     const char *BattleType::getNextScheduleUrl() const
     {
-        switch (type)
-        {
-        case Type::REGULAR:
-            return "https://spla3.yuu26.com/api/regular/next";
-        case Type::X_MATCH:
-            return "https://spla3.yuu26.com/api/x/next";
-        case Type::BANKARA_CHALLENGE:
-            return "https://spla3.yuu26.com/api/bankara-challenge/next";
-        case Type::BANKARA_OPEN:
-            return "https://spla3.yuu26.com/api/bankara-open/next";
-        default:
-            return "";
-        }
+        return BATTLE_TYPE_CATALOG.nextScheduleUrls[static_cast<size_t>(type)];
+    }
+
+    const char *BattleType::getApiKey() const
+    {
+        return BATTLE_TYPE_CATALOG.apiKeys[static_cast<size_t>(type)];
     }
 
 } // namespace Domain
\ No newline at end of file
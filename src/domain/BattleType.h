@@ -4,7 +4,8 @@
 #ifndef BATTLE_TYPE_H
 #define BATTLE_TYPE_H
 
-#include <Arduino.h>
+#include <stddef.h>
+#include <stdint.h>
 
 namespace Domain
 {
@@ -21,6 +22,9 @@ namespace Domain
             BANKARA_OPEN
         };
 
+        // Number of battle types (Type values are contiguous from 0)
+        static constexpr size_t TYPE_COUNT = static_cast<size_t>(Type::BANKARA_OPEN) + 1;
+
         // デフォルトコンストラクタ - REGULARタイプで初期化
         BattleType() : type(Type::REGULAR) {}
 
@@ -30,6 +34,9 @@ namespace Domain
         static BattleType bankaraChallenge() { return BattleType(Type::BANKARA_CHALLENGE); }
         static BattleType bankaraOpen() { return BattleType(Type::BANKARA_OPEN); }
 
+        // Factory method from a stored type (used by packed schedules)
+        static BattleType fromType(Type type) { return BattleType(type); }
+
         // Value getters
         Type getType() const { return type; }
 
@@ -49,6 +56,9 @@ namespace Domain
         // Return API URL for next schedule
         const char *getNextScheduleUrl() const;
 
+        // Return key of this battle type in the bulk schedule API response
+        const char *getApiKey() const;
+
         // Equality operators
         bool operator==(const BattleType &other) const
         {
@@ -0,0 +1,30 @@
+// Catalog.h
+// Helpers for the constexpr name/color catalogs of the domain value objects
+
+#ifndef CATALOG_H
+#define CATALOG_H
+
+#include <stddef.h>
+
+// 実機ではカタログをフラッシュに置く。ホスト向けのビルドでは通常の定数データになる
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+
+namespace Domain
+{
+
+    // Checks at compile time that every entry of a string column is set
+    // 集成体初期化で足りない要素はnullptrになるため、文字列の追加漏れを検出できる
+    // 色などの数値の列は0（TFT_BLACK）も正しい値のため、ここでは確認しない（ネイティブのテストで確認する）
+    constexpr bool isCatalogComplete(const char *const *values, size_t count)
+    {
+        return count == 0 || (values[count - 1] != nullptr && isCatalogComplete(values, count - 1));
+    }
+
+} // namespace Domain
+
+#endif // CATALOG_H
@@ -0,0 +1,195 @@
+// NameHash.h
+// Compile-time perfect hash used to look up domain values by their Japanese names
+
+#ifndef NAME_HASH_H
+#define NAME_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace Domain
+{
+
+    // FNV-1a (32bit) over the UTF-8 bytes of a name
+    constexpr uint32_t hashName(const char *name, uint32_t hash = 2166136261u)
+    {
+        return *name == '\0'
+                   ? hash
+                   : hashName(name + 1, (hash ^ static_cast<uint8_t>(*name)) * 16777619u);
+    }
+
+    namespace NameHashDetail
+    {
+        // 表の大きさのビット数：要素数の2倍以上、かつ要素数の2乗の1/8以上
+        // 後者で、衝突しないseedが見つかるまでの試行回数の期待値を要素数によらずe^4程度に抑える
+        constexpr unsigned tableBits(size_t count, unsigned bits = 1)
+        {
+            return ((size_t)1 << bits) >= 2 * count && ((size_t)1 << bits) * 8 >= count * count
+                       ? bits
+                       : tableBits(count, bits + 1);
+        }
+
+        // seedで混ぜたハッシュの上位bitsビットを表の位置にする
+        constexpr size_t slotOf(uint32_t hash, uint32_t seed, unsigned bits)
+        {
+            return (uint32_t)((hash ^ seed) * 2654435761u) >> (32 - bits);
+        }
+    }
+
+    // Collision-free table from the hashes of a catalog's name column to the column index.
+    // Built at compile time by searching a seed that puts every name in its own slot, so a
+    // lookup is one indexed probe; the caller confirms the candidate with one strcmp.
+    // 名前はカタログの列から直接ハッシュするため、種類を追加しても別の表を書き足す必要はない
+    template <size_t N>
+    struct NameHashTable
+    {
+        static_assert(N < 255, "Name hash table stores indices in uint8_t");
+
+        static constexpr unsigned BITS = NameHashDetail::tableBits(N);
+        static constexpr size_t SIZE = (size_t)1 << BITS;
+
+        uint32_t seed;
+        uint8_t indices[SIZE]; // 位置ごとの要素の添字（空きはN）
+
+        // ハッシュが入りうる唯一の位置の要素の添字（空きの場合はN）
+        constexpr size_t find(uint32_t hash) const
+        {
+            return indices[NameHashDetail::slotOf(hash, seed, BITS)];
+        }
+    };
+
+    namespace NameHashDetail
+    {
+        // C++11にはstd::index_sequenceがないため、添字の列を自前で作る
+        // 大きな表でもテンプレートの再帰が深くならないよう、半分ずつ作ってつなげる
+        template <size_t... I>
+        struct IndexSequence
+        {
+        };
+
+        template <typename First, typename Second>
+        struct ConcatIndexSequence;
+
+        template <size_t... I, size_t... J>
+        struct ConcatIndexSequence<IndexSequence<I...>, IndexSequence<J...>>
+        {
+            typedef IndexSequence<I..., (sizeof...(I) + J)...> type;
+        };
+
+        template <size_t N>
+        struct MakeIndexSequence
+            : ConcatIndexSequence<typename MakeIndexSequence<N / 2>::type, typename MakeIndexSequence<N - N / 2>::type>
+        {
+        };
+
+        template <>
+        struct MakeIndexSequence<0>
+        {
+            typedef IndexSequence<> type;
+        };
+
+        template <>
+        struct MakeIndexSequence<1>
+        {
+            typedef IndexSequence<0> type;
+        };
+
+        // Hashes of a name column, in the same order as the column
+        template <size_t N>
+        struct NameHashes
+        {
+            uint32_t values[N];
+        };
+
+        template <size_t N, size_t... I>
+        constexpr NameHashes<N> hashNames(const char *const (&names)[N], IndexSequence<I...>)
+        {
+            return NameHashes<N>{{hashName(names[I])...}};
+        }
+
+        // index番目の要素の位置が、それより前のcount個の要素と重ならないか
+        constexpr bool slotDiffersFromEarlier(const uint32_t *hashes, size_t index, size_t count,
+                                              uint32_t seed, unsigned bits)
+        {
+            return count == 0 ||
+                   (slotOf(hashes[index], seed, bits) != slotOf(hashes[count - 1], seed, bits) &&
+                    slotDiffersFromEarlier(hashes, index, count - 1, seed, bits));
+        }
+
+        // 先頭count個の要素がすべて別の位置に入るか
+        constexpr bool isCollisionFree(const uint32_t *hashes, size_t count, uint32_t seed, unsigned bits)
+        {
+            return count == 0 ||
+                   (slotDiffersFromEarlier(hashes, count - 1, count - 1, seed, bits) &&
+                    isCollisionFree(hashes, count - 1, seed, bits));
+        }
+
+        constexpr uint32_t NO_SEED = 0xFFFFFFFFu;
+        constexpr uint32_t SEED_SEARCH_LIMIT = 1u << 16;
+
+        constexpr uint32_t findSeed(const uint32_t *hashes, size_t count, unsigned bits, uint32_t first, uint32_t last);
+
+        constexpr uint32_t findSeedAfter(uint32_t found, const uint32_t *hashes, size_t count, unsigned bits,
+                                         uint32_t first, uint32_t last)
+        {
+            return found != NO_SEED ? found : findSeed(hashes, count, bits, first, last);
+        }
+
+        // [first, last)から衝突しない最初のseedを探す（constexprの再帰が深くならないよう範囲を半分ずつ調べる）
+        constexpr uint32_t findSeed(const uint32_t *hashes, size_t count, unsigned bits, uint32_t first, uint32_t last)
+        {
+            return last - first == 1
+                       ? (isCollisionFree(hashes, count, first, bits) ? first : NO_SEED)
+                       : findSeedAfter(findSeed(hashes, count, bits, first, first + (last - first) / 2),
+                                       hashes, count, bits, first + (last - first) / 2, last);
+        }
+
+        // 表の位置slotに入る要素の添字（なければcount）
+        constexpr size_t indexAtSlot(const uint32_t *hashes, size_t count, uint32_t seed, unsigned bits,
+                                     size_t slot, size_t index = 0)
+        {
+            return index == count
+                       ? count
+                       : (slotOf(hashes[index], seed, bits) == slot
+                              ? index
+                              : indexAtSlot(hashes, count, seed, bits, slot, index + 1));
+        }
+
+        template <size_t N, size_t... Slot>
+        constexpr NameHashTable<N> makeTable(const uint32_t *hashes, uint32_t seed, IndexSequence<Slot...>)
+        {
+            return NameHashTable<N>{
+                seed,
+                {static_cast<uint8_t>(indexAtSlot(hashes, N, seed, NameHashTable<N>::BITS, Slot))...}};
+        }
+
+        template <size_t N>
+        constexpr NameHashTable<N> makeTableFromHashes(const NameHashes<N> &hashes)
+        {
+            return makeTable<N>(
+                hashes.values,
+                findSeed(hashes.values, N, NameHashTable<N>::BITS, 0, SEED_SEARCH_LIMIT),
+                typename MakeIndexSequence<NameHashTable<N>::SIZE>::type());
+        }
+    }
+
+    // Builds the perfect hash table of a catalog column at compile time
+    template <size_t N>
+    constexpr NameHashTable<N> makeNameHashTable(const char *const (&names)[N])
+    {
+        return NameHashDetail::makeTableFromHashes<N>(
+            NameHashDetail::hashNames(names, typename NameHashDetail::MakeIndexSequence<N>::type()));
+    }
+
+    // Checks at compile time that every name of the column finds its own index
+    // seedが見つからなかった場合や、ハッシュ自体が衝突する場合はstatic_assertで検出する
+    template <size_t N>
+    constexpr bool findsEveryName(const NameHashTable<N> &table, const char *const (&names)[N], size_t count = N)
+    {
+        return count == 0 ||
+               (table.find(hashName(names[count - 1])) == count - 1 && findsEveryName(table, names, count - 1));
+    }
+
+} // namespace Domain
+
+#endif // NAME_HASH_H
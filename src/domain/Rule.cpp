@@ -1,111 +1,114 @@
 #include "Rule.h"
+#include "Catalog.h"
+#include "NameHash.h"
 #include <string.h>
 
 namespace Domain
 {
 
-    Rule Rule::fromJapaneseName(const char *japaneseName)
+    namespace
     {
-        if (strcmp(japaneseName, "ナワバリバトル") == 0)
-        {
-            return turfWar();
-        }
-        else if (strcmp(japaneseName, "ガチエリア") == 0)
-        {
-            return splatZones();
-        }
-        else if (strcmp(japaneseName, "ガチヤグラ") == 0)
-        {
-            return towerControl();
-        }
-        else if (strcmp(japaneseName, "ガチホコバトル") == 0)
-        {
-            return rainmaker();
-        }
-        else if (strcmp(japaneseName, "ガチアサリ") == 0)
+        // Rule::Typeの数
+        constexpr size_t RULE_COUNT = static_cast<size_t>(Rule::Type::UNKNOWN) + 1;
+
+        // ルールの名前などを項目ごとの配列にまとめたカタログ（各配列はRule::Typeの順）
+        struct RuleCatalog
         {
-            return clamBlitz();
-        }
-        else
+            const char *japaneseNames[RULE_COUNT];
+            const char *englishNames[RULE_COUNT];
+            const char *romajiNames[RULE_COUNT];
+            const char *symbols[RULE_COUNT];
+            uint16_t symbolColors[RULE_COUNT];
+        };
+
+        constexpr RuleCatalog RULE_CATALOG PROGMEM = {
+            // japaneseNames
+            {
+                "ナワバリバトル", // TURF_WAR
+                "ガチエリア", // SPLAT_ZONES
+                "ガチヤグラ", // TOWER_CONTROL
+                "ガチホコバトル", // RAINMAKER
+                "ガチアサリ", // CLAM_BLITZ
+                "不明", // UNKNOWN
+            },
+            // englishNames
+            {
+                "Turf War", // TURF_WAR
+                "Splat Zones", // SPLAT_ZONES
+                "Tower Control", // TOWER_CONTROL
+                "Rainmaker", // RAINMAKER
+                "Clam Blitz", // CLAM_BLITZ
+                "Unknown", // UNKNOWN
+            },
+            // romajiNames
+            {
+                "Nawabari", // TURF_WAR
+                "Area", // SPLAT_ZONES
+                "Yagura", // TOWER_CONTROL
+                "Hoko", // RAINMAKER
+                "Asari", // CLAM_BLITZ
+                "Unknown", // UNKNOWN
+            },
+            // symbols
+            {
+                "", // TURF_WAR
+                "[-] ", // SPLAT_ZONES
+                "|^| ", // TOWER_CONTROL
+                "{*} ", // RAINMAKER
+                "(+) ", // CLAM_BLITZ
+                "", // UNKNOWN
+            },
+            // symbolColors
+            {
+                0xFFFF, // TURF_WAR: White
+                0x07E0, // SPLAT_ZONES: Green
+                0x15BD, // TOWER_CONTROL: Blue
+                0xFE60, // RAINMAKER: Gold/Yellow
+                0xF980, // CLAM_BLITZ: Red-Orange
+                0xFFFF, // UNKNOWN: White
+            }
+        };
+
+        // すべての種類に値が設定されていることをコンパイル時に確認する
+        static_assert(isCatalogComplete(RULE_CATALOG.japaneseNames, RULE_COUNT), "Rule catalog is missing a Japanese name");
+        static_assert(isCatalogComplete(RULE_CATALOG.englishNames, RULE_COUNT), "Rule catalog is missing an English name");
+        static_assert(isCatalogComplete(RULE_CATALOG.romajiNames, RULE_COUNT), "Rule catalog is missing a romaji name");
+        static_assert(isCatalogComplete(RULE_CATALOG.symbols, RULE_COUNT), "Rule catalog is missing a symbol");
+
+        // 日本語名の列から作った衝突のないハッシュ表
+        constexpr NameHashTable<RULE_COUNT> RULE_NAME_HASHES = makeNameHashTable(RULE_CATALOG.japaneseNames);
+        static_assert(findsEveryName(RULE_NAME_HASHES, RULE_CATALOG.japaneseNames), "Rule names collide in the name hash table");
+    }
+
+    Rule Rule::fromJapaneseName(const char *japaneseName)
+    {
+        // 名前のハッシュで候補を1つに絞り、確認のための文字列比較は1回だけ行う
+        size_t index = RULE_NAME_HASHES.find(hashName(japaneseName));
+        if (index == RULE_COUNT || strcmp(japaneseName, RULE_CATALOG.japaneseNames[index]) != 0)
         {
             return unknown();
         }
+        return Rule(static_cast<Type>(index));
     }
 
     const char *Rule::getJapaneseName() const
     {
-        switch (type)
-        {
-        case Type::TURF_WAR:
-            return "ナワバリバトル";
-        case Type::SPLAT_ZONES:
-            return "ガチエリア";
-        case Type::TOWER_CONTROL:
-            return "ガチヤグラ";
-        case Type::RAINMAKER:
-            return "ガチホコバトル";
-        case Type::CLAM_BLITZ:
-            return "ガチアサリ";
-        default:
-            return "不明";
-        }
+        return RULE_CATALOG.japaneseNames[static_cast<size_t>(type)];
     }
 
     const char *Rule::getEnglishName() const
     {
-        switch (type)
-        {
-        case Type::TURF_WAR:
-            return "Turf War";
-        case Type::SPLAT_ZONES:
-            return "Splat Zones";
-        case Type::TOWER_CONTROL:
-            return "Tower Control";
-        case Type::RAINMAKER:
-            return "Rainmaker";
-        case Type::CLAM_BLITZ:
-            return "Clam Blitz";
-        default:
-            return "Unknown";
-        }
+        return RULE_CATALOG.englishNames[static_cast<size_t>(type)];
     }
 
     const char *Rule::getRomajiName() const
     {
-        switch (type)
-        {
-        case Type::TURF_WAR:
-            return "Nawabari";
-        case Type::SPLAT_ZONES:
-            return "Area";
-        case Type::TOWER_CONTROL:
-            return "Yagura";
-        case Type::RAINMAKER:
-            return "Hoko";
-        case Type::CLAM_BLITZ:
-            return "Asari";
-        default:
-            return "Unknown";
-        }
+        return RULE_CATALOG.romajiNames[static_cast<size_t>(type)];
     }
 
     const char *Rule::getSymbol() const
     {
-        switch (type)
-        {
-        case Type::TURF_WAR:
-            return "";
-        case Type::SPLAT_ZONES:
-            return "[-] ";
-        case Type::TOWER_CONTROL:
-            return "|^| ";
-        case Type::RAINMAKER:
-            return "{*} ";
-        case Type::CLAM_BLITZ:
-            return "(+) ";
-        default:
-            return "";
-        }
+        return RULE_CATALOG.symbols[static_cast<size_t>(type)];
     }
 
     const char *Rule::getDisplayName(bool useRomaji) const
@@ -115,19 +118,7 @@ namespace Domain
 
     uint16_t Rule::getSymbolColor() const
     {
-        switch (type)
-        {
-        case Type::SPLAT_ZONES:
-            return 0x07E0; // Green
-        case Type::TOWER_CONTROL:
-            return 0x15BD; // Blue
-        case Type::RAINMAKER:
-            return 0xFE60; // Gold/Yellow
-        case Type::CLAM_BLITZ:
-            return 0xF980; // Red-Orange
-        default:
-            return 0xFFFF; // White
-        }
+        return RULE_CATALOG.symbolColors[static_cast<size_t>(type)];
     }
 
 } // namespace Domain
\ No newline at end of file
@@ -4,7 +4,7 @@
 #ifndef RULE_H
 #define RULE_H
 
-#include <Arduino.h>
+#include <stdint.h>
 
 namespace Domain
 {
@@ -37,6 +37,9 @@ namespace Domain
         // Factory method from Japanese name
         static Rule fromJapaneseName(const char *japaneseName);
 
+        // Factory method from a stored type (used by packed schedules)
+        static Rule fromType(Type type) { return Rule(type); }
+
         // Value getters
         Type getType() const { return type; }
 
@@ -0,0 +1,142 @@
+// ScheduleSnapshot.h
+// ScheduleSnapshot domain model - the schedules shown on screen, read in one batch
+
+#ifndef SCHEDULE_SNAPSHOT_H
+#define SCHEDULE_SNAPSHOT_H
+
+#include <stddef.h>
+#include <time.h>
+#include "BattleSchedule.h"
+#include "BattleType.h"
+
+namespace Domain
+{
+
+    // ScheduleSnapshot - the current and upcoming slots of every battle type
+    // 連続した配列にBattleType::Typeとスロット位置（0が現在）で添字付けして保持する
+    class ScheduleSnapshot
+    {
+    public:
+        // Number of slots held per battle type (current and next)
+        static constexpr size_t SLOT_COUNT = 2;
+
+        // サーバーで確認できない状態がこの時間続いたバトルタイプは、スロットを表示したまま古いことを示す
+        // 通常はスロット境界ごと（最長2時間）に確認するため、1回分の更新とその再試行を取りこぼすまでは示さない
+        static constexpr unsigned long STALE_AFTER_MILLIS = 3UL * 60 * 60 * 1000;
+
+        // Creates a snapshot where every slot is empty
+        ScheduleSnapshot()
+        {
+            for (size_t type = 0; type < BattleType::TYPE_COUNT; type++)
+            {
+                stale[type] = false;
+                confirmed[type] = false;
+                confirmedMillis[type] = 0;
+                for (size_t slot = 0; slot < SLOT_COUNT; slot++)
+                {
+                    schedules[type][slot] = BattleSchedule::createEmpty(
+                        BattleType::fromType(static_cast<BattleType::Type>(type)));
+                }
+            }
+        }
+
+        // Get the schedule at the given slot (0 = current) of a battle type
+        const BattleSchedule &get(BattleType::Type type, size_t slot) const
+        {
+            return schedules[static_cast<size_t>(type)][slot];
+        }
+
+        const BattleSchedule &getCurrent(BattleType::Type type) const { return get(type, 0); }
+        const BattleSchedule &getNext(BattleType::Type type) const { return get(type, 1); }
+
+        // Replace the schedule at the given slot of a battle type
+        void set(BattleType::Type type, size_t slot, const BattleSchedule &schedule)
+        {
+            schedules[static_cast<size_t>(type)][slot] = schedule;
+        }
+
+        // Whether the slots of a battle type are served from the cache because they
+        // could not be revalidated for a while
+        bool isStale(BattleType::Type type) const { return stale[static_cast<size_t>(type)]; }
+
+        // Record when the slots of a battle type were last confirmed by the server (millis())
+        void setConfirmation(BattleType::Type type, bool isConfirmed, unsigned long lastConfirmedMillis)
+        {
+            confirmed[static_cast<size_t>(type)] = isConfirmed;
+            confirmedMillis[static_cast<size_t>(type)] = lastConfirmedMillis;
+        }
+
+        // 確認できていない、または最後に確認してからSTALE_AFTER_MILLIS以上経ったかどうか
+        static bool isConfirmationStale(bool isConfirmed, unsigned long lastConfirmedMillis, unsigned long nowMillis)
+        {
+            return !isConfirmed || nowMillis - lastConfirmedMillis >= STALE_AFTER_MILLIS;
+        }
+
+        // 現在の時刻で古いかどうかを判定し直す（取得が止まっていても時間の経過で古くなる）
+        // いずれかのバトルタイプの表示が変わった場合はtrueを返す
+        bool updateStaleness(unsigned long nowMillis)
+        {
+            bool changed = false;
+            for (size_t type = 0; type < BattleType::TYPE_COUNT; type++)
+            {
+                // 表示するスロットがないバトルタイプは古いことを示さない
+                bool staleNow = schedules[type][0].isValid() &&
+                                isConfirmationStale(confirmed[type], confirmedMillis[type], nowMillis);
+                if (stale[type] != staleNow)
+                {
+                    stale[type] = staleNow;
+                    changed = true;
+                }
+            }
+            return changed;
+        }
+
+        // 古いかどうかの表示がすべてのバトルタイプで同じかどうか
+        bool hasSameStaleness(const ScheduleSnapshot &other) const
+        {
+            for (size_t type = 0; type < BattleType::TYPE_COUNT; type++)
+            {
+                if (stale[type] != other.stale[type])
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // 現在のスロットのうち最も早く終わるものまでの秒数
+        // 有効なスロットがない、または既に終わったスロットがある場合は0以下を返す
+        long getSecondsUntilNextSlotChange(time_t now) const
+        {
+            long earliest = 0;
+            bool found = false;
+
+            for (size_t type = 0; type < BattleType::TYPE_COUNT; type++)
+            {
+                const BattleSchedule &schedule = schedules[type][0];
+                if (!schedule.isValid())
+                {
+                    continue;
+                }
+
+                long seconds = schedule.getSecondsUntilEnd(now);
+                if (!found || seconds < earliest)
+                {
+                    earliest = seconds;
+                    found = true;
+                }
+            }
+
+            return earliest;
+        }
+
+    private:
+        BattleSchedule schedules[BattleType::TYPE_COUNT][SLOT_COUNT];
+        bool stale[BattleType::TYPE_COUNT];
+        bool confirmed[BattleType::TYPE_COUNT];
+        unsigned long confirmedMillis[BattleType::TYPE_COUNT];
+    };
+
+} // namespace Domain
+
+#endif // SCHEDULE_SNAPSHOT_H
@@ -1,292 +1,148 @@
 #include "Stage.h"
+#include "Catalog.h"
+#include "NameHash.h"
 #include <string.h>
 
 namespace Domain
 {
 
-    Stage Stage::fromJapaneseName(const char *japaneseName)
+    namespace
     {
-        if (strcmp(japaneseName, "ユノハナ大渓谷") == 0)
-        {
-            return Stage(Type::SCORCH_GORGE);
-        }
-        else if (strcmp(japaneseName, "ゴンズイ地区") == 0)
-        {
-            return Stage(Type::EELTAIL_ALLEY);
-        }
-        else if (strcmp(japaneseName, "ヤガラ市場") == 0)
-        {
-            return Stage(Type::HAGGLEFISH_MARKET);
-        }
-        else if (strcmp(japaneseName, "マテガイ放水路") == 0)
-        {
-            return Stage(Type::UNDERTOW_SPILLWAY);
-        }
-        else if (strcmp(japaneseName, "ナンプラー遺跡") == 0)
-        {
-            return Stage(Type::UMAMI_RUINS);
-        }
-        else if (strcmp(japaneseName, "ナメロウ金属") == 0)
-        {
-            return Stage(Type::MINCEMEAT_METALWORKS);
-        }
-        else if (strcmp(japaneseName, "クサヤ温泉") == 0)
-        {
-            return Stage(Type::BRINEWATER_SPRINGS);
-        }
-        else if (strcmp(japaneseName, "タラポートショッピングパーク") == 0)
-        {
-            return Stage(Type::BARNACLE_AND_DIME);
-        }
-        else if (strcmp(japaneseName, "ヒラメが丘団地") == 0)
-        {
-            return Stage(Type::FLOUNDER_HEIGHTS);
-        }
-        else if (strcmp(japaneseName, "マサバ海峡大橋") == 0)
-        {
-            return Stage(Type::HAMMERHEAD_BRIDGE);
-        }
-        else if (strcmp(japaneseName, "キンメダイ美術館") == 0)
-        {
-            return Stage(Type::MUSEUM_DALFONSINO);
-        }
-        else if (strcmp(japaneseName, "マヒマヒリゾート＆スパ") == 0)
-        {
-            return Stage(Type::MAHI_MAHI_RESORT);
-        }
-        else if (strcmp(japaneseName, "海女美術大学") == 0)
-        {
-            return Stage(Type::INKBLOT_ART_ACADEMY);
-        }
-        else if (strcmp(japaneseName, "チョウザメ造船") == 0)
-        {
-            return Stage(Type::STURGEON_SHIPYARD);
-        }
-        else if (strcmp(japaneseName, "ザトウマーケット") == 0)
-        {
-            return Stage(Type::MAKO_MART);
-        }
-        else if (strcmp(japaneseName, "スメーシーワールド") == 0)
-        {
-            return Stage(Type::WAHOO_WORLD);
-        }
-        else if (strcmp(japaneseName, "コンブトラック") == 0)
-        {
-            return Stage(Type::HUMPBACK_PUMP_TRACK);
-        }
-        else if (strcmp(japaneseName, "マンタマリア号") == 0)
-        {
-            return Stage(Type::MANTA_MARIA);
-        }
-        else if (strcmp(japaneseName, "タカアシ経済特区") == 0)
-        {
-            return Stage(Type::CRABLEG_CAPITAL);
-        }
-        else if (strcmp(japaneseName, "オヒョウ海運") == 0)
-        {
-            return Stage(Type::SHIPSHAPE_CARGO_CO);
-        }
-        else if (strcmp(japaneseName, "バイガイ亭") == 0)
-        {
-            return Stage(Type::BAYSIDE_BOWL);
-        }
-        else if (strcmp(japaneseName, "ネギトロ炭鉱") == 0)
-        {
-            return Stage(Type::BLUEFIN_DEPOT);
-        }
-        else if (strcmp(japaneseName, "カジキ空港") == 0)
-        {
-            return Stage(Type::MARLIN_AIRPORT);
-        }
-        else if (strcmp(japaneseName, "リュウグウターミナル") == 0)
-        {
-            return Stage(Type::DRAGON_PALACE_TERMINAL);
-        }
-        else if (strcmp(japaneseName, "デカライン高架下") == 0)
+        // Stage::Typeの数
+        constexpr size_t STAGE_COUNT = static_cast<size_t>(Stage::Type::UNKNOWN) + 1;
+
+        // ステージの名前などを項目ごとの配列にまとめたカタログ（各配列はStage::Typeの順）
+        struct StageCatalog
         {
-            return Stage(Type::URCHIN_UNDERPASS);
-        }
-        else
+            const char *japaneseNames[STAGE_COUNT];
+            const char *englishNames[STAGE_COUNT];
+            const char *romajiNames[STAGE_COUNT];
+        };
+
+        constexpr StageCatalog STAGE_CATALOG PROGMEM = {
+            // japaneseNames
+            {
+                "ユノハナ大渓谷", // SCORCH_GORGE
+                "ゴンズイ地区", // EELTAIL_ALLEY
+                "ヤガラ市場", // HAGGLEFISH_MARKET
+                "マテガイ放水路", // UNDERTOW_SPILLWAY
+                "ナンプラー遺跡", // UMAMI_RUINS
+                "ナメロウ金属", // MINCEMEAT_METALWORKS
+                "クサヤ温泉", // BRINEWATER_SPRINGS
+                "タラポートショッピングパーク", // BARNACLE_AND_DIME
+                "ヒラメが丘団地", // FLOUNDER_HEIGHTS
+                "マサバ海峡大橋", // HAMMERHEAD_BRIDGE
+                "キンメダイ美術館", // MUSEUM_DALFONSINO
+                "マヒマヒリゾート＆スパ", // MAHI_MAHI_RESORT
+                "海女美術大学", // INKBLOT_ART_ACADEMY
+                "チョウザメ造船", // STURGEON_SHIPYARD
+                "ザトウマーケット", // MAKO_MART
+                "スメーシーワールド", // WAHOO_WORLD
+                "コンブトラック", // HUMPBACK_PUMP_TRACK
+                "マンタマリア号", // MANTA_MARIA
+                "タカアシ経済特区", // CRABLEG_CAPITAL
+                "オヒョウ海運", // SHIPSHAPE_CARGO_CO
+                "バイガイ亭", // BAYSIDE_BOWL
+                "ネギトロ炭鉱", // BLUEFIN_DEPOT
+                "カジキ空港", // MARLIN_AIRPORT
+                "リュウグウターミナル", // DRAGON_PALACE_TERMINAL
+                "デカライン高架下", // URCHIN_UNDERPASS
+                "不明", // UNKNOWN
+            },
+            // englishNames
+            {
+                "Scorch Gorge", // SCORCH_GORGE
+                "Eeltail Alley", // EELTAIL_ALLEY
+                "Hagglefish Market", // HAGGLEFISH_MARKET
+                "Undertow Spillway", // UNDERTOW_SPILLWAY
+                "Um'ami Ruins", // UMAMI_RUINS
+                "Mincemeat Metalworks", // MINCEMEAT_METALWORKS
+                "Brinewater Springs", // BRINEWATER_SPRINGS
+                "Barnacle & Dime", // BARNACLE_AND_DIME
+                "Flounder Heights", // FLOUNDER_HEIGHTS
+                "Hammerhead Bridge", // HAMMERHEAD_BRIDGE
+                "Museum d'Alfonsino", // MUSEUM_DALFONSINO
+                "Mahi-Mahi Resort", // MAHI_MAHI_RESORT
+                "Inkblot Art Academy", // INKBLOT_ART_ACADEMY
+                "Sturgeon Shipyard", // STURGEON_SHIPYARD
+                "Mako Mart", // MAKO_MART
+                "Wahoo World", // WAHOO_WORLD
+                "Humpback Pump Track", // HUMPBACK_PUMP_TRACK
+                "Manta Maria", // MANTA_MARIA
+                "Crableg Capital", // CRABLEG_CAPITAL
+                "Shipshape Cargo Co.", // SHIPSHAPE_CARGO_CO
+                "Bayside Bowl", // BAYSIDE_BOWL
+                "Bluefin Depot", // BLUEFIN_DEPOT
+                "Marlin Airport", // MARLIN_AIRPORT
+                "Dragon Palace Terminal", // DRAGON_PALACE_TERMINAL
+                "Urchin Underpass", // URCHIN_UNDERPASS
+                "Unknown", // UNKNOWN
+            },
+            // romajiNames
+            {
+                "Yunohana", // SCORCH_GORGE
+                "Gonzui", // EELTAIL_ALLEY
+                "Yagara", // HAGGLEFISH_MARKET
+                "Mategai", // UNDERTOW_SPILLWAY
+                "Nampla", // UMAMI_RUINS
+                "Namero", // MINCEMEAT_METALWORKS
+                "Kusaya", // BRINEWATER_SPRINGS
+                "Taraport", // BARNACLE_AND_DIME
+                "Hirame", // FLOUNDER_HEIGHTS
+                "Masaba", // HAMMERHEAD_BRIDGE
+                "Kinmedai", // MUSEUM_DALFONSINO
+                "Mahimahi", // MAHI_MAHI_RESORT
+                "Amabi", // INKBLOT_ART_ACADEMY
+                "Chouzame", // STURGEON_SHIPYARD
+                "Zatou", // MAKO_MART
+                "Sume-shi", // WAHOO_WORLD
+                "Kombu", // HUMPBACK_PUMP_TRACK
+                "Mantamaria", // MANTA_MARIA
+                "Takaashi", // CRABLEG_CAPITAL
+                "Ohyou", // SHIPSHAPE_CARGO_CO
+                "Baigai", // BAYSIDE_BOWL
+                "Negitoro", // BLUEFIN_DEPOT
+                "Kajiki", // MARLIN_AIRPORT
+                "Ryuuguu", // DRAGON_PALACE_TERMINAL
+                "Dekaline", // URCHIN_UNDERPASS
+                "Unknown", // UNKNOWN
+            }
+        };
+
+        // すべての種類に値が設定されていることをコンパイル時に確認する
+        static_assert(isCatalogComplete(STAGE_CATALOG.japaneseNames, STAGE_COUNT), "Stage catalog is missing a Japanese name");
+        static_assert(isCatalogComplete(STAGE_CATALOG.englishNames, STAGE_COUNT), "Stage catalog is missing an English name");
+        static_assert(isCatalogComplete(STAGE_CATALOG.romajiNames, STAGE_COUNT), "Stage catalog is missing a romaji name");
+
+        // 日本語名の列から作った衝突のないハッシュ表
+        constexpr NameHashTable<STAGE_COUNT> STAGE_NAME_HASHES = makeNameHashTable(STAGE_CATALOG.japaneseNames);
+        static_assert(findsEveryName(STAGE_NAME_HASHES, STAGE_CATALOG.japaneseNames), "Stage names collide in the name hash table");
+    }
+
+    Stage Stage::fromJapaneseName(const char *japaneseName)
+    {
+        // 名前のハッシュで候補を1つに絞り、確認のための文字列比較は1回だけ行う
+        size_t index = STAGE_NAME_HASHES.find(hashName(japaneseName));
+        if (index == STAGE_COUNT || strcmp(japaneseName, STAGE_CATALOG.japaneseNames[index]) != 0)
         {
             return Stage(Type::UNKNOWN);
         }
+        return Stage(static_cast<Type>(index));
     }
 
     const char *Stage::getJapaneseName() const
     {
-        switch (type)
-        {
-        case Type::SCORCH_GORGE:
-            return "ユノハナ大渓谷";
-        case Type::EELTAIL_ALLEY:
-            return "ゴンズイ地区";
-        case Type::HAGGLEFISH_MARKET:
-            return "ヤガラ市場";
-        case Type::UNDERTOW_SPILLWAY:
-            return "マテガイ放水路";
-        case Type::UMAMI_RUINS:
-            return "ナンプラー遺跡";
-        case Type::MINCEMEAT_METALWORKS:
-            return "ナメロウ金属";
-        case Type::BRINEWATER_SPRINGS:
-            return "クサヤ温泉";
-        case Type::BARNACLE_AND_DIME:
-            return "タラポートショッピングパーク";
-        case Type::FLOUNDER_HEIGHTS:
-            return "ヒラメが丘団地";
-        case Type::HAMMERHEAD_BRIDGE:
-            return "マサバ海峡大橋";
-        case Type::MUSEUM_DALFONSINO:
-            return "キンメダイ美術館";
-        case Type::MAHI_MAHI_RESORT:
-            return "マヒマヒリゾート＆スパ";
-        case Type::INKBLOT_ART_ACADEMY:
-            return "海女美術大学";
-        case Type::STURGEON_SHIPYARD:
-            return "チョウザメ造船";
-        case Type::MAKO_MART:
-            return "ザトウマーケット";
-        case Type::WAHOO_WORLD:
-            return "スメーシーワールド";
-        case Type::HUMPBACK_PUMP_TRACK:
-            return "コンブトラック";
-        case Type::MANTA_MARIA:
-            return "マンタマリア号";
-        case Type::CRABLEG_CAPITAL:
-            return "タカアシ経済特区";
-        case Type::SHIPSHAPE_CARGO_CO:
-            return "オヒョウ海運";
-        case Type::BAYSIDE_BOWL:
-            return "バイガイ亭";
-        case Type::BLUEFIN_DEPOT:
-            return "ネギトロ炭鉱";
-        case Type::MARLIN_AIRPORT:
-            return "カジキ空港";
-        case Type::DRAGON_PALACE_TERMINAL:
-            return "リュウグウターミナル";
-        case Type::URCHIN_UNDERPASS:
-            return "デカライン高架下";
-        default:
-            return "不明";
-        }
+        return STAGE_CATALOG.japaneseNames[static_cast<size_t>(type)];
     }
 
     const char *Stage::getEnglishName() const
     {
-        switch (type)
-        {
-        case Type::SCORCH_GORGE:
-            return "Scorch Gorge";
-        case Type::EELTAIL_ALLEY:
-            return "Eeltail Alley";
-        case Type::HAGGLEFISH_MARKET:
-            return "Hagglefish Market";
-        case Type::UNDERTOW_SPILLWAY:
-            return "Undertow Spillway";
-        case Type::UMAMI_RUINS:
-            return "Um'ami Ruins";
-        case Type::MINCEMEAT_METALWORKS:
-            return "Mincemeat Metalworks";
-        case Type::BRINEWATER_SPRINGS:
-            return "Brinewater Springs";
-        case Type::BARNACLE_AND_DIME:
-            return "Barnacle & Dime";
-        case Type::FLOUNDER_HEIGHTS:
-            return "Flounder Heights";
-        case Type::HAMMERHEAD_BRIDGE:
-            return "Hammerhead Bridge";
-        case Type::MUSEUM_DALFONSINO:
-            return "Museum d'Alfonsino";
-        case Type::MAHI_MAHI_RESORT:
-            return "Mahi-Mahi Resort";
-        case Type::INKBLOT_ART_ACADEMY:
-            return "Inkblot Art Academy";
-        case Type::STURGEON_SHIPYARD:
-            return "Sturgeon Shipyard";
-        case Type::MAKO_MART:
-            return "Mako Mart";
-        case Type::WAHOO_WORLD:
-            return "Wahoo World";
-        case Type::HUMPBACK_PUMP_TRACK:
-            return "Humpback Pump Track";
-        case Type::MANTA_MARIA:
-            return "Manta Maria";
-        case Type::CRABLEG_CAPITAL:
-            return "Crableg Capital";
-        case Type::SHIPSHAPE_CARGO_CO:
-            return "Shipshape Cargo Co.";
-        case Type::BAYSIDE_BOWL:
-            return "Bayside Bowl";
-        case Type::BLUEFIN_DEPOT:
-            return "Bluefin Depot";
-        case Type::MARLIN_AIRPORT:
-            return "Marlin Airport";
-        case Type::DRAGON_PALACE_TERMINAL:
-            return "Dragon Palace Terminal";
-        case Type::URCHIN_UNDERPASS:
-            return "Urchin Underpass";
-        default:
-            return "Unknown";
-        }
+        return STAGE_CATALOG.englishNames[static_cast<size_t>(type)];
     }
 
     const char *Stage::getRomajiName() const
     {
-        switch (type)
-        {
-        case Type::SCORCH_GORGE:
-            return "Yunohana";
-        case Type::EELTAIL_ALLEY:
-            return "Gonzui";
-        case Type::HAGGLEFISH_MARKET:
-            return "Yagara";
-        case Type::UNDERTOW_SPILLWAY:
-            return "Mategai";
-        case Type::UMAMI_RUINS:
-            return "Nampla";
-        case Type::MINCEMEAT_METALWORKS:
-            return "Namero";
-        case Type::BRINEWATER_SPRINGS:
-            return "Kusaya";
-        case Type::BARNACLE_AND_DIME:
-            return "Taraport";
-        case Type::FLOUNDER_HEIGHTS:
-            return "Hirame";
-        case Type::HAMMERHEAD_BRIDGE:
-            return "Masaba";
-        case Type::MUSEUM_DALFONSINO:
-            return "Kinmedai";
-        case Type::MAHI_MAHI_RESORT:
-            return "Mahimahi";
-        case Type::INKBLOT_ART_ACADEMY:
-            return "Amabi";
-        case Type::STURGEON_SHIPYARD:
-            return "Chouzame";
-        case Type::MAKO_MART:
-            return "Zatou";
-        case Type::WAHOO_WORLD:
-            return "Sume-shi";
-        case Type::HUMPBACK_PUMP_TRACK:
-            return "Kombu";
-        case Type::MANTA_MARIA:
-            return "Mantamaria";
-        case Type::CRABLEG_CAPITAL:
-            return "Takaashi";
-        case Type::SHIPSHAPE_CARGO_CO:
-            return "Ohyou";
-        case Type::BAYSIDE_BOWL:
-            return "Baigai";
-        case Type::BLUEFIN_DEPOT:
-            return "Negitoro";
-        case Type::MARLIN_AIRPORT:
-            return "Kajiki";
-        case Type::DRAGON_PALACE_TERMINAL:
-            return "Ryuuguu";
-        case Type::URCHIN_UNDERPASS:
-            return "Dekaline";
-        default:
-            return "Unknown";
-        }
+        return STAGE_CATALOG.romajiNames[static_cast<size_t>(type)];
     }
 
     const char *Stage::getDisplayName(bool useRomaji) const
@@ -4,8 +4,6 @@
 #ifndef STAGE_H
 #define STAGE_H
 
-#include <Arduino.h>
-
 namespace Domain
 {
 
@@ -49,6 +47,9 @@ namespace Domain
         // Factory method from Japanese name
         static Stage fromJapaneseName(const char *japaneseName);
 
+        // Factory method from a stored type (used by packed schedules)
+        static Stage fromType(Type type) { return Stage(type); }
+
         // Value getters
         Type getType() const { return type; }
 
@@ -1,173 +1,597 @@
 #include "APIScheduleRepository.h"
+#include "MemoryManager.h"
 
 namespace Infrastructure
 {
 
-    Domain::BattleSchedule APIScheduleRepository::fetchCurrentSchedule(const Domain::BattleType &battleType)
+    void APIScheduleRepository::readSnapshot(Domain::ScheduleSnapshot &snapshot)
     {
-        if (battleType == Domain::BattleType::regular())
-        {
-            return regularSchedule;
-        }
-        else if (battleType == Domain::BattleType::xMatch())
-        {
-            return xMatchSchedule;
-        }
-        else if (battleType == Domain::BattleType::bankaraChallenge())
+        // 前回の取得以降に終わったスロットを読み飛ばす
+        advanceExpiredSlots();
+
+        for (size_t index = 0; index < Domain::BattleType::TYPE_COUNT; index++)
         {
-            return bankaraChallengeSchedule;
+            Domain::BattleType::Type type = static_cast<Domain::BattleType::Type>(index);
+            const ScheduleRingBuffer<SLOT_CAPACITY> &timeline = timelines[index];
+
+            // 確認できていないスロットもそのまま渡し、古いかどうかは表示側で時間の経過に合わせて示す
+            snapshot.setConfirmation(type, validated[index], validatedMillis[index]);
+
+            for (size_t slot = 0; slot < Domain::ScheduleSnapshot::SLOT_COUNT; slot++)
+            {
+                // 保持していないスロットは空のスケジュールにする
+                snapshot.set(type, slot,
+                             slot < timeline.size()
+                                 ? timeline.at(slot)
+                                 : Domain::BattleSchedule::createEmpty(Domain::BattleType::fromType(type)));
+            }
         }
-        else if (battleType == Domain::BattleType::bankaraOpen())
+
+        snapshot.updateStaleness(millis());
+    }
+
+    void APIScheduleRepository::restoreSnapshot(const Domain::ScheduleSnapshot &snapshot)
+    {
+        for (size_t index = 0; index < Domain::BattleType::TYPE_COUNT; index++)
         {
-            return bankaraOpenSchedule;
+            // 取得済みのスロットがあればそちらを優先する
+            ScheduleRingBuffer<SLOT_CAPACITY> &timeline = timelines[index];
+            if (!timeline.empty())
+            {
+                continue;
+            }
+
+            // 現在と次回のスロットを、有効なものだけ前から詰めて戻す（確認済みの印は付けない）
+            Domain::BattleType::Type type = static_cast<Domain::BattleType::Type>(index);
+            for (size_t slot = 0; slot < Domain::ScheduleSnapshot::SLOT_COUNT; slot++)
+            {
+                const Domain::BattleSchedule &schedule = snapshot.get(type, slot);
+                if (!schedule.isValid() || !timeline.push(schedule))
+                {
+                    break;
+                }
+            }
         }
 
-        // Default to an empty schedule
-        return Domain::BattleSchedule::createEmpty(battleType);
+        Serial.println("Schedules restored from the saved snapshot");
     }
 
-    Domain::BattleSchedule APIScheduleRepository::fetchNextSchedule(const Domain::BattleType &battleType)
+    bool APIScheduleRepository::updateAllSchedules()
     {
-        if (battleType == Domain::BattleType::regular())
+        // メモリ使用量をログし、この更新での確保・解放をFETCH段階として集計する
+        MemoryManager::logMemoryUsage("Before updateAllSchedules");
+        MemoryManager::PhaseScope fetchScope(MemoryManager::Phase::FETCH);
+
+        // 今回の更新でのリクエスト数・ハンドシェイク数を数える
+        unsigned long updateStartMillis = millis();
+        networkService.resetConnectionStats();
+        parseMicros = 0;
+        jsonArena.reset();
+        jsonArena.resetStats();
+
+        // 前回の更新以降に終わったスロットを先に読み飛ばし、レスポンスは現在のスロットに合わせて格納する
+        bool updated = advanceExpiredSlots();
+
+        // まとめて取得できた場合（304を含む）は個別リクエストを省略
+        bool bulkFetched = false;
+        if (fetchMode == FetchMode::BULK)
         {
-            return regularNextSchedule;
+            Application::NetworkService::FetchResult result = updateAllSchedulesFromBulk();
+            bulkFetched = result != Application::NetworkService::FetchResult::FAILED;
+            updated |= result == Application::NetworkService::FetchResult::UPDATED;
+
+            if (bulkFetched)
+            {
+                // 304も含め、全バトルタイプのスロットがサーバーで確認できた
+                for (size_t index = 0; index < Domain::BattleType::TYPE_COUNT; index++)
+                {
+                    markValidated(static_cast<Domain::BattleType::Type>(index));
+                }
+            }
+            else
+            {
+                Serial.println("Bulk schedule fetch failed. Falling back to per-endpoint requests");
+            }
         }
-        else if (battleType == Domain::BattleType::xMatch())
+
+        if (!bulkFetched)
         {
-            return xMatchNextSchedule;
+            updated |= updateAllSchedulesFromEndpoints();
         }
-        else if (battleType == Domain::BattleType::bankaraChallenge())
+
+        // 次の更新までTLS接続を保持しないよう解放
+        // 接続の再利用は1回の更新の中だけで、更新ごとに接続1本につき1回ハンドシェイクする
+        // （更新の間隔は数十分あり、その間TLSのバッファ（1本約40KB）を持ち続けるより安い）
+        networkService.closeConnections();
+        logConnectionStats();
+
+        // 解析済みのドキュメントは全て破棄済みなので領域をまとめて解放する
+        jsonArena.reset();
+
+        // 取得中にスロットの終了時刻を過ぎた場合も、保持しているスロットで現在のスロットを進める
+        updated |= advanceExpiredSlots();
+
+        // 確認できなかったバトルタイプは前回までのスロットを使い続ける
+        unsigned long updateMillis = millis() - updateStartMillis;
+        lastUpdateStats.confirmed = true;
+        for (size_t index = 0; index < Domain::BattleType::TYPE_COUNT; index++)
         {
-            return bankaraChallengeNextSchedule;
+            if (validated[index] && validatedMillis[index] - updateStartMillis <= updateMillis)
+            {
+                continue;
+            }
+
+            // 1つでも確認できなければ、今回の更新は失敗として再試行させる
+            lastUpdateStats.confirmed = false;
+            if (timelines[index].empty())
+            {
+                continue;
+            }
+
+            Domain::BattleType::Type type = static_cast<Domain::BattleType::Type>(index);
+            Serial.print("Serving cached ");
+            Serial.print(Domain::BattleType::fromType(type).getEnglishName());
+            Serial.print(" schedules");
+            if (validated[index])
+            {
+                Serial.print(" (last confirmed ");
+                Serial.print((millis() - validatedMillis[index]) / 60000);
+                Serial.print(" min ago)");
+            }
+            Serial.println(isStale(type) ? ", marked stale" : "");
         }
-        else if (battleType == Domain::BattleType::bankaraOpen())
+
+        // メモリ使用量をログ
+        MemoryManager::logMemoryUsage("After updateAllSchedules");
+
+        if (!updated)
         {
-            return bankaraOpenNextSchedule;
+            Serial.println("Schedules not modified");
         }
 
-        // Default to an empty schedule
-        return Domain::BattleSchedule::createEmpty(battleType);
+        return updated;
     }
 
-    void APIScheduleRepository::updateAllSchedules()
+    void APIScheduleRepository::initializeSchedules()
     {
-        // メモリ使用量をログ
-        logMemoryUsage("Before updateAllSchedules");
+        // 各バトルタイプのスロットを空にする
+        for (ScheduleRingBuffer<SLOT_CAPACITY> &timeline : timelines)
+        {
+            timeline.clear();
+        }
 
-        // Update each battle type
-        updateScheduleForBattleType(Domain::BattleType::regular());
-        delay(200);
-        updateScheduleForBattleType(Domain::BattleType::xMatch());
-        delay(200);
-        updateScheduleForBattleType(Domain::BattleType::bankaraChallenge());
-        delay(200);
-        updateScheduleForBattleType(Domain::BattleType::bankaraOpen());
+        Serial.println("All schedules initialized to empty state");
+    }
 
-        // メモリ使用量をログ
-        logMemoryUsage("After updateAllSchedules");
+    void APIScheduleRepository::initializeFilter()
+    {
+        // stages[0]のフィルタは配列の全要素に適用される
+        slotFilter["rule"]["name"] = true;
+        slotFilter["stages"].add<JsonObject>()["name"] = true;
+        slotFilter["start_time"] = true;
+        slotFilter["end_time"] = true;
+
+        // falseのフィルタは値を何も保持せずに読み飛ばす
+        skipFilter.set(false);
     }
 
-    void APIScheduleRepository::initializeSchedules()
+    Application::NetworkService::FetchResult APIScheduleRepository::updateAllSchedulesFromBulk()
     {
-        // 各バトルタイプの空のスケジュールを作成
-        regularSchedule = Domain::BattleSchedule::createEmpty(Domain::BattleType::regular());
-        xMatchSchedule = Domain::BattleSchedule::createEmpty(Domain::BattleType::xMatch());
-        bankaraChallengeSchedule = Domain::BattleSchedule::createEmpty(Domain::BattleType::bankaraChallenge());
-        bankaraOpenSchedule = Domain::BattleSchedule::createEmpty(Domain::BattleType::bankaraOpen());
-
-        // 次のスケジュールも同様に初期化
-        regularNextSchedule = Domain::BattleSchedule::createEmpty(Domain::BattleType::regular());
-        xMatchNextSchedule = Domain::BattleSchedule::createEmpty(Domain::BattleType::xMatch());
-        bankaraChallengeNextSchedule = Domain::BattleSchedule::createEmpty(Domain::BattleType::bankaraChallenge());
-        bankaraOpenNextSchedule = Domain::BattleSchedule::createEmpty(Domain::BattleType::bankaraOpen());
+        Serial.println("Updating all schedules from bulk endpoint...");
 
-        Serial.println("All schedules initialized to empty state");
+        return networkService.httpGetStreamIfModified(
+            BULK_SCHEDULE_URL,
+            bulkValidators,
+            [this](Stream &stream)
+            {
+                unsigned long parseStart = micros();
+                MemoryManager::PhaseScope parseScope(MemoryManager::Phase::PARSE);
+
+                const Domain::BattleType battleTypes[] = {
+                    Domain::BattleType::regular(),
+                    Domain::BattleType::xMatch(),
+                    Domain::BattleType::bankaraChallenge(),
+                    Domain::BattleType::bankaraOpen()};
+                bool received[Domain::BattleType::TYPE_COUNT] = {};
+
+                // {"result":{"regular":[...],...}}をスロット1つずつ解析し、ドキュメント全体は組み立てない
+                // 表示対象のバトルタイプ以外（フェス・イベントなど）は読み捨てる
+                JsonStreamScanner scanner(stream);
+                char key[24];
+                bool parsed = scanner.enterObject();
+                while (parsed && scanner.nextKey(key, sizeof(key)))
+                {
+                    if (strcmp(key, "result") != 0)
+                    {
+                        parsed = skipValue(scanner);
+                        continue;
+                    }
+
+                    parsed = scanner.enterObject();
+                    while (parsed && scanner.nextKey(key, sizeof(key)))
+                    {
+                        const Domain::BattleType *battleType = nullptr;
+                        for (const Domain::BattleType &candidate : battleTypes)
+                        {
+                            if (strcmp(key, candidate.getApiKey()) == 0)
+                            {
+                                battleType = &candidate;
+                                break;
+                            }
+                        }
+
+                        if (battleType == nullptr)
+                        {
+                            parsed = skipValue(scanner);
+                            continue;
+                        }
+
+                        size_t index = static_cast<size_t>(battleType->getType());
+                        parsed = parseSlotArray(scanner, *battleType, pendingSlots[index]);
+                        received[index] = parsed;
+                    }
+                }
+                parseMicros += micros() - parseStart;
+
+                if (!parsed || scanner.hasFailed())
+                {
+                    Serial.println("Bulk schedule response is malformed or cut off");
+                    return false;
+                }
+
+                // 全バトルタイプが揃っていることを確認してから格納する
+                for (const Domain::BattleType &battleType : battleTypes)
+                {
+                    const SlotBatch &batch = pendingSlots[static_cast<size_t>(battleType.getType())];
+                    if (!received[static_cast<size_t>(battleType.getType())] || batch.received < 2 ||
+                        !hasUsableSlots(batch))
+                    {
+                        Serial.print("Bulk schedule is missing slots for ");
+                        Serial.println(battleType.getEnglishName());
+                        return false;
+                    }
+                }
+
+                for (const Domain::BattleType &battleType : battleTypes)
+                {
+                    Serial.print("Updating ");
+                    Serial.print(battleType.getEnglishName());
+                    Serial.println(" data...");
+
+                    // レスポンスに含まれる先のスロットですべて置き換える
+                    timelines[static_cast<int>(battleType.getType())].clear();
+                    storeSlots(pendingSlots[static_cast<size_t>(battleType.getType())], battleType, 0);
+                }
+
+                return true;
+            });
     }
 
-    void APIScheduleRepository::updateScheduleForBattleType(const Domain::BattleType &battleType)
+    bool APIScheduleRepository::updateAllSchedulesFromEndpoints()
     {
-        // Debug message
-        Serial.print("Updating ");
-        Serial.print(battleType.getEnglishName());
-        Serial.println(" data...");
-
-        // Get current schedule
-        String currentResponse = networkService.httpGet(battleType.getCurrentScheduleUrl());
-        if (currentResponse.length() > 0)
+        Serial.println("Updating all schedules from per-endpoint requests...");
+        unsigned long startMillis = millis();
+
+        // バトルタイプごとに/now、/nextの順に並べる
+        EndpointRequest requests[ENDPOINT_REQUEST_COUNT];
+        for (size_t index = 0; index < ENDPOINT_REQUEST_COUNT; index++)
+        {
+            EndpointRequest &request = requests[index];
+            request.battleType = Domain::BattleType::fromType(static_cast<Domain::BattleType::Type>(index / 2));
+            request.isCurrentSchedule = index % 2 == 0;
+            request.started = false;
+            request.updated = false;
+            request.validated = false;
+        }
+
+        size_t remaining = ENDPOINT_REQUEST_COUNT;
+        size_t inFlight = 0;
+        while (remaining > 0)
         {
-            Domain::BattleSchedule schedule = parseScheduleFromJson(currentResponse, battleType, true);
+            // 空いている接続がある限り、送れるリクエストを順に開始する
+            for (size_t index = 0; index < ENDPOINT_REQUEST_COUNT; index++)
+            {
+                EndpointRequest &request = requests[index];
+
+                // /nowと/nextは同じバトルタイプでも並行して要求し、格納は全て終わってから行う
+                if (request.started)
+                {
+                    continue;
+                }
+
+                int type = static_cast<int>(request.battleType.getType());
+                SlotBatch &batch = request.isCurrentSchedule ? pendingSlots[type] : pendingNextSlots[type];
+                bool started = networkService.startHttpGetIfModified(
+                    request.isCurrentSchedule ? request.battleType.getCurrentScheduleUrl() : request.battleType.getNextScheduleUrl(),
+                    request.isCurrentSchedule ? currentValidators[type] : nextValidators[type],
+                    [this, &request, &batch](Stream &stream)
+                    {
+                        // 解析できなかったレスポンスの検証子は保存しない
+                        request.updated = parseScheduleFromJson(stream, request.battleType, batch);
+                        return request.updated;
+                    },
+                    [&request, &remaining, &inFlight](Application::NetworkService::FetchResult result)
+                    {
+                        // 304や通信エラーの場合は前回のスケジュールをそのまま使う
+                        request.validated = result != Application::NetworkService::FetchResult::FAILED;
+                        request.updated &= result == Application::NetworkService::FetchResult::UPDATED;
+                        remaining--;
+                        inFlight--;
+                    });
+
+                if (started)
+                {
+                    request.started = true;
+                    inFlight++;
+                    continue;
+                }
+
+                // 処理中のリクエストがないのに開始できない場合（切断など）は失敗として扱う
+                if (inFlight > 0)
+                {
+                    break;
+                }
+                request.started = true;
+                remaining--;
+            }
 
-            // Store in appropriate cache
-            if (battleType == Domain::BattleType::regular())
+            if (inFlight == 0)
             {
-                regularSchedule = schedule;
+                continue;
             }
-            else if (battleType == Domain::BattleType::xMatch())
+
+            // 応答の届いた順に解析される
+            networkService.poll();
+            delay(1);
+        }
+
+        Serial.print("Per-endpoint requests finished in ");
+        Serial.print(millis() - startMillis);
+        Serial.println(" ms");
+
+        // /nowで保持しているスロットをずらしてから、/nextをその後ろに続ける
+        bool updated = false;
+        for (size_t index = 0; index < ENDPOINT_REQUEST_COUNT; index += 2)
+        {
+            EndpointRequest &current = requests[index];
+            EndpointRequest &next = requests[index + 1];
+            size_t type = static_cast<size_t>(current.battleType.getType());
+
+            if (current.updated)
             {
-                xMatchSchedule = schedule;
+                storeSlots(pendingSlots[type], current.battleType, 0);
             }
-            else if (battleType == Domain::BattleType::bankaraChallenge())
+
+            // 続きにならず格納できなかった/nextは、次の更新で304にならないよう検証子を捨てる
+            if (next.updated && !appendNextSlots(pendingNextSlots[type], next.battleType))
             {
-                bankaraChallengeSchedule = schedule;
+                nextValidators[type] = Application::NetworkService::CacheValidators();
+                next.updated = false;
+                next.validated = false;
             }
-            else if (battleType == Domain::BattleType::bankaraOpen())
+
+            updated |= current.updated || next.updated;
+
+            // /nowと/nextの両方を確認できたバトルタイプだけを新しいとみなす
+            if (current.validated && next.validated)
             {
-                bankaraOpenSchedule = schedule;
+                markValidated(current.battleType.getType());
             }
         }
+        return updated;
+    }
 
-        // レスポンス文字列を明示的に解放
-        currentResponse.clear();
+    void APIScheduleRepository::storeSlots(
+        const SlotBatch &batch,
+        const Domain::BattleType &battleType,
+        size_t firstIndex)
+    {
+        ScheduleRingBuffer<SLOT_CAPACITY> &timeline = timelines[static_cast<int>(battleType.getType())];
 
-        delay(200); // Short delay between requests
+        // 現在のスロットを受け取った場合は、保持しているスロットをその開始時刻までずらす
+        // 同じ開始時刻のスロットだけを置き換え、続くスロットは/nextが届くまで（届かなくても）残す
+        if (firstIndex == 0 && !timeline.empty())
+        {
+            time_t start = batch.slots[0].getStartEpoch();
+            timeline.dropExpired(start);
+            if (!timeline.empty() && timeline.at(0).getStartEpoch() != start)
+            {
+                timeline.clear();
+            }
+        }
 
-        // Get next schedule
-        String nextResponse = networkService.httpGet(battleType.getNextScheduleUrl());
-        if (nextResponse.length() > 0)
+        size_t index = firstIndex;
+        for (size_t position = 0; position < batch.count; position++)
         {
-            Domain::BattleSchedule schedule = parseScheduleFromJson(nextResponse, battleType, false);
+            const Domain::BattleSchedule &entry = batch.slots[position];
 
-            // Store in appropriate cache
-            if (battleType == Domain::BattleType::regular())
+            // 容量を超えた場合、前のスロットがない場合、時刻の読めないスロット以降は格納しない
+            if (index >= SLOT_CAPACITY || entry.getEndEpoch() == 0 || !timeline.set(index, entry))
             {
-                regularNextSchedule = schedule;
+                break;
             }
-            else if (battleType == Domain::BattleType::xMatch())
+
+            // 表示に使う現在と次回のスロットだけをログ
+            if (index < 2)
             {
-                xMatchNextSchedule = schedule;
+                logSchedule(entry);
             }
-            else if (battleType == Domain::BattleType::bankaraChallenge())
+
+            index++;
+        }
+
+        // 次回以降のスロットはレスポンスの内容で置き換える
+        if (firstIndex > 0)
+        {
+            timeline.truncate(index);
+        }
+
+        Serial.print("Stored ");
+        Serial.print(timeline.size());
+        Serial.print(" slots for ");
+        Serial.println(battleType.getEnglishName());
+    }
+
+    void APIScheduleRepository::markValidated(Domain::BattleType::Type type)
+    {
+        size_t index = static_cast<size_t>(type);
+        validated[index] = true;
+        validatedMillis[index] = millis();
+    }
+
+    bool APIScheduleRepository::isStale(Domain::BattleType::Type type) const
+    {
+        size_t index = static_cast<size_t>(type);
+        if (timelines[index].empty())
+        {
+            return false;
+        }
+
+        // 一度も確認できていないスロットは古いものとして扱う
+        return Domain::ScheduleSnapshot::isConfirmationStale(validated[index], validatedMillis[index], millis());
+    }
+
+    bool APIScheduleRepository::hasUsableSlots(const SlotBatch &batch)
+    {
+        if (batch.count == 0)
+        {
+            return false;
+        }
+
+        // 読めない時刻は0として格納される
+        return batch.slots[0].getStartEpoch() != 0 && batch.slots[0].getEndEpoch() != 0;
+    }
+
+    bool APIScheduleRepository::parseSlotArray(
+        JsonStreamScanner &scanner,
+        const Domain::BattleType &battleType,
+        SlotBatch &batch)
+    {
+        batch.count = 0;
+        batch.received = 0;
+        if (!scanner.enterArray())
+        {
+            return false;
+        }
+
+        // 1要素ずつ解析し、BattleScheduleにしたらドキュメントは捨てる（次の解析で領域を使い直す）
+        JsonDocument doc(&jsonArena);
+        while (scanner.nextElement())
+        {
+            DeserializationError error = deserializeJson(
+                doc,
+                scanner.getStream(),
+                DeserializationOption::Filter(slotFilter));
+            if (error)
+            {
+                Serial.print("JSON parse error: ");
+                Serial.println(error.c_str());
+                return false;
+            }
+
+            if (batch.count < SLOT_CAPACITY)
             {
-                bankaraChallengeNextSchedule = schedule;
+                batch.slots[batch.count++] = createScheduleFromSlot(doc.as<JsonVariantConst>(), battleType);
             }
-            else if (battleType == Domain::BattleType::bankaraOpen())
+            batch.received++;
+        }
+
+        return !scanner.hasFailed();
+    }
+
+    bool APIScheduleRepository::skipValue(JsonStreamScanner &scanner)
+    {
+        JsonDocument doc(&jsonArena);
+        DeserializationError error = deserializeJson(
+            doc,
+            scanner.getStream(),
+            DeserializationOption::Filter(skipFilter));
+        return !error;
+    }
+
+    bool APIScheduleRepository::advanceExpiredSlots()
+    {
+        time_t now = time(nullptr);
+
+        // 時刻が未同期の場合はスロットの終了を判定できない
+        if (now < MIN_VALID_EPOCH)
+        {
+            return false;
+        }
+
+        bool advanced = false;
+        for (ScheduleRingBuffer<SLOT_CAPACITY> &timeline : timelines)
+        {
+            if (timeline.dropExpired(now) > 0)
             {
-                bankaraOpenNextSchedule = schedule;
+                advanced = true;
             }
         }
 
-        // レスポンス文字列を明示的に解放
-        nextResponse.clear();
+        if (advanced)
+        {
+            Serial.println("Advanced to the next schedule slot without fetching");
+        }
+
+        return advanced;
     }
 
-    Domain::BattleSchedule APIScheduleRepository::parseScheduleFromJson(
-        const String &jsonResponse,
+    bool APIScheduleRepository::parseScheduleFromJson(
+        Stream &jsonStream,
         const Domain::BattleType &battleType,
-        bool isCurrentSchedule)
+        SlotBatch &batch)
+    {
+        // {"results":[...]}をスロット1つずつ解析する
+        unsigned long parseStart = micros();
+        MemoryManager::PhaseScope parseScope(MemoryManager::Phase::PARSE);
+        batch.count = 0;
+        batch.received = 0;
+
+        JsonStreamScanner scanner(jsonStream);
+        char key[16];
+        bool parsed = scanner.enterObject();
+        while (parsed && scanner.nextKey(key, sizeof(key)))
+        {
+            parsed = strcmp(key, "results") == 0 ? parseSlotArray(scanner, battleType, batch) : skipValue(scanner);
+        }
+        parseMicros += micros() - parseStart;
+
+        if (!parsed || scanner.hasFailed())
+        {
+            Serial.println("Schedule response is malformed or cut off");
+            return false;
+        }
+
+        if (!hasUsableSlots(batch))
+        {
+            Serial.println("Schedule response has no usable results");
+            return false;
+        }
+
+        return true;
+    }
+
+    bool APIScheduleRepository::appendNextSlots(const SlotBatch &batch, const Domain::BattleType &battleType)
     {
-        // Parse JSON response - 最新のArduinoJsonの使用方法
-        JsonDocument doc;
-        DeserializationError error = deserializeJson(doc, jsonResponse);
+        // /nowを取得できず、保持している先頭のスロットが次回の開始前に終わっている場合は読み飛ばす
+        ScheduleRingBuffer<SLOT_CAPACITY> &timeline = timelines[static_cast<int>(battleType.getType())];
+        time_t nextStart = batch.slots[0].getStartEpoch();
+        timeline.dropExpired(nextStart - 1);
 
-        if (error)
+        // 続きにならない（現在のスロットがない、または次回の開始時刻に終わらない）場合は格納できない
+        if (timeline.empty() || timeline.at(0).getEndEpoch() != nextStart)
         {
-            Serial.print("JSON parse error: ");
-            Serial.println(error.c_str());
-            // JSON ドキュメントを明示的に解放
-            doc.clear();
-            return Domain::BattleSchedule::createEmpty(battleType);
+            Serial.println("No current slot to append next schedules to");
+            return false;
         }
+        storeSlots(batch, battleType, 1);
+        return true;
+    }
 
+    Domain::BattleSchedule APIScheduleRepository::createScheduleFromSlot(
+        JsonVariantConst slot,
+        const Domain::BattleType &battleType)
+    {
         // バトルタイプに基づいて適切なルールを選択
         Domain::Rule rule; // デフォルトコンストラクタでUNKNOWNタイプに初期化される
 
@@ -179,7 +603,7 @@ namespace Infrastructure
         else
         {
             // その他のマッチタイプではAPIからルールを取得
-            const char *japaneseRule = doc["results"][0]["rule"]["name"];
+            const char *japaneseRule = slot["rule"]["name"];
             if (japaneseRule && strlen(japaneseRule) > 0)
             {
                 // 日本語ルール名からルールを取得
@@ -189,8 +613,8 @@ namespace Infrastructure
         }
 
         // ステージ情報の抽出と処理
-        const char *japaneseStage1 = doc["results"][0]["stages"][0]["name"];
-        const char *japaneseStage2 = doc["results"][0]["stages"][1]["name"];
+        const char *japaneseStage1 = slot["stages"][0]["name"];
+        const char *japaneseStage2 = slot["stages"][1]["name"];
 
         // ステージ情報の変換
         Domain::Stage stage1 = (japaneseStage1 && strlen(japaneseStage1) > 0)
@@ -201,74 +625,116 @@ namespace Infrastructure
                                    ? Domain::Stage::fromJapaneseName(japaneseStage2)
                                    : Domain::Stage::fromJapaneseName("不明");
 
-        // 時間情報の抽出
-        char startTime[6] = "--:--";
-        char endTime[6] = "--:--";
+        // バトルスケジュールを作成して返す（時刻はUNIX時間で保持し、表示時に整形する）
+        return Domain::BattleSchedule::create(
+            battleType,
+            rule,
+            stage1,
+            stage2,
+            parseIsoTime(slot["start_time"]),
+            parseIsoTime(slot["end_time"]));
+    }
+
+    time_t APIScheduleRepository::parseIsoTime(const char *isoTime)
+    {
+        if (isoTime == nullptr)
+        {
+            return 0;
+        }
 
-        const char *st = doc["results"][0]["start_time"];
-        if (st && strlen(st) > 16)
+        int year, month, day, hour, minute, second;
+        char sign = 'Z';
+        int offsetHour = 0, offsetMinute = 0;
+        int fields = sscanf(isoTime, "%4d-%2d-%2dT%2d:%2d:%2d%c%2d:%2d",
+                            &year, &month, &day, &hour, &minute, &second,
+                            &sign, &offsetHour, &offsetMinute);
+        if (fields < 6 || month < 1 || month > 12)
         {
-            strncpy(startTime, st + 11, 5);
-            startTime[5] = '\0';
+            return 0;
         }
 
-        const char *et = doc["results"][0]["end_time"];
-        if (et && strlen(et) > 16)
+        // 1970-01-01からの日数（グレゴリオ暦）
+        int y = year - (month <= 2 ? 1 : 0);
+        long era = y / 400;
+        long yearOfEra = y - era * 400;
+        long dayOfYear = (153L * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+        long dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        long days = era * 146097 + dayOfEra - 719468;
+
+        long seconds = ((days * 24 + hour) * 60 + minute) * 60L + second;
+
+        // タイムゾーンのオフセットを差し引いてUTCにする
+        long offset = (offsetHour * 60L + offsetMinute) * 60L;
+        if (fields == 9 && sign == '+')
         {
-            strncpy(endTime, et + 11, 5);
-            endTime[5] = '\0';
+            seconds -= offset;
         }
+        else if (fields == 9 && sign == '-')
+        {
+            seconds += offset;
+        }
+
+        return (time_t)seconds;
+    }
 
+    void APIScheduleRepository::logSchedule(const Domain::BattleSchedule &schedule)
+    {
         // デバッグ情報の出力
         Serial.print("Rule: ");
-        Serial.print(rule.getSymbol());
-        Serial.println(rule.getEnglishName());
+        Serial.print(schedule.getRule().getSymbol());
+        Serial.println(schedule.getRule().getEnglishName());
         Serial.print("Stage 1: ");
-        Serial.println(stage1.getEnglishName());
+        Serial.println(schedule.getStage1().getEnglishName());
         Serial.print("Stage 2: ");
-        Serial.println(stage2.getEnglishName());
+        Serial.println(schedule.getStage2().getEnglishName());
+        char startTime[Domain::BattleSchedule::TIME_TEXT_SIZE];
+        char endTime[Domain::BattleSchedule::TIME_TEXT_SIZE];
+        schedule.formatStartTime(startTime, sizeof(startTime));
+        schedule.formatEndTime(endTime, sizeof(endTime));
+
         Serial.print("Time: ");
         Serial.print(startTime);
         Serial.print(" - ");
         Serial.println(endTime);
-
-        // バトルスケジュールを作成して返す
-        Domain::BattleSchedule result = Domain::BattleSchedule::create(
-            battleType,
-            rule,
-            stage1,
-            stage2,
-            startTime,
-            endTime);
-
-        // JSON ドキュメントを明示的に解放
-        doc.clear();
-
-        return result;
     }
 
-    void APIScheduleRepository::logMemoryUsage(const char *operation)
+    void APIScheduleRepository::logConnectionStats()
     {
-        // ESP32のメモリ使用量を取得
-        size_t freeHeap = ESP.getFreeHeap();
-        size_t minFreeHeap = ESP.getMinFreeHeap();
-        size_t maxAllocHeap = ESP.getMaxAllocHeap();
-
-        Serial.print("Memory [");
-        Serial.print(operation);
-        Serial.print("] - Free: ");
-        Serial.print(freeHeap);
-        Serial.print(" bytes, Min Free: ");
-        Serial.print(minFreeHeap);
-        Serial.print(" bytes, Max Alloc: ");
-        Serial.print(maxAllocHeap);
-        Serial.println(" bytes");
-
-        // メモリ不足の警告
-        if (freeHeap < 10000) // 10KB未満の場合
+        Application::NetworkService::ConnectionStats stats = networkService.getConnectionStats();
+
+        lastUpdateStats.requestCount = stats.requestCount;
+        lastUpdateStats.handshakeCount = stats.handshakeCount;
+        lastUpdateStats.requestBytes = stats.requestBytes;
+        lastUpdateStats.headerBytes = stats.headerBytes;
+        lastUpdateStats.bodyBytes = stats.bodyBytes;
+        lastUpdateStats.parseMillis = parseMicros / 1000;
+        lastUpdateStats.jsonPeakBytes = jsonArena.getPeak();
+        lastUpdateStats.heapFallbacks = jsonArena.getHeapFallbacks();
+
+        Serial.print("Refresh requests: ");
+        Serial.print(stats.requestCount);
+        Serial.print(", TLS handshakes: ");
+        Serial.print(stats.handshakeCount);
+        Serial.print(", bytes sent/header/body: ");
+        Serial.print(stats.requestBytes);
+        Serial.print("/");
+        Serial.print(stats.headerBytes);
+        Serial.print("/");
+        Serial.print(stats.bodyBytes);
+        Serial.print(", JSON parse: ");
+        Serial.print(lastUpdateStats.parseMillis);
+        Serial.print(" ms, JSON arena peak: ");
+        Serial.print(lastUpdateStats.jsonPeakBytes);
+        Serial.print("/");
+        Serial.print(JSON_ARENA_CAPACITY);
+        Serial.print(" bytes");
+        if (lastUpdateStats.heapFallbacks > 0)
         {
-            Serial.println("WARNING: Low memory detected!");
+            Serial.print(" (heap fallbacks: ");
+            Serial.print(lastUpdateStats.heapFallbacks);
+            Serial.print(")");
         }
+        Serial.println();
     }
 
 } // namespace Infrastructure
\ No newline at end of file
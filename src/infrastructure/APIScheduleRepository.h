@@ -8,6 +8,9 @@
 #include "../application/ScheduleRepository.h"
 #include "../application/NetworkService.h"
 #include "../domain/BattleSchedule.h"
+#include "ScheduleRingBuffer.h"
+#include "RefreshArena.h"
+#include "JsonStreamScanner.h"
 
 namespace Infrastructure
 {
@@ -16,53 +19,189 @@ namespace Infrastructure
     class APIScheduleRepository : public Application::ScheduleRepository
     {
     public:
+        // スケジュールの取得方式
+        enum class FetchMode
+        {
+            BULK,        // /api/schedule を1回だけ取得して全スロットを埋める
+            PER_ENDPOINT // バトルタイプごとに /now と /next を個別に取得する
+        };
+
         explicit APIScheduleRepository(Application::NetworkService &networkService)
-            : networkService(networkService)
+            : networkService(networkService),
+              fetchMode(FetchMode::BULK),
+              parseMicros(0)
         {
+            for (size_t index = 0; index < Domain::BattleType::TYPE_COUNT; index++)
+            {
+                validated[index] = false;
+                validatedMillis[index] = 0;
+            }
+
             // 初期化時にスケジュールオブジェクトを生成
             initializeSchedules();
+
+            // ストリーム解析用のフィルタを一度だけ構築
+            initializeFilter();
         }
 
         // デストラクタでメモリを解放
         ~APIScheduleRepository() override = default;
 
-        // Fetch current schedule for a battle type
-        Domain::BattleSchedule fetchCurrentSchedule(const Domain::BattleType &battleType) override;
+        // Copy the current and next schedules of every battle type into the snapshot
+        void readSnapshot(Domain::ScheduleSnapshot &snapshot) override;
 
-        // Fetch next schedule for a battle type
-        Domain::BattleSchedule fetchNextSchedule(const Domain::BattleType &battleType) override;
+        // Seed the empty timelines with a snapshot saved before the last reboot
+        void restoreSnapshot(const Domain::ScheduleSnapshot &snapshot) override;
 
         // Update all schedules for all battle types
-        void updateAllSchedules() override;
+        bool updateAllSchedules() override;
+
+        // Get statistics of the last updateAllSchedules call
+        UpdateStats getLastUpdateStats() const override { return lastUpdateStats; }
+
+        // 取得方式の設定・取得
+        void setFetchMode(FetchMode mode) { fetchMode = mode; }
+        FetchMode getFetchMode() const { return fetchMode; }
 
     private:
         Application::NetworkService &networkService;
+        FetchMode fetchMode;
+
+        // 全バトルタイプのスケジュールをまとめて返すAPI
+        static constexpr const char *BULK_SCHEDULE_URL = "https://spla3.yuu26.com/api/schedule";
+
+        // バトルタイプごとに保持する先のスロット数（2時間 x 12 = 24時間分）
+        static constexpr size_t SLOT_CAPACITY = 12;
+
+        // 時刻が同期済みとみなす最小のUNIX時間（2020-01-01）
+        static constexpr time_t MIN_VALID_EPOCH = 1577836800;
+
+        // スケジュールデータ（BattleType::Typeで添字付け、先頭が現在のスロット）
+        // 時刻がスロットの終了を過ぎると通信せずに次のスロットへ進む
+        ScheduleRingBuffer<SLOT_CAPACITY> timelines[Domain::BattleType::TYPE_COUNT];
+
+        // バトルタイプごとに、保持しているスロットを最後にサーバーで確認できた時刻（304を含む）
+        // 取得や解析に失敗した場合は更新せず、スロットも前回のものを使い続ける
+        bool validated[Domain::BattleType::TYPE_COUNT];
+        unsigned long validatedMillis[Domain::BattleType::TYPE_COUNT];
+
+        // スロット1つ分のオブジェクトから必要なフィールドだけを残すフィルタと、値をすべて読み捨てるフィルタ
+        JsonDocument slotFilter;
+        JsonDocument skipFilter;
+
+        // JSONドキュメント用の領域
+        // レスポンスはスロット1つずつ解析して捨てるため、スロットの数によらずこの大きさに収まる
+        // ArduinoJsonの1回目のプール（32ビットで1KB、64ビットのホストで4KB）と文字列が入る大きさにする
+        // 更新の最後にまとめて解放し、定常状態では汎用ヒープを使わない
+        static constexpr size_t JSON_ARENA_CAPACITY = 8 * 1024;
+        RefreshArena<JSON_ARENA_CAPACITY> jsonArena;
+
+        // 1つのslots配列から読み取ったスロット（容量を超えた分は数えるだけで保持しない）
+        struct SlotBatch
+        {
+            Domain::BattleSchedule slots[SLOT_CAPACITY];
+            size_t count;    // 保持したスロット数
+            size_t received; // 配列の要素数
+        };
+
+        // 解析したスロットを、レスポンス全体を確かめてから格納するまで置いておく（BattleType::Typeで添字付け）
+        // 個別取得では/nextを/nowと並行して受け取るため、すべての応答がそろうまで別々に置いておく
+        SlotBatch pendingSlots[Domain::BattleType::TYPE_COUNT];
+        SlotBatch pendingNextSlots[Domain::BattleType::TYPE_COUNT];
+
+        // 直近の更新の統計情報と、更新中に積算するJSON解析時間
+        UpdateStats lastUpdateStats;
+        unsigned long parseMicros;
+
+        // 個別取得での1エンドポイント分のリクエストの進行状況
+        struct EndpointRequest
+        {
+            Domain::BattleType battleType;
+            bool isCurrentSchedule;
+            bool started;
+            bool updated;   // 200を解析でき、スロットを置いてある
+            bool validated; // 304または格納できた200
+        };
 
-        // スケジュールデータ（各バトルタイプごとに現在と次回のスケジュール）
-        // メンバ変数の宣言のみ - 初期化はinitializeSchedules()で行う
-        Domain::BattleSchedule regularSchedule;
-        Domain::BattleSchedule xMatchSchedule;
-        Domain::BattleSchedule bankaraChallengeSchedule;
-        Domain::BattleSchedule bankaraOpenSchedule;
-        Domain::BattleSchedule regularNextSchedule;
-        Domain::BattleSchedule xMatchNextSchedule;
-        Domain::BattleSchedule bankaraChallengeNextSchedule;
-        Domain::BattleSchedule bankaraOpenNextSchedule;
+        // 個別取得のリクエスト数（バトルタイプごとに/nowと/next）
+        static constexpr size_t ENDPOINT_REQUEST_COUNT = Domain::BattleType::TYPE_COUNT * 2;
+
+        // 条件付きリクエスト用の検証子（エンドポイントごと、BattleType::Typeで添字付け）
+        Application::NetworkService::CacheValidators bulkValidators;
+        Application::NetworkService::CacheValidators currentValidators[Domain::BattleType::TYPE_COUNT];
+        Application::NetworkService::CacheValidators nextValidators[Domain::BattleType::TYPE_COUNT];
 
         // 初期スケジュールを設定
         void initializeSchedules();
 
-        // Update schedule data for a specific battle type
-        void updateScheduleForBattleType(const Domain::BattleType &battleType);
+        // JSONフィルタを設定
+        void initializeFilter();
+
+        // Update all schedules with a single request to the bulk endpoint
+        Application::NetworkService::FetchResult updateAllSchedulesFromBulk();
+
+        // Fetch the /now and /next endpoints of every battle type with several
+        // requests in flight, in any order. Responses are parsed as they complete
+        // and stored, /now before /next, once every request has finished
+        // Returns true if any schedule was replaced
+        bool updateAllSchedulesFromEndpoints();
+
+        // Store parsed slots from firstIndex onward
+        // The current slot (firstIndex 0) shifts the held slots up to its start and keeps
+        // the following ones; otherwise the rest is replaced
+        void storeSlots(
+            const SlotBatch &batch,
+            const Domain::BattleType &battleType,
+            size_t firstIndex);
+
+        // Record that the slots of a battle type were confirmed by the server
+        void markValidated(Domain::BattleType::Type type);
+
+        // Whether a battle type with slots has gone unconfirmed for ScheduleSnapshot::STALE_AFTER_MILLIS
+        bool isStale(Domain::BattleType::Type type) const;
+
+        // Check that parsed slots start with a slot whose times can be parsed
+        // Responses failing this are rejected before anything is stored
+        static bool hasUsableSlots(const SlotBatch &batch);
 
-        // Parse API response to create a BattleSchedule
-        Domain::BattleSchedule parseScheduleFromJson(
-            const String &jsonResponse,
+        // Parse a slots array one element at a time into the batch
+        // Returns false if the stream is cut off or malformed
+        bool parseSlotArray(
+            JsonStreamScanner &scanner,
             const Domain::BattleType &battleType,
-            bool isCurrentSchedule);
+            SlotBatch &batch);
+
+        // Read past the next value of the stream without keeping it
+        bool skipValue(JsonStreamScanner &scanner);
+
+        // Drop slots whose end time has passed from every timeline
+        // Returns true if any current slot changed
+        bool advanceExpiredSlots();
+
+        // Parse a {"results":[...]} response stream into the batch without storing it
+        // Returns false if the response is malformed or has no usable slot
+        bool parseScheduleFromJson(
+            Stream &jsonStream,
+            const Domain::BattleType &battleType,
+            SlotBatch &batch);
+
+        // Append the slots of a /next response after the held current slot
+        // Returns false if there is no current slot that ends when the first one starts
+        bool appendNextSlots(const SlotBatch &batch, const Domain::BattleType &battleType);
+
+        // Create a BattleSchedule from a single slot object of the API response
+        Domain::BattleSchedule createScheduleFromSlot(
+            JsonVariantConst slot,
+            const Domain::BattleType &battleType);
+
+        // ISO 8601形式の時刻（例: 2024-01-01T13:00:00+09:00）をUNIX時間に変換（失敗時は0）
+        static time_t parseIsoTime(const char *isoTime);
+
+        // スケジュールの内容をログ
+        void logSchedule(const Domain::BattleSchedule &schedule);
 
-        // メモリ使用量監視機能
-        void logMemoryUsage(const char *operation);
+        // 今回の更新でのリクエスト数・TLSハンドシェイク数・解析時間を記録してログ
+        void logConnectionStats();
     };
 
 } // namespace Infrastructure
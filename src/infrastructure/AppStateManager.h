@@ -28,7 +28,7 @@ namespace Infrastructure
 
         // タイマー定数
         const unsigned long DATA_UPDATE_INTERVAL = 5 * 60 * 1000;     // 5分ごとにデータを更新（5分 x 60秒 x 1000ms）
-        const unsigned long TIME_DISPLAY_UPDATE_INTERVAL = 10 * 1000; // 10秒ごとに時間表示を更新
+        const unsigned long TIME_DISPLAY_UPDATE_INTERVAL = 10 * 1000; // 時刻が未同期の間は10秒ごとに時間表示を更新（同期後は毎分の境界）
         const unsigned long WIFI_PROCESS_INTERVAL = 100;              // 100msごとにWiFi処理を実行
         const unsigned long INITIALIZE_CHECK_INTERVAL = 1000;         // 1秒ごとに初期化チェック
         const unsigned long WIFI_SETTING_DISPLAY_DURATION = 15000;    // WiFi設定表示時間を15秒に設定
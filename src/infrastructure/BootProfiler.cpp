@@ -0,0 +1,77 @@
+// BootProfiler.cpp
+// 起動時間の計測の実装
+
+#include "BootProfiler.h"
+
+namespace Infrastructure
+{
+    constexpr size_t BootProfiler::MAX_MARKS;
+
+    // 静的変数の初期化
+    BootProfiler::Mark BootProfiler::marks[BootProfiler::MAX_MARKS];
+    size_t BootProfiler::markCount = 0;
+    size_t BootProfiler::droppedMarks = 0;
+    unsigned long BootProfiler::bootToDataMillis = 0;
+
+    void BootProfiler::mark(const char *phase)
+    {
+        unsigned long now = millis();
+
+        if (markCount >= MAX_MARKS)
+        {
+            droppedMarks++;
+            return;
+        }
+
+        marks[markCount].phase = phase;
+        marks[markCount].millis = now;
+        markCount++;
+
+        Serial.print("[boot] ");
+        Serial.print(now);
+        Serial.print(" ms: ");
+        Serial.println(phase);
+    }
+
+    void BootProfiler::markDataShown()
+    {
+        if (bootToDataMillis != 0)
+        {
+            return;
+        }
+
+        bootToDataMillis = millis();
+        mark("data_shown");
+
+        Serial.print("BOOT ");
+        Serial.println(buildReportJson());
+    }
+
+    String BootProfiler::buildReportJson()
+    {
+        String json;
+        json.reserve(64 + markCount * 32);
+
+        json += "{\"boot_to_data_ms\":" + String(bootToDataMillis);
+        json += ",\"phases\":[";
+        for (size_t i = 0; i < markCount; i++)
+        {
+            if (i > 0)
+            {
+                json += ",";
+            }
+            json += "{\"phase\":\"";
+            json += marks[i].phase;
+            json += "\",\"ms\":" + String(marks[i].millis) + "}";
+        }
+        json += "]";
+
+        if (droppedMarks > 0)
+        {
+            json += ",\"dropped\":" + String((unsigned long)droppedMarks);
+        }
+        json += "}";
+
+        return json;
+    }
+}
@@ -0,0 +1,49 @@
+// BootProfiler.h
+// 起動の各段階の時刻を記録し、起動からスケジュール表示までの時間を計測する
+
+#ifndef BOOT_PROFILER_H
+#define BOOT_PROFILER_H
+
+#include <Arduino.h>
+
+namespace Infrastructure
+{
+    // Records boot phases with their time since boot into a fixed trace buffer and
+    // reports the cold-boot-to-data time once the first fetched schedules are shown.
+    // Times are millis(), which counts from esp_timer start-up, so the ROM and
+    // bootloader time before the application starts is not included.
+    // Marks are only recorded from the loop task (setup() runs on it too), so no lock is taken.
+    class BootProfiler
+    {
+    public:
+        // 記録できる段階の数（超えた分は捨てて数だけ数える）
+        static constexpr size_t MAX_MARKS = 16;
+
+        // 段階の名前と起動からの時刻を記録する（名前は文字列リテラルなど寿命の長いものを渡す）
+        static void mark(const char *phase);
+
+        // 取得したスケジュールを初めて表示したことを記録し、トレースを"BOOT "で始まる1行で出力する
+        // 2回目以降は何もしない
+        static void markDataShown();
+
+        // 起動からスケジュールを表示するまでの時間（まだ表示していない場合は0）
+        static unsigned long getBootToDataMillis() { return bootToDataMillis; }
+
+        // トレースをJSONとして返す（シリアルコンソールから参照する）
+        static String buildReportJson();
+
+    private:
+        struct Mark
+        {
+            const char *phase;
+            unsigned long millis;
+        };
+
+        static Mark marks[MAX_MARKS];
+        static size_t markCount;
+        static size_t droppedMarks;
+        static unsigned long bootToDataMillis;
+    };
+}
+
+#endif // BOOT_PROFILER_H
@@ -6,13 +6,22 @@
 
 #include <Arduino.h>
 #include <WiFi.h>
+#include <time.h>
+#include <sys/time.h>
 #include "../application/AppInitializationService.h"
 #include "../application/WiFiConnectionManager.h"
 #include "../application/DisplayService.h"
 #include "../application/NetworkService.h"
 #include "../application/ScheduleApplicationService.h"
 #include "../application/SettingsService.h"
+#include "../application/SnapshotStore.h"
+#include "../application/RefreshScheduler.h"
+#include "../application/EventScheduler.h"
 #include "../infrastructure/AppStateManager.h"
+#include "../infrastructure/ScheduleFetchTask.h"
+#include "../infrastructure/ESP32EventQueue.h"
+#include "../infrastructure/PowerManager.h"
+#include "../infrastructure/BootProfiler.h"
 
 namespace Infrastructure
 {
@@ -25,9 +34,32 @@ namespace Infrastructure
         Application::ScheduleApplicationService &applicationService;
         Application::WiFiConnectionManager &wifiConnectionManager;
         Application::SettingsService &settingsService;
+        Application::SnapshotStore &snapshotStore;
         AppStateManager &appStateManager;
 
+        // メインループのタイマー（各処理の次回実行時刻はここに登録する）
+        Application::EventScheduler &eventScheduler;
+
+        // スロット境界に合わせたデータ更新のスケジューラ
+        Application::RefreshScheduler refreshScheduler;
+
+        // 取得と解析を行うコア0のタスク（描画はこのループのタスクで行う）
+        ScheduleFetchTask fetchTask;
+
+        // 起動後に初めて時刻が同期されたか（以降の定期的な再同期では何もしない）
+        bool timeSynced;
+
     public:
+        // キャプティブポータル表示中のWiFi処理間隔（DNSとWebサーバーの応答性を保つ）
+        static constexpr unsigned long PORTAL_PROCESS_INTERVAL = 10;
+
+        // 分の境界から時刻表示を更新するまでの余裕（millis()と時計のずれで境界の手前に起きないように）
+        static constexpr unsigned long CLOCK_TICK_MARGIN = 50;
+
+        // 起動画面とデバイス情報を表示する最大時間（WiFiのIPアドレスが取得できた時点で次に進む）
+        static constexpr unsigned long STARTUP_SCREEN_MAX_MILLIS = 1000;
+        static constexpr unsigned long DEVICE_INFO_MAX_MILLIS = 3000;
+
         // コンストラクタ
         ESP32AppInitializationService(
             Application::NetworkService &networkService,
@@ -35,13 +67,21 @@ namespace Infrastructure
             Application::ScheduleApplicationService &applicationService,
             Application::WiFiConnectionManager &wifiConnectionManager,
             Application::SettingsService &settingsService,
-            AppStateManager &appStateManager)
+            Application::SnapshotStore &snapshotStore,
+            AppStateManager &appStateManager,
+            Application::EventScheduler &eventScheduler,
+            ESP32EventQueue &eventQueue)
             : networkService(networkService),
               displayService(displayService),
               applicationService(applicationService),
               wifiConnectionManager(wifiConnectionManager),
               settingsService(settingsService),
-              appStateManager(appStateManager)
+              snapshotStore(snapshotStore),
+              appStateManager(appStateManager),
+              eventScheduler(eventScheduler),
+              refreshScheduler(esp_random()),
+              fetchTask(applicationService, snapshotStore, eventQueue),
+              timeSynced(false)
         {
         }
 
@@ -63,76 +103,102 @@ namespace Infrastructure
 
             // 反転設定を適用
             displayService.invertDisplay(invertedDisplay);
+            BootProfiler::mark("display_ready");
 
-            // 起動画面表示
-            displayService.showStartupScreen();
+            // 前回保存したスケジュールがあれば、起動画面の代わりにすぐ表示する
+            bool savedShown = showSavedSchedules();
+            if (savedShown)
+            {
+                BootProfiler::mark("saved_schedules_shown");
+            }
 
-            // 初期化の間隔を空ける
-            delay(1000);
+            // 取得タスクを起動
+            fetchTask.start();
 
-            // デバイス情報を画面に表示（3秒間）
-            displayService.showDeviceInfo();
-            delay(3000);
+            // 画面の表示と並行してWiFi接続と時刻同期を始める
+            wifiConnectionManager.startConnecting();
+            networkService.configureTimeService();
+            BootProfiler::mark("network_started");
 
-            // WiFi接続の初期セットアップ
+            if (!savedShown)
+            {
+                // 起動画面表示（接続できた時点で次に進む）
+                displayService.showStartupScreen();
+                if (!WiFi.waitStatusBits(STA_HAS_IP_BIT, STARTUP_SCREEN_MAX_MILLIS))
+                {
+                    // 接続を待つ間、デバイス情報を画面に表示
+                    displayService.showDeviceInfo();
+                    WiFi.waitStatusBits(STA_HAS_IP_BIT, DEVICE_INFO_MAX_MILLIS);
+                }
+                BootProfiler::mark("splash_done");
+            }
+
+            // WiFi接続の初期セットアップ（接続済みならそのまま初期化に進む）
             wifiConnectionManager.setupWiFiConnection();
 
+            // 初期化が終わるまでの定期処理を登録
+            unsigned long currentMillis = millis();
+            updateWiFiProcessTimer(currentMillis);
+            eventScheduler.scheduleEvery(Application::AppEvent::INITIALIZE_CHECK, currentMillis,
+                                         appStateManager.getInitializeCheckInterval());
+
             // WiFi接続が既に完了している場合は初期化を試みる
-            if (wifiConnectionManager.isConnectionCompleted())
+            if (wifiConnectionManager.isConnectionCompleted() && tryInitializeApp())
             {
-                tryInitializeApp();
+                processDataFetching();
             }
         }
 
-        // 定期実行されるロジック
-        void performLoop(unsigned long currentMillis) override
+        // メインループに届いたイベントの処理
+        void handleEvent(Application::AppEvent event, unsigned long currentMillis) override
         {
-            // データが取得中かつ初期化されていない場合のデータ取得処理
-            processDataFetching();
-
-            // WiFi接続処理
-            wifiConnectionManager.processWiFiConnection(currentMillis);
-
-            // アプリケーションの初期化チェック
-            if (!appStateManager.isAppInitialized() &&
-                !appStateManager.getIsDataFetching() &&
-                currentMillis - appStateManager.getLastInitializeCheckTime() >= appStateManager.getInitializeCheckInterval())
+            switch (event)
             {
-
-                // 接続状態が変わったときだけ初期化を試行
-                static bool lastConnectionState = false;
-                bool currentConnectionState = wifiConnectionManager.isConnectionCompleted();
-
-                if (currentConnectionState && !lastConnectionState)
+            case Application::AppEvent::WIFI_POLL:
+            case Application::AppEvent::WIFI_CHANGED:
+                // WiFi接続処理（状態が変わった場合は処理間隔も切り替える）
+                wifiConnectionManager.processWiFiConnection(currentMillis);
+                updateWiFiProcessTimer(currentMillis);
+                updatePowerMode();
+                break;
+
+            case Application::AppEvent::INITIALIZE_CHECK:
+                processInitializeCheck(currentMillis);
+                break;
+
+            case Application::AppEvent::FETCH_COMPLETED:
+                // 取得タスクの結果を画面に反映する
+                processFetchResult();
+                break;
+
+            case Application::AppEvent::REFRESH_DUE:
+                processRefreshDue(currentMillis);
+                break;
+
+            case Application::AppEvent::TIME_SYNCED:
+                processTimeSynced(currentMillis);
+                break;
+
+            case Application::AppEvent::TIME_DISPLAY:
+                // 通知を取りこぼした場合でも結果が残らないよう、ここでも確認する
+                processFetchResult();
+
+                if (appStateManager.isAppInitialized() && wifiConnectionManager.isConnectionCompleted())
                 {
-                    tryInitializeApp();
+                    applicationService.updateTimeDisplay();
+                    appStateManager.setLastTimeDisplayUpdateTime(currentMillis);
                 }
 
-                lastConnectionState = currentConnectionState;
-                appStateManager.setLastInitializeCheckTime(currentMillis);
-            }
-
-            // アプリケーションが初期化済みの場合の定期更新処理
-            if (appStateManager.isAppInitialized() && wifiConnectionManager.isConnectionCompleted())
-            {
-                // データの定期更新
-                if (currentMillis - appStateManager.getLastDataUpdateTime() >= appStateManager.getDataUpdateInterval())
+                // 取得に失敗し続けている間も、確認できないまま時間の経った区画を古いと示す
+                if (appStateManager.isAppInitialized())
                 {
-                    Serial.println("Updating all schedule data...");
-                    // アプリが初期化済みの場合、バックグラウンド更新モードを使用する
-                    displayService.showLoadingMessage("Updating data...", true);
-                    appStateManager.setIsDataFetching(true);
-                    applicationService.updateAllData();
-                    appStateManager.setIsDataFetching(false);
-                    appStateManager.setLastDataUpdateTime(currentMillis);
+                    applicationService.refreshStaleness(currentMillis);
                 }
+                scheduleNextTimeDisplay(currentMillis);
+                break;
 
-                // 時刻表示の更新
-                if (currentMillis - appStateManager.getLastTimeDisplayUpdateTime() >= appStateManager.getTimeDisplayUpdateInterval())
-                {
-                    applicationService.updateTimeDisplay();
-                    appStateManager.setLastTimeDisplayUpdateTime(currentMillis);
-                }
+            default:
+                break;
             }
         }
 
@@ -152,6 +218,7 @@ namespace Infrastructure
             }
 
             Serial.println("Starting application initialization...");
+            BootProfiler::mark("app_init");
 
             // 表示設定を読み込んでアプリケーションに適用
             Domain::DisplaySettings displaySettings = settingsService.loadDisplaySettings();
@@ -178,7 +245,16 @@ namespace Infrastructure
                      "Connection OK\nSSID: %s\nIP: %s\nInitializing...",
                      ssid.c_str(), ipAddress.c_str());
 
-            displayService.showConnectionStatus(true, connectionMessage);
+            // 保存済みのスケジュールを表示している場合は、画面を覆わずに更新インジケータだけを出す
+            bool showingSchedules = displayService.isShowingSchedules();
+            if (showingSchedules)
+            {
+                displayService.showLoadingMessage(connectionMessage, true);
+            }
+            else
+            {
+                displayService.showConnectionStatus(true, connectionMessage);
+            }
 
             // 文字列オブジェクトを明示的に解放
             ipAddress.clear();
@@ -195,14 +271,10 @@ namespace Infrastructure
                 return false;
             }
 
-            // WiFi接続を維持するために十分な安定化時間
-            delay(500);
-
-            // 時刻サービスを設定
-            networkService.configureTimeService();
+            // 時刻サービスは起動時に設定済み（同期はTIME_SYNCEDで知らせる）
 
             // 初期データ取得前の通知
-            displayService.showLoadingMessage("Fetching data...", false);
+            displayService.showLoadingMessage("Fetching data...", showingSchedules);
             appStateManager.setIsDataFetching(true);
 
             Serial.println("Application initialization started");
@@ -210,34 +282,308 @@ namespace Infrastructure
         }
 
     private:
+        // 前回保存したスケジュールを表示する（保存されていない場合はfalse）
+        // 取得タスクの起動前に呼び、取得側のリポジトリにも戻しておく
+        bool showSavedSchedules()
+        {
+            Domain::ScheduleSnapshot saved;
+            if (!snapshotStore.load(saved))
+            {
+                return false;
+            }
+
+            applicationService.setDisplaySettings(settingsService.loadDisplaySettings());
+            applicationService.showSavedSnapshot(saved);
+
+            Serial.print("Saved schedules shown ");
+            Serial.print(millis());
+            Serial.println(" ms after boot");
+            return true;
+        }
+
+        // 取得タスクが公開した結果を画面に反映し、次回の更新時刻を決める
+        void processFetchResult()
+        {
+            Domain::ScheduleSnapshot snapshot;
+            Application::ScheduleApplicationService::RefreshMetrics metrics;
+            if (!fetchTask.takeResult(snapshot, metrics))
+            {
+                return;
+            }
+
+            {
+                PowerManager::BoostScope boost;
+                applicationService.applyFetchedData(snapshot, metrics);
+            }
+            logRefreshMetrics();
+
+            appStateManager.setIsDataFetching(false);
+            appStateManager.setLastDataUpdateTime(millis());
+            scheduleNextRefresh(millis(), metrics.result);
+
+            if (!appStateManager.isAppInitialized())
+            {
+                appStateManager.setAppInitialized(true);
+                Serial.println("Application initialized successfully");
+                BootProfiler::markDataShown();
+
+                // 初期化チェックを止め、時刻表示の更新を始める
+                unsigned long currentMillis = millis();
+                eventScheduler.cancel(Application::AppEvent::INITIALIZE_CHECK);
+                scheduleNextTimeDisplay(currentMillis);
+                updatePowerMode();
+            }
+        }
+
+        // 起動後に初めて時刻が同期されたら、未同期の間に決めたタイマーを時刻に合わせ直す
+        // 同期前に取得を終えた場合、更新時刻は再試行扱い、時刻表示は一定間隔になっている
+        void processTimeSynced(unsigned long currentMillis)
+        {
+            if (timeSynced)
+            {
+                return;
+            }
+            timeSynced = true;
+            BootProfiler::mark("time_synced");
+            Serial.println("Time synchronized");
+
+            if (!appStateManager.isAppInitialized())
+            {
+                // 初期化の完了時に同期済みの時刻でタイマーを決める
+                return;
+            }
+
+            // 失敗後の再試行はバックオフの時刻のまま待つ（境界に合わせ直すと失敗回数が数えられない）
+            Application::ScheduleApplicationService::RefreshResult lastResult =
+                applicationService.getLastRefreshMetrics().result;
+            if (!fetchTask.isFetching() && lastResult != Application::ScheduleApplicationService::RefreshResult::FAILED)
+            {
+                scheduleNextRefresh(currentMillis, lastResult);
+            }
+
+            if (wifiConnectionManager.isConnectionCompleted())
+            {
+                applicationService.updateTimeDisplay();
+                appStateManager.setLastTimeDisplayUpdateTime(currentMillis);
+            }
+            scheduleNextTimeDisplay(currentMillis);
+        }
+
+        // 表示は分までなので、分が変わった直後にだけ時刻表示を更新する
+        // 時刻が未同期の場合は境界が分からないため、一定間隔で更新する
+        void scheduleNextTimeDisplay(unsigned long currentMillis)
+        {
+            struct timeval now;
+            struct tm timeinfo;
+            gettimeofday(&now, nullptr);
+            localtime_r(&now.tv_sec, &timeinfo);
+
+            unsigned long delayMillis = appStateManager.getTimeDisplayUpdateInterval();
+            if (timeinfo.tm_year + 1900 >= 2020)
+            {
+                // タイムゾーンのずれは分単位なので、ローカル時刻の分の境界はUNIX時間の分の境界と一致する
+                unsigned long millisIntoMinute = (unsigned long)(now.tv_sec % 60) * 1000 + now.tv_usec / 1000;
+                delayMillis = 60000 - millisIntoMinute + CLOCK_TICK_MARGIN;
+            }
+
+            eventScheduler.scheduleAfter(Application::AppEvent::TIME_DISPLAY, currentMillis, delayMillis);
+        }
+
+        // 初期化済みで接続している間は、次の時刻表示かデータ更新まで省電力モードで待つ
+        // 接続待ちやキャプティブポータルの間は応答性を優先する
+        void updatePowerMode()
+        {
+            if (appStateManager.isAppInitialized() && wifiConnectionManager.isConnectionCompleted())
+            {
+                PowerManager::enterPowerSave();
+            }
+            else
+            {
+                PowerManager::exitPowerSave();
+            }
+        }
+
+        // 初期化が終わるまで、接続の完了を確認して初期データの取得を始める
+        void processInitializeCheck(unsigned long currentMillis)
+        {
+            processFetchResult();
+
+            if (appStateManager.isAppInitialized() || appStateManager.getIsDataFetching())
+            {
+                return;
+            }
+
+            // 接続状態が変わったときだけ初期化を試行
+            static bool lastConnectionState = false;
+            bool currentConnectionState = wifiConnectionManager.isConnectionCompleted();
+
+            if (currentConnectionState && !lastConnectionState)
+            {
+                tryInitializeApp();
+            }
+
+            lastConnectionState = currentConnectionState;
+            appStateManager.setLastInitializeCheckTime(currentMillis);
+
+            // データが取得中かつ初期化されていない場合のデータ取得処理
+            processDataFetching();
+
+            // 取得前に接続が切れてリセットされた場合はWiFi処理を再開する
+            updateWiFiProcessTimer(currentMillis);
+        }
+
+        // スロット境界（または再試行時刻）に達したら取得タスクに更新を要求
+        // 取得中も時刻表示の更新は続け、結果はFETCH_COMPLETEDで反映する
+        void processRefreshDue(unsigned long currentMillis)
+        {
+            if (!refreshScheduler.isRefreshDue(currentMillis))
+            {
+                scheduleRefreshTimer(currentMillis);
+                return;
+            }
+
+            if (!appStateManager.isAppInitialized() ||
+                !wifiConnectionManager.isConnectionCompleted() ||
+                fetchTask.isFetching())
+            {
+                // 接続が戻るか取得が終わるまで、初期化チェックの間隔で待つ
+                eventScheduler.scheduleAfter(Application::AppEvent::REFRESH_DUE, currentMillis,
+                                             appStateManager.getInitializeCheckInterval());
+                return;
+            }
+
+            Serial.println("Updating all schedule data...");
+            // アプリが初期化済みの場合、バックグラウンド更新モードを使用する
+            displayService.showLoadingMessage("Updating data...", true);
+            appStateManager.setIsDataFetching(true);
+            fetchTask.requestFetch();
+        }
+
+        // RefreshSchedulerが決めた次回の更新時刻にタイマーを合わせる
+        void scheduleRefreshTimer(unsigned long currentMillis)
+        {
+            unsigned long delayMillis = refreshScheduler.isRefreshDue(currentMillis)
+                                            ? 0
+                                            : refreshScheduler.getNextRefreshMillis() - currentMillis;
+            eventScheduler.scheduleAfter(Application::AppEvent::REFRESH_DUE, currentMillis, delayMillis);
+        }
+
+        // 接続が完了するまではWiFi処理を周期実行し、完了後はWiFiイベントの通知だけで処理する
+        // キャプティブポータル表示中はDNSとWebサーバーのために間隔を短くする
+        void updateWiFiProcessTimer(unsigned long currentMillis)
+        {
+            if (wifiConnectionManager.isConnectionCompleted())
+            {
+                eventScheduler.cancel(Application::AppEvent::WIFI_POLL);
+                return;
+            }
+
+            Application::WiFiConnectionState state = wifiConnectionManager.getConnectionState();
+            unsigned long interval = appStateManager.getWifiProcessInterval();
+            if (state == Application::WiFiConnectionState::PORTAL_ACTIVE ||
+                state == Application::WiFiConnectionState::PORTAL_WITH_CONNECTION)
+            {
+                interval = PORTAL_PROCESS_INTERVAL;
+            }
+
+            // 間隔が変わらない場合は周期を保つ
+            if (eventScheduler.getPeriod(Application::AppEvent::WIFI_POLL) != interval)
+            {
+                eventScheduler.scheduleEvery(Application::AppEvent::WIFI_POLL, currentMillis, interval);
+            }
+        }
+
+        // 直近のデータ更新の計測値を1行のJSONとして出力する
+        // 行頭の"METRICS "で検索してログから抽出し、解析・描画の性能低下を比較できるようにする
+        void logRefreshMetrics()
+        {
+            const Application::ScheduleApplicationService::RefreshMetrics &metrics =
+                applicationService.getLastRefreshMetrics();
+
+            char line[384]; // 全項目が最大桁でも収まる大きさ
+            snprintf(line, sizeof(line),
+                     "METRICS {\"fetch_ms\":%lu,\"parse_ms\":%lu,\"render_ms\":%lu,"
+                     "\"requests\":%lu,\"handshakes\":%lu,\"json_peak\":%lu,\"heap_fallbacks\":%lu,\"updated\":%s,"
+                     "\"pixels\":%lu,\"bytes\":%lu,\"direct_draws\":%lu,\"loop_awake_pct\":%.1f,"
+                     "\"free_heap\":%lu,\"min_free_heap\":%lu,\"max_alloc_heap\":%lu}",
+                     metrics.fetchMillis,
+                     metrics.updateStats.parseMillis,
+                     metrics.renderMillis,
+                     metrics.updateStats.requestCount,
+                     metrics.updateStats.handshakeCount,
+                     metrics.updateStats.jsonPeakBytes,
+                     metrics.updateStats.heapFallbacks,
+                     metrics.updated ? "true" : "false",
+                     metrics.pixelsPushed,
+                     metrics.pixelsPushed * 2, // RGB565は1ピクセル2バイト
+                     metrics.directDraws,
+                     PowerManager::takeDutyCyclePercent(), // 前回の更新からloopタスクが起きていた割合（取得タスクは含まない）
+                     (unsigned long)ESP.getFreeHeap(),
+                     (unsigned long)ESP.getMinFreeHeap(),
+                     (unsigned long)ESP.getMaxAllocHeap());
+            Serial.println(line);
+        }
+
+        // 取得したスケジュールの終了時刻から次回の更新時刻を決める
+        // 取得に失敗した場合は、保持しているスロットが有効でもバックオフで再試行する
+        void scheduleNextRefresh(unsigned long currentMillis,
+                                 Application::ScheduleApplicationService::RefreshResult result)
+        {
+            if (result == Application::ScheduleApplicationService::RefreshResult::FAILED)
+            {
+                refreshScheduler.scheduleRetry(currentMillis);
+                Serial.print("Schedule fetch failed. Retry #");
+                Serial.print(refreshScheduler.getFailureCount());
+                Serial.print(" in ");
+                Serial.print((refreshScheduler.getNextRefreshMillis() - currentMillis) / 1000);
+                Serial.println("s");
+                scheduleRefreshTimer(currentMillis);
+                return;
+            }
+
+            time_t now;
+            struct tm timeinfo;
+            time(&now);
+            localtime_r(&now, &timeinfo);
+
+            // 時刻が未同期の場合は境界を計算できないため再試行扱いにする
+            long secondsUntilBoundary = 0;
+            if (timeinfo.tm_year + 1900 >= 2020)
+            {
+                secondsUntilBoundary = applicationService.getSecondsUntilNextSlotChange(now);
+            }
+
+            if (secondsUntilBoundary > 0)
+            {
+                refreshScheduler.scheduleAtBoundary(currentMillis, secondsUntilBoundary);
+            }
+            else
+            {
+                // 取得できたが、APIがまだ切り替わっていない（または時刻が未同期）
+                refreshScheduler.scheduleRetry(currentMillis);
+                Serial.print("Schedule data is missing or stale. Retry #");
+                Serial.print(refreshScheduler.getFailureCount());
+                Serial.print(" ");
+            }
+
+            Serial.print("Next data update in ");
+            Serial.print((refreshScheduler.getNextRefreshMillis() - currentMillis) / 1000);
+            Serial.println("s");
+
+            scheduleRefreshTimer(currentMillis);
+        }
+
         // データ取得処理
         void processDataFetching()
         {
-            if (appStateManager.getIsDataFetching() && !appStateManager.isAppInitialized())
+            if (appStateManager.getIsDataFetching() && !appStateManager.isAppInitialized() && !fetchTask.isFetching())
             {
                 // データフェッチ前に再度接続確認
                 if (wifiConnectionManager.getConnectionState() == Application::WiFiConnectionState::CONNECTED)
                 {
-                    // WiFi接続を安定化
-                    WiFi.setAutoReconnect(true);
-                    delay(300);
-
-                    // 接続状態を再確認
-                    if (wifiConnectionManager.getConnectionState() == Application::WiFiConnectionState::CONNECTED)
-                    {
-                        Serial.println("WiFi接続が安定しています。データ取得を開始します...");
-                        applicationService.updateAllData();
-                        appStateManager.setAppInitialized(true);
-                        appStateManager.setIsDataFetching(false);
-                        Serial.println("Application initialized successfully");
-                    }
-                    else
-                    {
-                        // 接続が不安定になった場合
-                        Serial.println("WiFi connection became unstable. Retrying...");
-                        appStateManager.setIsDataFetching(false);
-                        wifiConnectionManager.resetConnectionState();
-                    }
+                    Serial.println("WiFi接続を確認しました。データ取得を開始します...");
+                    BootProfiler::mark("fetch_requested");
+                    fetchTask.requestFetch();
                 }
                 else
                 {
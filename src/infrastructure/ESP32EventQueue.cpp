@@ -0,0 +1,86 @@
+// ESP32EventQueue.cpp
+// メインループへのイベントキューの実装
+
+#include "ESP32EventQueue.h"
+
+namespace Infrastructure
+{
+    ESP32EventQueue::ESP32EventQueue() : queue(nullptr)
+    {
+    }
+
+    bool ESP32EventQueue::begin()
+    {
+        if (queue != nullptr)
+        {
+            return true;
+        }
+
+        queue = xQueueCreate(LENGTH, sizeof(Application::AppEvent));
+        if (queue == nullptr)
+        {
+            Serial.println("Failed to create the event queue; the loop falls back to timed waits");
+            return false;
+        }
+
+        return true;
+    }
+
+    bool ESP32EventQueue::post(Application::AppEvent event)
+    {
+        if (queue == nullptr)
+        {
+            return false;
+        }
+
+        return xQueueSend(queue, &event, 0) == pdTRUE;
+    }
+
+    bool ESP32EventQueue::postFromISR(Application::AppEvent event)
+    {
+        if (queue == nullptr)
+        {
+            return false;
+        }
+
+        BaseType_t higherPriorityTaskWoken = pdFALSE;
+        bool sent = xQueueSendFromISR(queue, &event, &higherPriorityTaskWoken) == pdTRUE;
+        if (higherPriorityTaskWoken == pdTRUE)
+        {
+            portYIELD_FROM_ISR();
+        }
+        return sent;
+    }
+
+    void ESP32EventQueue::waitAndCollect(Application::EventScheduler &scheduler, unsigned long timeoutMillis)
+    {
+        if (queue == nullptr)
+        {
+            // キューがない場合はイベントに気付けないため、待ち時間を短く抑える
+            delay(timeoutMillis < 10 ? timeoutMillis : 10);
+            return;
+        }
+
+        TickType_t ticks = timeoutMillis == Application::EventScheduler::NO_DEADLINE
+                               ? portMAX_DELAY
+                               : pdMS_TO_TICKS(timeoutMillis);
+
+        // 期限が1ティック未満の場合も取りこぼさないよう、少なくとも1ティックは待つ
+        if (timeoutMillis > 0 && ticks == 0)
+        {
+            ticks = 1;
+        }
+
+        Application::AppEvent event;
+        if (xQueueReceive(queue, &event, ticks) != pdTRUE)
+        {
+            return;
+        }
+
+        scheduler.post(event);
+        while (xQueueReceive(queue, &event, 0) == pdTRUE)
+        {
+            scheduler.post(event);
+        }
+    }
+}
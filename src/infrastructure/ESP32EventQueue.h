@@ -0,0 +1,42 @@
+// ESP32EventQueue.h
+// 他のタスクや割り込みからメインループへイベントを渡すFreeRTOSキュー
+
+#ifndef ESP32_EVENT_QUEUE_H
+#define ESP32_EVENT_QUEUE_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include "../application/EventScheduler.h"
+
+namespace Infrastructure
+{
+    // Carries AppEvents from the WiFi event task, the fetch task, the UART driver
+    // and ISRs to the loop task, which blocks here until the scheduler's next
+    // deadline instead of polling.
+    class ESP32EventQueue
+    {
+    public:
+        // 同じ種類のイベントはスケジューラでまとめられるため、種類数の倍あれば足りる
+        static constexpr UBaseType_t LENGTH = static_cast<UBaseType_t>(Application::AppEvent::COUNT) * 2;
+
+        ESP32EventQueue();
+
+        // キューを作成する（失敗した場合、waitは時間待ちだけを行う）
+        bool begin();
+
+        // イベントを送る（どのタスクからでも呼べる。キューが満杯なら捨ててfalse）
+        bool post(Application::AppEvent event);
+
+        // 割り込みハンドラからイベントを送る
+        bool postFromISR(Application::AppEvent event);
+
+        // 最大timeoutMillisの間イベントを待ち、届いたものをすべてスケジューラに渡す
+        void waitAndCollect(Application::EventScheduler &scheduler, unsigned long timeoutMillis);
+
+    private:
+        QueueHandle_t queue;
+    };
+}
+
+#endif // ESP32_EVENT_QUEUE_H
@@ -1,12 +1,21 @@
 #include "ESP32NetworkService.h"
+#include "PowerManager.h"
 #include <time.h>
 
 namespace Infrastructure
 {
+    ESP32NetworkService::ESP32NetworkService()
+    {
+        // 証明書の検証は従来のHTTPClientと同様に行わない
+        for (Connection &connection : connections)
+        {
+            connection.secureClient.setInsecure();
+        }
+    }
 
     bool ESP32NetworkService::connect(const char *ssid, const char *password)
     {
-        WiFi.begin(ssid, password);
+        PowerManager::beginStation(ssid, password);
 
         // Wait for connection with timeout
         int attempts = 0;
@@ -43,58 +52,176 @@ namespace Infrastructure
 
     String ESP32NetworkService::httpGet(const char *url)
     {
-        if (!isConnected())
+        String payload;
+
+        bool received = httpGetStream(
+            url,
+            [&payload](Stream &stream)
+            {
+                // レスポンスサイズを制限しながら読み込む
+                char buffer[128];
+                size_t count;
+                while ((count = stream.readBytes(buffer, sizeof(buffer))) > 0)
+                {
+                    if (payload.length() + count > MAX_RESPONSE_SIZE) // 16KB制限
+                    {
+                        Serial.println("Response too large");
+                        return false;
+                    }
+                    payload.concat(buffer, count);
+                }
+                return true;
+            });
+
+        if (!received)
         {
             return "";
         }
 
-        HTTPClient http;
-        http.begin(url);
-        
-        // タイムアウト設定を追加
-        http.setTimeout(10000); // 10秒タイムアウト
+        // メモリ使用量のデバッグ情報
+        Serial.print("HTTP Response size: ");
+        Serial.print(payload.length());
+        Serial.println(" bytes");
+
+        return payload;
+    }
+
+    bool ESP32NetworkService::httpGetStream(const char *url, const StreamHandler &handler)
+    {
+        if (!isConnected())
+        {
+            return false;
+        }
+
+        // 接続を保持しているクライアントでリクエスト（同じホストならTLSハンドシェイクを省略）
+        bool handlerResult = false;
+        int httpCode = connections[0].httpClient.get(url, handler, handlerResult);
+
+        if (httpCode != 200)
+        {
+            Serial.print("HTTP Error: ");
+            Serial.println(httpCode);
+            return false;
+        }
+
+        return handlerResult;
+    }
+
+    Application::NetworkService::FetchResult ESP32NetworkService::httpGetStreamIfModified(
+        const char *url,
+        CacheValidators &validators,
+        const StreamHandler &handler)
+    {
+        if (!isConnected())
+        {
+            return FetchResult::FAILED;
+        }
 
-        int httpCode = http.GET();
+        bool handlerResult = false;
+        int httpCode = connections[0].httpClient.get(url, handler, handlerResult, &validators);
+        return toFetchResult(httpCode, handlerResult);
+    }
 
-        if (httpCode == HTTP_CODE_OK)
+    bool ESP32NetworkService::startHttpGetIfModified(
+        const char *url,
+        CacheValidators &validators,
+        const StreamHandler &handler,
+        const CompletionHandler &onComplete)
+    {
+        if (!isConnected())
         {
-            // レスポンスサイズをチェックしてメモリ使用量を制限
-            int contentLength = http.getSize();
-            if (contentLength > 0 && contentLength > 16384) // 16KB制限
+            return false;
+        }
+
+        // 空いている接続に割り当てる（全て使用中の場合は呼び出し元が後で再試行する）
+        for (Connection &connection : connections)
+        {
+            if (connection.httpClient.isBusy())
             {
-                Serial.print("Response too large: ");
-                Serial.print(contentLength);
-                Serial.println(" bytes");
-                http.end();
-                return "";
+                continue;
             }
-            
-            String payload = http.getString();
-            http.end();
-            
-            // メモリ使用量のデバッグ情報
-            Serial.print("HTTP Response size: ");
-            Serial.print(payload.length());
-            Serial.println(" bytes");
-            
-            return payload;
+
+            return connection.httpClient.start(
+                url,
+                handler,
+                &validators,
+                [onComplete](int httpCode, bool handlerResult)
+                {
+                    onComplete(toFetchResult(httpCode, handlerResult));
+                });
         }
-        else
+
+        return false;
+    }
+
+    bool ESP32NetworkService::poll()
+    {
+        // 各接続を1段階ずつ進め、応答の届いた順に完了させる
+        bool inFlight = false;
+        for (Connection &connection : connections)
+        {
+            if (connection.httpClient.poll())
+            {
+                inFlight = true;
+            }
+        }
+        return inFlight;
+    }
+
+    Application::NetworkService::FetchResult ESP32NetworkService::toFetchResult(int httpCode, bool handlerResult)
+    {
+        if (httpCode == 304)
+        {
+            Serial.println("HTTP 304 Not Modified");
+            return FetchResult::NOT_MODIFIED;
+        }
+
+        if (httpCode != 200)
         {
             Serial.print("HTTP Error: ");
             Serial.println(httpCode);
-            http.end();
-            return "";
+            return FetchResult::FAILED;
+        }
+
+        return handlerResult ? FetchResult::UPDATED : FetchResult::FAILED;
+    }
+
+    Application::NetworkService::ConnectionStats ESP32NetworkService::getConnectionStats()
+    {
+        ConnectionStats stats;
+        for (Connection &connection : connections)
+        {
+            stats.requestCount += connection.httpClient.getRequestCount();
+            stats.handshakeCount += connection.httpClient.getHandshakeCount();
+            stats.requestBytes += connection.httpClient.getRequestBytes();
+            stats.headerBytes += connection.httpClient.getHeaderBytes();
+            stats.bodyBytes += connection.httpClient.getBodyBytes();
+        }
+        return stats;
+    }
+
+    void ESP32NetworkService::resetConnectionStats()
+    {
+        for (Connection &connection : connections)
+        {
+            connection.httpClient.resetStats();
+        }
+    }
+
+    void ESP32NetworkService::closeConnections()
+    {
+        // 保持中のTLS接続を閉じてバッファを解放
+        for (Connection &connection : connections)
+        {
+            connection.httpClient.close();
         }
     }
 
     void ESP32NetworkService::configureTimeService()
     {
         // Configure time service with Japan timezone (UTC+9)
+        // 同期はWiFi接続後に裏で完了し、SNTPの同期通知（AppEvent::TIME_SYNCED）で知らせる
         configTime(9 * 3600, 0, "ntp.nict.jp", "ntp.jst.mfeed.ad.jp");
-
-        // Wait for time to be set
-        delay(1000);
     }
 
     bool ESP32NetworkService::getLocalTime(struct tm &timeinfo)
@@ -5,8 +5,9 @@
 #define ESP32_NETWORK_SERVICE_H
 
 #include <WiFi.h>
-#include <HTTPClient.h>
+#include <WiFiClientSecure.h>
 #include "../application/NetworkService.h"
+#include "KeepAliveHttpClient.h"
 
 namespace Infrastructure
 {
@@ -15,6 +16,8 @@ namespace Infrastructure
     class ESP32NetworkService : public Application::NetworkService
     {
     public:
+        ESP32NetworkService();
+
         // Connect to WiFi network
         bool connect(const char *ssid, const char *password) override;
 
@@ -27,6 +30,34 @@ namespace Infrastructure
         // Perform HTTP GET request and return response body
         String httpGet(const char *url) override;
 
+        // Perform HTTP GET request and stream the response body to the handler
+        bool httpGetStream(const char *url, const StreamHandler &handler) override;
+
+        // Perform a conditional HTTP GET with If-None-Match / If-Modified-Since
+        FetchResult httpGetStreamIfModified(
+            const char *url,
+            CacheValidators &validators,
+            const StreamHandler &handler) override;
+
+        // Start a conditional HTTP GET that is advanced by poll()
+        bool startHttpGetIfModified(
+            const char *url,
+            CacheValidators &validators,
+            const StreamHandler &handler,
+            const CompletionHandler &onComplete) override;
+
+        // Advance every in-flight request by one step
+        bool poll() override;
+
+        // Get request and TLS handshake counts since the last reset
+        ConnectionStats getConnectionStats() override;
+
+        // Reset request and TLS handshake counts
+        void resetConnectionStats() override;
+
+        // Close kept-alive connections and release their TLS buffers
+        void closeConnections() override;
+
         // Configure time service (NTP)
         void configureTimeService() override;
 
@@ -37,6 +68,28 @@ namespace Infrastructure
         bool getLastUpdateTime(char *buffer, size_t bufferSize) override;
 
     private:
+        // 同時に処理できるリクエスト数
+        // TLS接続1本ごとにmbedTLSの送受信バッファ（約40KB）を確保するため、ヒープに収まる本数に抑える
+        static constexpr size_t MAX_CONCURRENT_REQUESTS = 2;
+
+        // 接続を使い回すHTTPクライアントと、その下のTLS接続の組
+        struct Connection
+        {
+            WiFiClientSecure secureClient;
+            KeepAliveHttpClient httpClient;
+
+            Connection() : httpClient(secureClient) {}
+        };
+
+        // 同期リクエストは先頭の接続を使い、非同期リクエストは空いている接続に割り当てる
+        Connection connections[MAX_CONCURRENT_REQUESTS];
+
+        // レスポンスサイズの上限（16KB）
+        static constexpr unsigned int MAX_RESPONSE_SIZE = 16384;
+
+        // ステータスコードとハンドラの結果から条件付きリクエストの結果を決める
+        static FetchResult toFetchResult(int httpCode, bool handlerResult);
+
         // Helper method to get local time struct
         bool getLocalTime(struct tm &timeinfo);
     };
@@ -43,12 +43,27 @@ namespace Infrastructure
         {
         }
 
+        // 保存済みの設定があれば、画面を変えずに接続を始める
+        bool startConnecting() override
+        {
+            // TCP/IPスタックを起動しておき、接続前でもNTPを設定できるようにする
+            WiFi.mode(WIFI_STA);
+
+            Domain::WiFiSettings wifiSettings;
+            if (!wifiService.loadSettings(wifiSettings) || !wifiSettings.isValid())
+            {
+                return false;
+            }
+
+            return wifiService.beginConnect(wifiSettings);
+        }
+
         // WiFi接続の初期セットアップ
         void setupWiFiConnection() override
         {
-            // WiFi状態の初期化
+            // WiFi状態の初期化（startConnectingで始めた接続はそのまま続く）
+            // モードの切り替えは同期的に終わるため、安定化の待ち時間は入れない
             WiFi.mode(WIFI_STA);
-            delay(500);
 
             // 現在のWiFi接続状態を確認
             if (WiFi.status() == WL_CONNECTED)
@@ -111,7 +126,7 @@ namespace Infrastructure
                 portalMessage += AP_SSID;
                 portalMessage += "\nIP: " + apIP;
                 portalMessage += "\nConnecting in 15s...";
-                displayService.showConnectionStatus(false, portalMessage.c_str());
+                showProgressStatus(false, portalMessage.c_str());
 
                 // 表示時間と状態フラグを設定
                 appStateManager.setWifiSettingDisplayTime(millis());
@@ -148,7 +163,7 @@ namespace Infrastructure
             String connectingMessage = "Connecting to WiFi";
             connectingMessage += "\nSSID: " + ssid;
             connectingMessage += "\nPlease wait...";
-            displayService.showConnectionStatus(false, connectingMessage.c_str());
+            showProgressStatus(false, connectingMessage.c_str());
 
             // 接続開始
             bool result = wifiService.connect(wifiSettings);
@@ -240,6 +255,12 @@ namespace Infrastructure
             // ポータルへの接続がある場合
             if (hasPortalConnection)
             {
+                // 裏で進めている接続が完了するとAPのチャンネルが変わり、設定中の端末が切断されるため止める
+                if (!isConnected && (WiFi.getMode() & WIFI_STA) && WiFi.status() != WL_DISCONNECTED)
+                {
+                    WiFi.disconnect();
+                }
+
                 // 設定中画面を表示
                 String apIP = WiFi.softAPIP().toString();
                 String portalMessage = "WiFi Setup in Progress";
@@ -311,12 +332,26 @@ namespace Infrastructure
                 portalMessage += "\nSSID: ESP32-Splatoon3-Schedule";
                 portalMessage += "\nIP: " + apIP;
                 portalMessage += "\nConnecting in " + String(remainingSeconds) + "s...";
-                displayService.showConnectionStatus(false, portalMessage.c_str());
+                showProgressStatus(false, portalMessage.c_str());
 
                 lastDisplayedSeconds = remainingSeconds;
             }
         }
 
+        // 接続の進行状況を表示する
+        // スケジュール画面（起動直後に表示した保存済みのスケジュールを含む）を表示している間は、
+        // 画面を覆わずに更新インジケータとシリアルログだけで示す
+        void showProgressStatus(bool connected, const char *message)
+        {
+            if (displayService.isShowingSchedules())
+            {
+                displayService.showLoadingMessage(message, true);
+                return;
+            }
+
+            displayService.showConnectionStatus(connected, message);
+        }
+
         // 接続成功状態の表示
         void showConnectedStatus()
         {
@@ -326,10 +361,7 @@ namespace Infrastructure
             connectingMessage += "\nSSID: " + ssid;
             connectingMessage += "\nIP: " + ipAddress;
             connectingMessage += "\nPlease wait...";
-            displayService.showConnectionStatus(true, connectingMessage.c_str());
-
-            // 接続の安定化のための遅延
-            delay(500);
+            showProgressStatus(true, connectingMessage.c_str());
         }
     };
 }
@@ -3,6 +3,8 @@
 
 #include "ESP32WiFiService.h"
 #include "WiFiPortalContent.h"
+#include "MemoryManager.h"
+#include "PowerManager.h"
 #include <WiFi.h>
 #include <DNSServer.h>
 #include <WebServer.h>
@@ -32,6 +34,7 @@ namespace Infrastructure
           portalStartTime(0),
           captivePortalActive(false),
           portalConnectionDetected(false),
+          backgroundConnecting(false),
           displaySettings(Domain::DisplaySettings::createDefault()), // DisplaySettingsをデフォルト値で初期化
           portal_html(PORTAL_HTML)
     {
@@ -173,13 +176,21 @@ namespace Infrastructure
 
         Serial.println("キャプティブポータルを起動します");
 
-        // 現在の接続を切断
-        WiFi.disconnect(true);
-        delay(500);
+        if (backgroundConnecting)
+        {
+            // 裏で進めている接続は切らずにAPを追加する（接続できればポータルは閉じられる）
+            WiFi.mode(WIFI_AP_STA);
+        }
+        else
+        {
+            // 現在の接続を切断
+            WiFi.disconnect(true);
+            delay(500);
 
-        // APモードに設定
-        WiFi.mode(WIFI_AP);
-        delay(500);
+            // APモードに設定
+            WiFi.mode(WIFI_AP);
+            delay(500);
+        }
 
         // AP IP設定
         bool configSuccess = WiFi.softAPConfig(AP_IP, AP_GATEWAY, AP_SUBNET);
@@ -259,8 +270,9 @@ namespace Infrastructure
         // Webサーバーを停止
         webServer.stop();
 
-        // APモードを停止
+        // APモードを停止（APとSTAを併用している場合はSTAだけが残る）
         WiFi.softAPdisconnect(true);
+        backgroundConnecting = false;
 
         // フラグ更新
         captivePortalActive = false;
@@ -286,7 +298,8 @@ namespace Infrastructure
             delay(1000); // 停止処理の完了を待つ時間を長めに
         }
 
-        // WiFiモードを明示的にSTAに設定
+        // WiFiモードを明示的にSTAに設定（裏で進めていた接続はここでやり直す）
+        backgroundConnecting = false;
         WiFi.mode(WIFI_STA);
         delay(500); // WiFiモード変更の安定化を待つ
 
@@ -300,6 +313,81 @@ namespace Infrastructure
         delay(200);
 
         // 静的IP設定（必要な場合）
+        applyIpSettings(settings);
+
+        // WiFi接続を開始
+        Serial.print("WiFiに接続します: ");
+        Serial.println(settings.getSsid());
+
+        // WiFi設定
+        WiFi.setAutoReconnect(true);
+        WiFi.persistent(true);
+
+        // WiFi接続開始（省電力モード用のlisten_intervalを設定してから接続する）
+        PowerManager::beginStation(settings.getSsid().c_str(), settings.getPassword().c_str());
+
+        lastConnectionAttempt = millis();
+        state = WiFiState::CONNECTING;
+
+        // 接続試行の開始後、十分に待機して接続を確認
+        Serial.println("接続の確立を待機中...");
+
+        // 接続の成功を最大5秒間待機（一般的なWiFi接続は数秒で完了する）
+        int attempts = 0;
+        while (attempts < 10 && WiFi.status() != WL_CONNECTED)
+        {
+            delay(500);
+            Serial.print(".");
+            attempts++;
+        }
+        Serial.println();
+
+        // 接続状態の最終確認
+        if (WiFi.status() == WL_CONNECTED)
+        {
+            Serial.println("WiFi接続に成功しました");
+            Serial.print("IP: ");
+            Serial.println(WiFi.localIP());
+            state = WiFiState::CONNECTED;
+            return true;
+        }
+
+        // この時点では接続は進行中または失敗
+        Serial.println("接続待機後もWiFi接続できていません。接続プロセスを継続します...");
+        return false;
+    }
+
+    // WiFiへの接続を始め、完了を待たずに戻る
+    // 起動時に画面の表示と並行して接続するために使い、完了はWiFiイベントと接続状態の確認で知る
+    bool ESP32WiFiService::beginConnect(const Domain::WiFiSettings &settings)
+    {
+        if (!settings.isValid())
+        {
+            Serial.println("無効なWiFi設定です");
+            return false;
+        }
+
+        // モードの切り替えは同期的に終わるため、安定化の待ち時間は入れない
+        WiFi.mode(captivePortalActive ? WIFI_AP_STA : WIFI_STA);
+        applyIpSettings(settings);
+        WiFi.setAutoReconnect(true);
+
+        Serial.print("WiFiへの接続を開始します（完了を待たずに続行）: ");
+        Serial.println(settings.getSsid());
+        PowerManager::beginStation(settings.getSsid().c_str(), settings.getPassword().c_str());
+
+        lastConnectionAttempt = millis();
+        backgroundConnecting = true;
+        if (!captivePortalActive)
+        {
+            state = WiFiState::CONNECTING;
+        }
+        return true;
+    }
+
+    // 静的IP設定を適用する（DHCPの場合は何もしない）
+    void ESP32WiFiService::applyIpSettings(const Domain::WiFiSettings &settings)
+    {
         if (!settings.getDhcp())
         {
             Serial.println("静的IP設定を使用します");
@@ -345,47 +433,6 @@ namespace Infrastructure
         {
             Serial.println("DHCPを使用します");
         }
-
-        // WiFi接続を開始
-        Serial.print("WiFiに接続します: ");
-        Serial.println(settings.getSsid());
-
-        // WiFi設定
-        WiFi.setAutoReconnect(true);
-        WiFi.persistent(true);
-
-        // WiFi接続開始
-        WiFi.begin(settings.getSsid().c_str(), settings.getPassword().c_str());
-
-        lastConnectionAttempt = millis();
-        state = WiFiState::CONNECTING;
-
-        // 接続試行の開始後、十分に待機して接続を確認
-        Serial.println("接続の確立を待機中...");
-
-        // 接続の成功を最大5秒間待機（一般的なWiFi接続は数秒で完了する）
-        int attempts = 0;
-        while (attempts < 10 && WiFi.status() != WL_CONNECTED)
-        {
-            delay(500);
-            Serial.print(".");
-            attempts++;
-        }
-        Serial.println();
-
-        // 接続状態の最終確認
-        if (WiFi.status() == WL_CONNECTED)
-        {
-            Serial.println("WiFi接続に成功しました");
-            Serial.print("IP: ");
-            Serial.println(WiFi.localIP());
-            state = WiFiState::CONNECTED;
-            return true;
-        }
-
-        // この時点では接続は進行中または失敗
-        Serial.println("接続待機後もWiFi接続できていません。接続プロセスを継続します...");
-        return false;
     }
 
     // WiFiの接続状態を確認する
@@ -539,6 +586,10 @@ namespace Infrastructure
         webServer.on("/save", HTTP_POST, [this]()
                      { this->handleWiFiSave(); });
 
+        // メモリ統計API
+        webServer.on("/memory", HTTP_GET, [this]()
+                     { this->handleMemory(); });
+
         // 404ハンドラ（すべてをルートページにリダイレクト）
         webServer.onNotFound([this]()
                              { this->handleNotFound(); });
@@ -549,6 +600,8 @@ namespace Infrastructure
     // ルートページを処理する
     void ESP32WiFiService::handleRoot()
     {
+        MemoryManager::PhaseScope portalScope(MemoryManager::Phase::PORTAL);
+
         // ページへのアクセスを検出
         portalConnectionDetected = true;
         Serial.println("キャプティブポータルにアクセスがありました");
@@ -562,6 +615,8 @@ namespace Infrastructure
     // 404リクエストを処理する（すべてルートにリダイレクト）
     void ESP32WiFiService::handleNotFound()
     {
+        MemoryManager::PhaseScope portalScope(MemoryManager::Phase::PORTAL);
+
         // 404ページへのアクセスも検出
         portalConnectionDetected = true;
         Serial.println("未登録のパスへのリクエストをリダイレクト: " + webServer.uri());
@@ -573,6 +628,8 @@ namespace Infrastructure
     // WiFiスキャン結果をJSONで返す
     void ESP32WiFiService::getWiFiScanJson()
     {
+        MemoryManager::PhaseScope portalScope(MemoryManager::Phase::PORTAL);
+
         // WiFiスキャンAPIへのアクセスを検出
         portalConnectionDetected = true;
         Serial.println("WiFiスキャンAPIにアクセスがありました");
@@ -636,9 +693,20 @@ namespace Infrastructure
         WiFi.scanDelete();
     }
 
+    // メモリ統計をJSON形式で返す
+    void ESP32WiFiService::handleMemory()
+    {
+        MemoryManager::PhaseScope portalScope(MemoryManager::Phase::PORTAL);
+
+        webServer.sendHeader("Cache-Control", "no-cache, no-store, must-revalidate");
+        webServer.send(200, "application/json", MemoryManager::buildReportJson());
+    }
+
     // 設定情報をJSON形式で返す
     void ESP32WiFiService::handleSettings()
     {
+        MemoryManager::PhaseScope portalScope(MemoryManager::Phase::PORTAL);
+
         // 表示設定情報の取得
         Domain::DisplaySettings displaySettings = Domain::DisplaySettings::createDefault();
         loadDisplaySettings(displaySettings);
@@ -718,6 +786,8 @@ namespace Infrastructure
     // WiFi設定の保存を処理する
     void ESP32WiFiService::handleWiFiSave()
     {
+        MemoryManager::PhaseScope portalScope(MemoryManager::Phase::PORTAL);
+
         // 設定保存APIへのアクセスを検出
         portalConnectionDetected = true;
         Serial.println("WiFi設定保存APIにアクセスがありました");
@@ -47,6 +47,7 @@ namespace Infrastructure
         String apPassword;
         bool captivePortalActive;
         bool portalConnectionDetected; // キャプティブポータルへの接続検出
+        bool backgroundConnecting;     // beginConnectで始めた接続をポータルと並行して続けるか
 
         // 設定保存後の再起動用フラグ
         bool settingsSaved = false;
@@ -64,10 +65,12 @@ namespace Infrastructure
         void handleRoot();
         void handleWiFiSave();
         void handleSettings();
+        void handleMemory();
         void handleNotFound();
         void getWiFiScanJson();
         void sendHeader();
         bool connectToWiFi(const Domain::WiFiSettings &settings);
+        void applyIpSettings(const Domain::WiFiSettings &settings);
 
     public:
         // コンストラクタ
@@ -100,6 +103,9 @@ namespace Infrastructure
         // WiFiに接続する
         bool connect(const Domain::WiFiSettings &settings) override;
 
+        // WiFiへの接続を始め、完了を待たずに戻る
+        bool beginConnect(const Domain::WiFiSettings &settings) override;
+
         // WiFiの接続状態を確認する
         bool isConnected() override;
 
@@ -0,0 +1,126 @@
+// JsonStreamScanner.cpp
+// ストリーム上のJSONの構造を読み進めるスキャナの実装
+
+#include "JsonStreamScanner.h"
+
+namespace Infrastructure
+{
+    bool JsonStreamScanner::nextKey(char *key, size_t keySize)
+    {
+        int c = skipSeparators();
+        if (c == '}')
+        {
+            stream.read();
+            return false;
+        }
+        if (c != '"')
+        {
+            return fail();
+        }
+        stream.read();
+
+        size_t length = 0;
+        for (;;)
+        {
+            c = peekChar();
+            if (c < 0)
+            {
+                return fail();
+            }
+            stream.read();
+            if (c == '"')
+            {
+                break;
+            }
+
+            // エスケープされた文字はそのまま1文字として扱う（比較するキーにはエスケープがない）
+            if (c == '\\')
+            {
+                c = peekChar();
+                if (c < 0)
+                {
+                    return fail();
+                }
+                stream.read();
+            }
+
+            if (length + 1 < keySize)
+            {
+                key[length++] = (char)c;
+            }
+        }
+        if (keySize > 0)
+        {
+            key[length] = '\0';
+        }
+
+        return expect(':');
+    }
+
+    bool JsonStreamScanner::nextElement()
+    {
+        int c = skipSeparators();
+        if (c < 0)
+        {
+            return fail();
+        }
+        if (c == ']')
+        {
+            stream.read();
+            return false;
+        }
+        return true;
+    }
+
+    int JsonStreamScanner::peekChar()
+    {
+        if (failed)
+        {
+            return -1;
+        }
+
+        // peek()は届いていないデータを待たないため、タイムアウトまで待ち直す
+        unsigned long start = millis();
+        for (;;)
+        {
+            int c = stream.peek();
+            if (c >= 0)
+            {
+                return c;
+            }
+            if (millis() - start >= stream.getTimeout())
+            {
+                return -1;
+            }
+            delay(1);
+        }
+    }
+
+    int JsonStreamScanner::skipSeparators()
+    {
+        for (;;)
+        {
+            int c = peekChar();
+            if (c != ' ' && c != '\t' && c != '\r' && c != '\n' && c != ',')
+            {
+                return c;
+            }
+            stream.read();
+        }
+    }
+
+    bool JsonStreamScanner::expect(char expected)
+    {
+        int c;
+        while ((c = peekChar()) == ' ' || c == '\t' || c == '\r' || c == '\n')
+        {
+            stream.read();
+        }
+        if (c != expected)
+        {
+            return fail();
+        }
+        stream.read();
+        return true;
+    }
+}
@@ -0,0 +1,66 @@
+// JsonStreamScanner.h
+// ストリーム上のJSONのオブジェクトのキーと配列の区切りだけを読み進めるスキャナ
+
+#ifndef JSON_STREAM_SCANNER_H
+#define JSON_STREAM_SCANNER_H
+
+#include <Arduino.h>
+
+namespace Infrastructure
+{
+    // Walks the structure of a JSON stream without building a document, so a large
+    // response can be deserialized one value at a time: the scanner consumes braces,
+    // brackets, keys and separators, and the caller consumes each value in between
+    // with deserializeJson. deserializeJson stops reading at the closing character of
+    // an object, array or string, but reads one character past a bare number or
+    // literal, so values handed over this way should not be bare scalars.
+    // Separators are not validated strictly; a truncated stream or an unexpected
+    // character marks the scan as failed.
+    class JsonStreamScanner
+    {
+    public:
+        explicit JsonStreamScanner(Stream &stream) : stream(stream), failed(false) {}
+
+        // オブジェクトの開始（'{'）を読む
+        bool enterObject() { return expect('{'); }
+
+        // 配列の開始（'['）を読む
+        bool enterArray() { return expect('['); }
+
+        // 次のキーを読み、値の直前（':'の後）まで進める
+        // オブジェクトの終わり（'}'）に達した場合と失敗した場合はfalse
+        // 収まらないキーは切り詰める（読み捨てる部分も最後まで読む）
+        bool nextKey(char *key, size_t keySize);
+
+        // 次の要素の直前まで進める（要素は呼び出し側が読む）
+        // 配列の終わり（']'）に達した場合と失敗した場合はfalse
+        bool nextElement();
+
+        // 構文の誤りやデータの途切れで読み進められなくなったかどうか
+        bool hasFailed() const { return failed; }
+
+        // 値を読ませるためのストリーム
+        Stream &getStream() { return stream; }
+
+    private:
+        Stream &stream;
+        bool failed;
+
+        // 次の文字を読まずに返す（届くまでストリームのタイムアウトの間待ち、途切れた場合は-1）
+        int peekChar();
+
+        // 空白と区切りの','を読み飛ばし、次の文字を返す
+        int skipSeparators();
+
+        // 空白を読み飛ばして指定した文字を読む
+        bool expect(char expected);
+
+        bool fail()
+        {
+            failed = true;
+            return false;
+        }
+    };
+}
+
+#endif // JSON_STREAM_SCANNER_H
@@ -0,0 +1,757 @@
+// KeepAliveHttpClient.cpp
+// 1本のTLS接続を使い回すHTTP/1.1クライアントの実装
+
+#include "KeepAliveHttpClient.h"
+#include <string.h>
+#include <strings.h>
+#include <stdlib.h>
+
+namespace Infrastructure
+{
+    // 1行を読み込む（末尾のCR/LFは除去）
+    // バッファに収まらない部分は読み捨てる。タイムアウト時は-1を返す
+    static int readHttpLine(Client &client, char *buffer, size_t bufferSize, unsigned long timeoutMs)
+    {
+        size_t length = 0;
+        unsigned long start = millis();
+
+        while (millis() - start < timeoutMs)
+        {
+            if (!client.available())
+            {
+                if (!client.connected())
+                {
+                    break;
+                }
+                delay(1);
+                continue;
+            }
+
+            int c = client.read();
+            if (c < 0)
+            {
+                continue;
+            }
+
+            if (c == '\n')
+            {
+                if (length > 0 && buffer[length - 1] == '\r')
+                {
+                    length--;
+                }
+                buffer[length] = '\0';
+                return (int)length;
+            }
+
+            if (length < bufferSize - 1)
+            {
+                buffer[length++] = (char)c;
+            }
+        }
+
+        buffer[length] = '\0';
+        return -1;
+    }
+
+    HttpBodyStream::HttpBodyStream(Client &source, long contentLength, bool chunked, size_t maxBytes)
+        : source(source),
+          remaining(chunked ? 0 : contentLength),
+          chunked(chunked),
+          unbounded(!chunked && contentLength < 0),
+          finished(false),
+          failed(false),
+          tooLarge(false),
+          maxBytes(maxBytes),
+          consumed(0)
+    {
+    }
+
+    int HttpBodyStream::available()
+    {
+        if (!prepare())
+        {
+            return 0;
+        }
+
+        int count = source.available();
+        if (!unbounded && count > remaining)
+        {
+            count = (int)remaining;
+        }
+        if ((size_t)count > maxBytes - consumed)
+        {
+            count = (int)(maxBytes - consumed);
+        }
+        return count;
+    }
+
+    int HttpBodyStream::read()
+    {
+        if (!prepare())
+        {
+            return -1;
+        }
+
+        int c = source.read();
+        if (c >= 0)
+        {
+            consumed++;
+            if (!unbounded)
+            {
+                remaining--;
+            }
+        }
+        return c;
+    }
+
+    int HttpBodyStream::peek()
+    {
+        if (!prepare())
+        {
+            return -1;
+        }
+        return source.peek();
+    }
+
+    size_t HttpBodyStream::readBytes(char *buffer, size_t length)
+    {
+        // ボディの終端に達したらタイムアウトを待たずに戻る
+        size_t count = 0;
+        unsigned long start = millis();
+
+        while (count < length && millis() - start < getTimeout())
+        {
+            int c = read();
+            if (c >= 0)
+            {
+                buffer[count++] = (char)c;
+                start = millis();
+            }
+            else if (finished)
+            {
+                break;
+            }
+            else
+            {
+                delay(1);
+            }
+        }
+
+        return count;
+    }
+
+    void HttpBodyStream::drain()
+    {
+        unsigned long start = millis();
+
+        while (!finished && millis() - start < getTimeout())
+        {
+            if (read() < 0)
+            {
+                delay(1);
+            }
+        }
+    }
+
+    bool HttpBodyStream::prepare()
+    {
+        if (finished)
+        {
+            return false;
+        }
+
+        // 長さ不明のボディは接続が閉じられるまで読む
+        if (unbounded)
+        {
+            if (!source.available() && !source.connected())
+            {
+                finished = true;
+                return false;
+            }
+            return withinLimit();
+        }
+
+        if (remaining > 0)
+        {
+            return withinLimit();
+        }
+
+        if (!chunked)
+        {
+            finished = true;
+            return false;
+        }
+
+        // 次のチャンクサイズ行を読む（前のチャンク末尾のCRLFは空行として読み飛ばす）
+        char line[24];
+        int length = 0;
+        for (int i = 0; i < 2 && length == 0; i++)
+        {
+            length = readHttpLine(source, line, sizeof(line), getTimeout());
+            if (length < 0)
+            {
+                failed = true;
+                finished = true;
+                return false;
+            }
+        }
+
+        remaining = strtol(line, nullptr, 16);
+        if (remaining > 0)
+        {
+            return withinLimit();
+        }
+
+        // 最後のチャンク：トレーラーを空行まで読み捨てる
+        while (readHttpLine(source, line, sizeof(line), getTimeout()) > 0)
+        {
+        }
+
+        finished = true;
+        return false;
+    }
+
+    bool HttpBodyStream::withinLimit()
+    {
+        if (consumed < maxBytes)
+        {
+            return true;
+        }
+
+        // 上限まで読んでもまだ続きがある
+        tooLarge = true;
+        failed = true;
+        finished = true;
+        return false;
+    }
+
+    KeepAliveHttpClient::KeepAliveHttpClient(Client &client)
+        : client(client),
+          connectedPort(0),
+          requestCount(0),
+          handshakeCount(0),
+          requestBytes(0),
+          headerBytes(0),
+          bodyBytes(0),
+          state(State::IDLE),
+          requestPort(0),
+          requestValidators(nullptr),
+          reusedConnection(false),
+          retried(false),
+          lastProgressMillis(0),
+          lineLength(0)
+    {
+        connectedHost[0] = '\0';
+        requestHost[0] = '\0';
+        requestPath[0] = '\0';
+    }
+
+    bool KeepAliveHttpClient::start(const char *url, const BodyHandler &handler, CacheValidators *validators,
+                                    const CompletionHandler &onComplete)
+    {
+        if (state != State::IDLE)
+        {
+            return false;
+        }
+
+        const char *path;
+        if (!parseUrl(url, requestHost, sizeof(requestHost), requestPort, path) ||
+            strlen(path) >= sizeof(requestPath))
+        {
+            return false;
+        }
+        strcpy(requestPath, path);
+
+        bodyHandler = handler;
+        completionHandler = onComplete;
+        requestValidators = validators;
+        retried = false;
+        requestCount++;
+
+        state = State::CONNECTING;
+        lastProgressMillis = millis();
+        return true;
+    }
+
+    bool KeepAliveHttpClient::poll()
+    {
+        switch (state)
+        {
+        case State::CONNECTING:
+            return stepConnect();
+        case State::SENDING:
+            return stepSend();
+        case State::READING_STATUS:
+            return stepStatus();
+        case State::READING_HEADERS:
+            return stepHeaders();
+        case State::READING_BODY:
+            return stepBody();
+        default:
+            return false;
+        }
+    }
+
+    int KeepAliveHttpClient::get(const char *url, const BodyHandler &handler, bool &handlerResult,
+                                 CacheValidators *validators)
+    {
+        handlerResult = false;
+        if (state != State::IDLE)
+        {
+            return ERROR_BUSY;
+        }
+
+        int statusCode = ERROR_CONNECTION_FAILED;
+        if (!start(url, handler, validators,
+                   [&statusCode, &handlerResult](int code, bool result)
+                   {
+                       statusCode = code;
+                       handlerResult = result;
+                   }))
+        {
+            return ERROR_INVALID_URL;
+        }
+
+        // 受信待ちの間は他のタスクに譲る
+        while (poll())
+        {
+            delay(1);
+        }
+
+        return statusCode;
+    }
+
+    void KeepAliveHttpClient::close()
+    {
+        closeConnection();
+
+        // リクエスト中なら中断する（完了は通知しない）
+        state = State::IDLE;
+        bodyHandler = nullptr;
+        completionHandler = nullptr;
+        requestValidators = nullptr;
+    }
+
+    KeepAliveHttpClient::LineResult KeepAliveHttpClient::readLine()
+    {
+        while (client.available() > 0)
+        {
+            int c = client.read();
+            if (c < 0)
+            {
+                break;
+            }
+            lastProgressMillis = millis();
+            headerBytes++;
+
+            if (c == '\n')
+            {
+                if (lineLength > 0 && line[lineLength - 1] == '\r')
+                {
+                    lineLength--;
+                }
+                line[lineLength] = '\0';
+                return LineResult::READY;
+            }
+
+            // バッファに収まらない部分は読み捨てる
+            if (lineLength < sizeof(line) - 1)
+            {
+                line[lineLength++] = (char)c;
+            }
+        }
+
+        return client.connected() ? LineResult::NEED_MORE : LineResult::CLOSED;
+    }
+
+    bool KeepAliveHttpClient::stepConnect()
+    {
+        // 接続を再利用できない場合は新しく開く
+        // TLSハンドシェイクはClient::connectの中で完了するため、この段階だけは分割できない
+        reusedConnection = isConnectedTo(requestHost, requestPort);
+        if (!reusedConnection && !openConnection(requestHost, requestPort))
+        {
+            return finish(ERROR_CONNECTION_FAILED, false);
+        }
+
+        state = State::SENDING;
+        lastProgressMillis = millis();
+        return true;
+    }
+
+    bool KeepAliveHttpClient::stepSend()
+    {
+        // 前回のレスポンスの読み残しを捨てる
+        while (client.available())
+        {
+            client.read();
+        }
+
+        char request[REQUEST_BUFFER_SIZE];
+        int requestLength = formatRequest(request, sizeof(request), requestHost, requestPath, requestValidators);
+        if (requestLength < 0)
+        {
+            closeConnection();
+            return finish(ERROR_SEND_FAILED, false);
+        }
+
+        if (client.write((const uint8_t *)request, requestLength) != (size_t)requestLength)
+        {
+            return retryOrFail(ERROR_SEND_FAILED);
+        }
+        requestBytes += (unsigned long)requestLength;
+
+        state = State::READING_STATUS;
+        lineLength = 0;
+        lastProgressMillis = millis();
+        return true;
+    }
+
+    bool KeepAliveHttpClient::stepStatus()
+    {
+        LineResult result = readLine();
+        if (result == LineResult::NEED_MORE)
+        {
+            return isTimedOut() ? retryOrFail(ERROR_READ_TIMEOUT) : true;
+        }
+        if (result == LineResult::CLOSED || strncmp(line, "HTTP/1.", 7) != 0)
+        {
+            return retryOrFail(ERROR_READ_TIMEOUT);
+        }
+
+        header.statusCode = atoi(line + 9);
+        header.contentLength = -1;
+        header.chunked = false;
+        header.keepAlive = line[7] != '0'; // HTTP/1.1はデフォルトでkeep-alive
+        header.validators = CacheValidators();
+
+        state = State::READING_HEADERS;
+        lineLength = 0;
+        return true;
+    }
+
+    bool KeepAliveHttpClient::stepHeaders()
+    {
+        // 届いているヘッダ行をまとめて読む
+        for (;;)
+        {
+            LineResult result = readLine();
+            if (result == LineResult::NEED_MORE)
+            {
+                return isTimedOut() ? retryOrFail(ERROR_READ_TIMEOUT) : true;
+            }
+            if (result == LineResult::CLOSED)
+            {
+                return retryOrFail(ERROR_READ_TIMEOUT);
+            }
+            if (lineLength == 0)
+            {
+                break;
+            }
+
+            parseHeaderLine(line);
+            lineLength = 0;
+        }
+
+        // 204/304はボディを持たない
+        if (header.statusCode == 204 || header.statusCode == 304)
+        {
+            header.contentLength = 0;
+            header.chunked = false;
+        }
+
+        // 長さ不明のボディは接続終了で区切られるため再利用できない
+        if (!header.chunked && header.contentLength < 0)
+        {
+            header.keepAlive = false;
+        }
+
+        state = State::READING_BODY;
+        lineLength = 0;
+        return true;
+    }
+
+    bool KeepAliveHttpClient::stepBody()
+    {
+        // 上限を超えると分かっているボディは読まずに接続ごと捨てる
+        if (header.statusCode == 200 && !header.chunked && header.contentLength > (long)MAX_BODY_SIZE)
+        {
+            Serial.printf("Response too large: %ld bytes\n", header.contentLength);
+            closeConnection();
+            return finish(ERROR_BODY_TOO_LARGE, false);
+        }
+
+        // ハンドラに渡すボディの先頭が届くまで待つ
+        bool hasBody = header.chunked || header.contentLength != 0;
+        if (header.statusCode == 200 && hasBody && client.available() == 0 && client.connected())
+        {
+            if (isTimedOut())
+            {
+                closeConnection();
+                return finish(ERROR_READ_TIMEOUT, false);
+            }
+            return true;
+        }
+
+        HttpBodyStream body(client, header.contentLength, header.chunked, MAX_BODY_SIZE);
+        body.setTimeout(RESPONSE_TIMEOUT);
+
+        bool handlerResult = false;
+        if (header.statusCode == 200)
+        {
+            handlerResult = bodyHandler(body);
+        }
+
+        // 次のリクエストで接続を使い回せるよう残りのボディを読み捨てる
+        body.drain();
+        bodyBytes += (unsigned long)body.getConsumed();
+
+        if (!header.keepAlive || !body.isComplete())
+        {
+            closeConnection();
+        }
+
+        // 途中で上限を超えたボディは、ハンドラが成功していても使わない
+        if (body.isTooLarge())
+        {
+            Serial.printf("Response exceeded %u bytes\n", (unsigned int)MAX_BODY_SIZE);
+            return finish(ERROR_BODY_TOO_LARGE, false);
+        }
+
+        // 正しく処理できたレスポンスの検証子だけを次回のリクエストに使う
+        if (handlerResult && requestValidators != nullptr)
+        {
+            *requestValidators = header.validators;
+        }
+
+        return finish(header.statusCode, handlerResult);
+    }
+
+    int KeepAliveHttpClient::formatRequest(char *buffer, size_t bufferSize, const char *host, const char *path,
+                                           const CacheValidators *validators)
+    {
+        // 前回の検証子があれば条件付きリクエストにする
+        // バッファは書式と検証子の最大長から決め、検証子が切り詰められないようにする
+        static const char IF_NONE_MATCH_FORMAT[] = "If-None-Match: %s\r\n";
+        static const char IF_MODIFIED_SINCE_FORMAT[] = "If-Modified-Since: %s\r\n";
+        static const char REQUEST_FORMAT[] = "GET %s HTTP/1.1\r\n"
+                                             "Host: %s\r\n"
+                                             "User-Agent: ESP32-Splatoon3-Schedule\r\n"
+                                             "Accept: application/json\r\n"
+                                             "Accept-Encoding: identity\r\n"
+                                             "Connection: keep-alive\r\n"
+                                             "%s"
+                                             "\r\n";
+        constexpr size_t CONDITIONAL_HEADERS_SIZE =
+            sizeof(IF_NONE_MATCH_FORMAT) + sizeof(Application::NetworkService::CacheValidators::etag) +
+            sizeof(IF_MODIFIED_SINCE_FORMAT) + sizeof(Application::NetworkService::CacheValidators::lastModified);
+        constexpr size_t REQUEST_SIZE =
+            sizeof(REQUEST_FORMAT) + sizeof(requestPath) + sizeof(requestHost) + CONDITIONAL_HEADERS_SIZE;
+        static_assert(REQUEST_SIZE <= REQUEST_BUFFER_SIZE, "HTTP request buffer is too large for the task stack");
+
+        char conditionalHeaders[CONDITIONAL_HEADERS_SIZE] = "";
+        if (validators != nullptr)
+        {
+            size_t length = 0;
+            if (validators->etag[0] != '\0')
+            {
+                int written = snprintf(conditionalHeaders, sizeof(conditionalHeaders),
+                                       IF_NONE_MATCH_FORMAT, validators->etag);
+                if (written < 0 || (size_t)written >= sizeof(conditionalHeaders))
+                {
+                    return -1;
+                }
+                length = (size_t)written;
+            }
+            if (validators->lastModified[0] != '\0')
+            {
+                int written = snprintf(conditionalHeaders + length, sizeof(conditionalHeaders) - length,
+                                       IF_MODIFIED_SINCE_FORMAT, validators->lastModified);
+                if (written < 0 || (size_t)written >= sizeof(conditionalHeaders) - length)
+                {
+                    return -1;
+                }
+            }
+        }
+
+        int requestLength = snprintf(buffer, bufferSize, REQUEST_FORMAT, path, host, conditionalHeaders);
+        if (requestLength <= 0 || (size_t)requestLength >= bufferSize)
+        {
+            return -1;
+        }
+        return requestLength;
+    }
+
+    bool KeepAliveHttpClient::isTimedOut() const
+    {
+        return millis() - lastProgressMillis >= RESPONSE_TIMEOUT;
+    }
+
+    bool KeepAliveHttpClient::retryOrFail(int errorCode)
+    {
+        closeConnection();
+
+        // 再利用した接続がサーバー側で閉じられていた場合は1回だけ再接続して再試行する
+        if (reusedConnection && !retried)
+        {
+            Serial.println("Keep-alive connection was closed by server. Reconnecting...");
+            retried = true;
+            state = State::CONNECTING;
+            return true;
+        }
+
+        return finish(errorCode, false);
+    }
+
+    bool KeepAliveHttpClient::finish(int statusCode, bool handlerResult)
+    {
+        // 完了通知の中で次のリクエストを開始できるよう、先に状態を戻す
+        CompletionHandler onComplete = completionHandler;
+        state = State::IDLE;
+        bodyHandler = nullptr;
+        completionHandler = nullptr;
+        requestValidators = nullptr;
+
+        if (onComplete)
+        {
+            onComplete(statusCode, handlerResult);
+        }
+        return false;
+    }
+
+    bool KeepAliveHttpClient::parseUrl(const char *url, char *host, size_t hostSize, uint16_t &port, const char *&path)
+    {
+        const char *hostStart;
+        if (strncmp(url, "https://", 8) == 0)
+        {
+            hostStart = url + 8;
+            port = 443;
+        }
+        else
+        {
+            // このクライアントはTLS接続のみを扱う
+            return false;
+        }
+
+        const char *hostEnd = hostStart;
+        while (*hostEnd && *hostEnd != '/' && *hostEnd != ':')
+        {
+            hostEnd++;
+        }
+
+        size_t hostLength = hostEnd - hostStart;
+        if (hostLength == 0 || hostLength >= hostSize)
+        {
+            return false;
+        }
+        memcpy(host, hostStart, hostLength);
+        host[hostLength] = '\0';
+
+        path = hostEnd;
+        if (*path == ':')
+        {
+            port = (uint16_t)strtoul(path + 1, nullptr, 10);
+            while (*path && *path != '/')
+            {
+                path++;
+            }
+        }
+
+        if (*path == '\0')
+        {
+            path = "/";
+        }
+
+        return true;
+    }
+
+    bool KeepAliveHttpClient::isConnectedTo(const char *host, uint16_t port)
+    {
+        if (connectedPort != port || strcmp(connectedHost, host) != 0)
+        {
+            return false;
+        }
+
+        if (!client.connected())
+        {
+            closeConnection();
+            return false;
+        }
+
+        return true;
+    }
+
+    bool KeepAliveHttpClient::openConnection(const char *host, uint16_t port)
+    {
+        closeConnection();
+
+        handshakeCount++;
+        if (!client.connect(host, port))
+        {
+            Serial.print("TLS connection failed: ");
+            Serial.println(host);
+            return false;
+        }
+
+        strncpy(connectedHost, host, sizeof(connectedHost) - 1);
+        connectedHost[sizeof(connectedHost) - 1] = '\0';
+        connectedPort = port;
+        return true;
+    }
+
+    void KeepAliveHttpClient::closeConnection()
+    {
+        client.stop();
+        connectedHost[0] = '\0';
+        connectedPort = 0;
+    }
+
+    void KeepAliveHttpClient::parseHeaderLine(const char *headerLine)
+    {
+        if (strncasecmp(headerLine, "Content-Length:", 15) == 0)
+        {
+            header.contentLength = atol(headerLine + 15);
+        }
+        else if (strncasecmp(headerLine, "Transfer-Encoding:", 18) == 0)
+        {
+            header.chunked = strcasestr(headerLine + 18, "chunked") != nullptr;
+        }
+        else if (strncasecmp(headerLine, "ETag:", 5) == 0)
+        {
+            copyHeaderValue(headerLine + 5, header.validators.etag, sizeof(header.validators.etag));
+        }
+        else if (strncasecmp(headerLine, "Last-Modified:", 14) == 0)
+        {
+            copyHeaderValue(headerLine + 14, header.validators.lastModified, sizeof(header.validators.lastModified));
+        }
+        else if (strncasecmp(headerLine, "Connection:", 11) == 0)
+        {
+            if (strcasestr(headerLine + 11, "close") != nullptr)
+            {
+                header.keepAlive = false;
+            }
+            else if (strcasestr(headerLine + 11, "keep-alive") != nullptr)
+            {
+                header.keepAlive = true;
+            }
+        }
+    }
+
+    void KeepAliveHttpClient::copyHeaderValue(const char *value, char *buffer, size_t bufferSize)
+    {
+        while (*value == ' ' || *value == '\t')
+        {
+            value++;
+        }
+
+        // 途中で切れた検証子は使えないため空にする
+        size_t length = strlen(value);
+        if (length >= bufferSize)
+        {
+            buffer[0] = '\0';
+            return;
+        }
+
+        memcpy(buffer, value, length + 1);
+    }
+}
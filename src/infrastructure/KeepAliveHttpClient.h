@@ -0,0 +1,237 @@
+// KeepAliveHttpClient.h
+// 1本のTLS接続を使い回すHTTP/1.1クライアント
+
+#ifndef KEEP_ALIVE_HTTP_CLIENT_H
+#define KEEP_ALIVE_HTTP_CLIENT_H
+
+#include <Arduino.h>
+#include <functional>
+#include "../application/NetworkService.h"
+
+namespace Infrastructure
+{
+    // HTTPレスポンスのボディを読み出すストリーム
+    // Content-Lengthとチャンク転送の両方に対応し、ボディの終端で読み出しを止める
+    // maxBytesを超えて読もうとした場合はエラーとして読み出しを止める
+    class HttpBodyStream : public Stream
+    {
+    public:
+        HttpBodyStream(Client &source, long contentLength, bool chunked, size_t maxBytes);
+
+        int available() override;
+        int read() override;
+        int peek() override;
+        size_t readBytes(char *buffer, size_t length) override;
+        size_t write(uint8_t) override { return 0; }
+        void flush() override {}
+
+        // ハンドラと読み捨てで読み出したバイト数（チャンクの区切りを除く）
+        size_t getConsumed() const { return consumed; }
+
+        // ボディを最後まで読み切ったかどうか
+        bool isComplete() const { return finished && !failed; }
+
+        // 上限を超えたため読み出しを止めたかどうか
+        bool isTooLarge() const { return tooLarge; }
+
+        // 残りのボディを読み捨てる（接続を再利用するため）
+        void drain();
+
+    private:
+        Client &source;
+        long remaining;   // 現在のチャンク（またはボディ全体）の残りバイト数
+        bool chunked;     // チャンク転送かどうか
+        bool unbounded;   // 長さ不明（接続終了までがボディ）
+        bool finished;    // ボディの終端に到達した
+        bool failed;      // 読み出し中にエラーが発生した
+        bool tooLarge;    // 上限を超えた
+        size_t maxBytes;  // 読み出せるボディの上限
+        size_t consumed;  // 読み出したバイト数
+
+        // 次に読み出せるバイトがあるよう準備する
+        bool prepare();
+
+        // 上限に達していなければtrue（達していれば大きすぎるボディとして止める）
+        bool withinLimit();
+    };
+
+    // 1本の接続を保持し、同じホストへのリクエストで接続を再利用するHTTPクライアント
+    // A request is a state machine advanced by poll(): connect, send, status line,
+    // headers and body each take one or more steps, and status and header reads never
+    // wait for data that has not arrived. Three things still block inside poll(): the
+    // TLS handshake in Client::connect, and the body step, where the handler parses
+    // the stream and HttpBodyStream waits (with a timeout) for body bytes and chunk-size
+    // lines. Running requests side by side therefore overlaps the server's time to
+    // first byte, not the handshake or the parse. The connection is any Client
+    // (WiFiClientSecure on the device), so the machine can be driven by a fake socket.
+    class KeepAliveHttpClient
+    {
+    public:
+        // ボディを受け取るハンドラ
+        using BodyHandler = std::function<bool(Stream &stream)>;
+
+        // リクエスト完了時に呼ばれる（ステータスコードまたはエラーコードと、ハンドラの結果）
+        using CompletionHandler = std::function<void(int statusCode, bool handlerResult)>;
+
+        // エラーコード（HTTPステータスと区別するため負の値）
+        static constexpr int ERROR_INVALID_URL = -1;
+        static constexpr int ERROR_CONNECTION_FAILED = -2;
+        static constexpr int ERROR_SEND_FAILED = -3;
+        static constexpr int ERROR_READ_TIMEOUT = -4;
+        static constexpr int ERROR_BUSY = -5;
+        static constexpr int ERROR_BODY_TOO_LARGE = -6;
+
+        // ボディの上限（一括取得の/api/scheduleがバッファせずに収まる大きさ）
+        static constexpr size_t MAX_BODY_SIZE = 128 * 1024;
+
+        // リクエストの進行段階
+        enum class State
+        {
+            IDLE,            // リクエストなし
+            CONNECTING,      // 接続（必要ならTLSハンドシェイク）
+            SENDING,         // リクエストの送信
+            READING_STATUS,  // ステータス行の受信待ち
+            READING_HEADERS, // ヘッダの受信
+            READING_BODY     // ボディの受信とハンドラの呼び出し
+        };
+
+        explicit KeepAliveHttpClient(Client &client);
+
+        // 条件付きリクエスト用のETag/Last-Modified
+        using CacheValidators = Application::NetworkService::CacheValidators;
+
+        // GETリクエストを開始する（すぐに戻り、以降はpoll()で進める）
+        // ステータスが200の場合のみハンドラを呼び出し、完了時にonCompleteを呼ぶ
+        // validatorsを渡すと条件付きリクエストを行い、ハンドラが成功した場合に新しい値で更新する
+        // validatorsは完了まで有効であること。リクエスト中の場合はfalse
+        bool start(const char *url, const BodyHandler &handler, CacheValidators *validators,
+                   const CompletionHandler &onComplete);
+
+        // リクエストを1段階進める（リクエスト中ならtrue）
+        bool poll();
+
+        bool isBusy() const { return state != State::IDLE; }
+        State getState() const { return state; }
+
+        // GETリクエストを送り、完了まで待ってステータスコード（またはエラーコード）を返す
+        int get(const char *url, const BodyHandler &handler, bool &handlerResult,
+                CacheValidators *validators = nullptr);
+
+        // 保持している接続を閉じる（リクエスト中の場合は中断する）
+        void close();
+
+        // 統計情報
+        unsigned long getRequestCount() const { return requestCount; }
+        unsigned long getHandshakeCount() const { return handshakeCount; }
+        unsigned long getRequestBytes() const { return requestBytes; }
+        unsigned long getHeaderBytes() const { return headerBytes; }
+        unsigned long getBodyBytes() const { return bodyBytes; }
+        void resetStats()
+        {
+            requestCount = 0;
+            handshakeCount = 0;
+            requestBytes = 0;
+            headerBytes = 0;
+            bodyBytes = 0;
+        }
+
+        // 送信するリクエスト（リクエスト行とヘッダ）をbufferに書き、長さを返す（収まらない場合は-1）
+        // validatorsがあれば条件付きリクエストにする
+        static int formatRequest(char *buffer, size_t bufferSize, const char *host, const char *path,
+                                 const CacheValidators *validators);
+
+        // formatRequestに必要なバッファの大きさ
+        static constexpr size_t REQUEST_BUFFER_SIZE = 512;
+
+    private:
+        Client &client;
+
+        // 現在接続しているホスト
+        char connectedHost[64];
+        uint16_t connectedPort;
+
+        // 統計情報
+        unsigned long requestCount;
+        unsigned long handshakeCount;
+        unsigned long requestBytes; // 送信したリクエスト行とヘッダ
+        unsigned long headerBytes;  // 受信したステータス行とヘッダ
+        unsigned long bodyBytes;    // 受信したボディ
+
+        // タイムアウト（ミリ秒、データを受信するたびに延長する）
+        static constexpr unsigned long RESPONSE_TIMEOUT = 10000;
+
+        // レスポンスヘッダから読み取った情報
+        struct ResponseHeader
+        {
+            int statusCode;
+            long contentLength;
+            bool chunked;
+            bool keepAlive;
+            CacheValidators validators;
+        };
+
+        // 進行中のリクエスト
+        State state;
+        char requestHost[sizeof(connectedHost)];
+        uint16_t requestPort;
+        char requestPath[160];
+        BodyHandler bodyHandler;
+        CompletionHandler completionHandler;
+        CacheValidators *requestValidators;
+        ResponseHeader header;
+        bool reusedConnection; // 保持していた接続を使っているか
+        bool retried;          // 閉じられていた接続から再接続済みか
+        unsigned long lastProgressMillis;
+
+        // 受信途中の行（ステータス行とヘッダ）
+        char line[256];
+        size_t lineLength;
+
+        // 行の読み込み結果
+        enum class LineResult
+        {
+            READY,     // 1行そろった
+            NEED_MORE, // まだ届いていない
+            CLOSED     // 接続が閉じられた
+        };
+
+        // 届いている分だけ読み、行がそろったかどうかを返す（待たない）
+        LineResult readLine();
+
+        // 各段階の処理（リクエスト中ならtrue）
+        bool stepConnect();
+        bool stepSend();
+        bool stepStatus();
+        bool stepHeaders();
+        bool stepBody();
+
+        // 受信が止まったまま時間切れになったか
+        bool isTimedOut() const;
+
+        // 保持していた接続が閉じられていた場合は1回だけ再接続し、それ以外は失敗で終える
+        bool retryOrFail(int errorCode);
+
+        // リクエストを終えて完了を通知する
+        bool finish(int statusCode, bool handlerResult);
+
+        // URLをホスト・ポート・パスに分解する
+        static bool parseUrl(const char *url, char *host, size_t hostSize, uint16_t &port, const char *&path);
+
+        // 指定ホストへの接続が生きているかどうか
+        bool isConnectedTo(const char *host, uint16_t port);
+
+        // 新しい接続を開く（TLSハンドシェイクを伴う）
+        bool openConnection(const char *host, uint16_t port);
+
+        // 接続を閉じる（リクエストの状態は変えない）
+        void closeConnection();
+
+        // ヘッダ行を解釈する
+        void parseHeaderLine(const char *headerLine);
+
+        // ヘッダ値をコピーする（収まらない場合は空にする）
+        static void copyHeaderValue(const char *value, char *buffer, size_t bufferSize);
+    };
+}
+
+#endif // KEEP_ALIVE_HTTP_CLIENT_H
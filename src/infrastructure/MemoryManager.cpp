@@ -2,17 +2,173 @@
 // メモリ管理と監視のためのユーティリティ実装
 
 #include "MemoryManager.h"
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 
 namespace Infrastructure
 {
+    constexpr size_t MemoryManager::PHASE_COUNT;
+    constexpr size_t MemoryManager::MAX_TRACKED_TASKS;
+    constexpr size_t MemoryManager::HISTOGRAM_BUCKETS;
+    constexpr size_t MemoryManager::TREND_CAPACITY;
+    constexpr unsigned long MemoryManager::TREND_INTERVAL;
+
     // 静的変数の初期化
     size_t MemoryManager::lastFreeHeap = 0;
     size_t MemoryManager::minFreeHeapEver = SIZE_MAX;
-    unsigned long MemoryManager::lastMemoryCheck = 0;
-    unsigned long MemoryManager::lastCleanupTime = 0;
     size_t MemoryManager::memoryLeakThreshold = 5000; // 5KB
     int MemoryManager::consecutiveLowMemoryCount = 0;
 
+    volatile uint32_t MemoryManager::allocationCount = 0;
+    volatile uint32_t MemoryManager::freeCount = 0;
+    volatile uint32_t MemoryManager::allocatedBytes = 0;
+    volatile uint32_t MemoryManager::failedAllocationCount = 0;
+    volatile uint32_t MemoryManager::largestFailedAllocation = 0;
+    volatile uint32_t MemoryManager::sizeHistogram[MemoryManager::HISTOGRAM_BUCKETS] = {};
+
+    MemoryManager::TaskCounters MemoryManager::taskCounters[MemoryManager::MAX_TRACKED_TASKS] = {};
+
+    MemoryManager::PhaseStats MemoryManager::phaseStats[MemoryManager::PHASE_COUNT] = {};
+
+    MemoryManager::TrendSample MemoryManager::trend[MemoryManager::TREND_CAPACITY] = {};
+    size_t MemoryManager::trendHead = 0;
+    size_t MemoryManager::trendCount = 0;
+    unsigned long MemoryManager::lastTrendSampleTime = 0;
+    size_t MemoryManager::minLargestBlockEver = SIZE_MAX;
+
+    namespace
+    {
+        // 確保に失敗したときにheap_capsから呼び出される
+        void onAllocationFailed(size_t size, uint32_t, const char *)
+        {
+            MemoryManager::recordFailedAllocation(size);
+        }
+    }
+
+    MemoryManager::PhaseScope::PhaseScope(Phase phase)
+        : phase(phase),
+          counters(findTaskCounters(true)),
+          startAllocations(counters != nullptr ? counters->allocations : 0),
+          startFrees(counters != nullptr ? counters->frees : 0),
+          startBytes(counters != nullptr ? counters->allocatedBytes : 0),
+          startFreeHeap(ESP.getFreeHeap())
+    {
+    }
+
+    MemoryManager::PhaseScope::~PhaseScope()
+    {
+        PhaseStats &stats = phaseStats[static_cast<size_t>(phase)];
+        size_t largestBlock = ESP.getMaxAllocHeap();
+
+        // 符号なしの差分なので累計が一周しても正しく求まる
+        stats.runs++;
+        if (counters != nullptr)
+        {
+            stats.allocations += counters->allocations - startAllocations;
+            stats.frees += counters->frees - startFrees;
+            stats.allocatedBytes += counters->allocatedBytes - startBytes;
+        }
+        stats.lastHeapDelta = (int32_t)ESP.getFreeHeap() - (int32_t)startFreeHeap;
+        if (stats.runs == 1 || largestBlock < stats.minLargestBlock)
+        {
+            stats.minLargestBlock = largestBlock;
+        }
+    }
+
+    void MemoryManager::begin()
+    {
+        resetMemoryStats();
+        heap_caps_register_failed_alloc_callback(onAllocationFailed);
+
+#ifdef MEMORY_MANAGER_WRAP_MALLOC
+        Serial.println("malloc wrappers enabled: counting every allocation");
+#else
+        Serial.println("malloc wrappers disabled: allocation counts and histogram are unavailable");
+#endif
+    }
+
+    IRAM_ATTR MemoryManager::TaskCounters *MemoryManager::findTaskCounters(bool claim)
+    {
+        // スケジューラの起動前はタスクがないため全体の累計だけを数える
+        void *task = xTaskGetCurrentTaskHandle();
+        if (task == nullptr)
+        {
+            return nullptr;
+        }
+
+        for (TaskCounters &counters : taskCounters)
+        {
+            if (counters.task == task)
+            {
+                return &counters;
+            }
+        }
+
+        if (!claim)
+        {
+            return nullptr;
+        }
+
+        // 別コアのタスクと同時に空きを取り合ってもよいよう、比較交換で割り当てる
+        for (TaskCounters &counters : taskCounters)
+        {
+            void *expected = nullptr;
+            if (__atomic_compare_exchange_n(&counters.task, &expected, task, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+            {
+                return &counters;
+            }
+        }
+        return nullptr;
+    }
+
+    void IRAM_ATTR MemoryManager::recordAllocation(size_t size)
+    {
+        // 16, 32, 64, ... と2倍ずつの区切りで、最後のバケットは8KB超
+        size_t bucket = 0;
+        size_t limit = 16;
+        while (size > limit && bucket < HISTOGRAM_BUCKETS - 1)
+        {
+            limit <<= 1;
+            bucket++;
+        }
+
+        __atomic_fetch_add(&allocationCount, 1, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&allocatedBytes, (uint32_t)size, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&sizeHistogram[bucket], 1, __ATOMIC_RELAXED);
+
+        TaskCounters *counters = findTaskCounters(false);
+        if (counters != nullptr)
+        {
+            __atomic_fetch_add(&counters->allocations, 1, __ATOMIC_RELAXED);
+            __atomic_fetch_add(&counters->allocatedBytes, (uint32_t)size, __ATOMIC_RELAXED);
+        }
+    }
+
+    void IRAM_ATTR MemoryManager::recordFree()
+    {
+        __atomic_fetch_add(&freeCount, 1, __ATOMIC_RELAXED);
+
+        TaskCounters *counters = findTaskCounters(false);
+        if (counters != nullptr)
+        {
+            __atomic_fetch_add(&counters->frees, 1, __ATOMIC_RELAXED);
+        }
+    }
+
+    void MemoryManager::recordFailedAllocation(size_t size)
+    {
+        __atomic_fetch_add(&failedAllocationCount, 1, __ATOMIC_RELAXED);
+
+        // 別コアからの失敗と競合しても小さい値で上書きしないよう、比較交換で最大値を更新する
+        uint32_t largest = __atomic_load_n(&largestFailedAllocation, __ATOMIC_RELAXED);
+        while (size > largest &&
+               !__atomic_compare_exchange_n(&largestFailedAllocation, &largest, (uint32_t)size, true,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        {
+        }
+    }
+
     void MemoryManager::logMemoryUsage(const char *operation)
     {
         size_t freeHeap, minFreeHeap, maxAllocHeap;
@@ -26,7 +182,9 @@ namespace Infrastructure
         Serial.print(minFreeHeap);
         Serial.print(" bytes, Max Alloc: ");
         Serial.print(maxAllocHeap);
-        Serial.println(" bytes");
+        Serial.print(" bytes, Fragmentation: ");
+        Serial.print((int)(getFragmentationRatio() * 100));
+        Serial.println("%");
 
         // メモリ使用量の変化を記録
         if (lastFreeHeap > 0)
@@ -48,7 +206,6 @@ namespace Infrastructure
         }
 
         lastFreeHeap = freeHeap;
-        lastMemoryCheck = millis();
 
         // メモリ不足の警告
         if (isLowMemory())
@@ -57,11 +214,6 @@ namespace Infrastructure
             Serial.print("WARNING: Low memory detected! (Count: ");
             Serial.print(consecutiveLowMemoryCount);
             Serial.println(")");
-
-            if (consecutiveLowMemoryCount >= 3)
-            {
-                Serial.println("CRITICAL: Persistent low memory - consider restart");
-            }
         }
         else
         {
@@ -88,71 +240,237 @@ namespace Infrastructure
         }
     }
 
-    void MemoryManager::forceGarbageCollection()
+    float MemoryManager::getFragmentationRatio()
     {
-        // ESP32では明示的なガベージコレクションはありませんが、
-        // メモリ使用量をチェックして警告を出す
-        if (isLowMemory())
+        size_t freeHeap = ESP.getFreeHeap();
+        if (freeHeap == 0)
         {
-            Serial.println("Low memory detected - consider restarting if problems occur");
+            return 0.0f;
         }
 
-        // メモリ使用量をログ
-        logMemoryUsage("After GC attempt");
+        return 1.0f - (float)ESP.getMaxAllocHeap() / (float)freeHeap;
     }
 
     void MemoryManager::resetMemoryStats()
     {
         lastFreeHeap = 0;
         minFreeHeapEver = SIZE_MAX;
-        lastMemoryCheck = 0;
-        lastCleanupTime = 0;
         consecutiveLowMemoryCount = 0;
+
+        // 確保・解放の累計はPhaseScopeが差分で使うためリセットしない
+        failedAllocationCount = 0;
+        largestFailedAllocation = 0;
+        for (size_t i = 0; i < HISTOGRAM_BUCKETS; i++)
+        {
+            sizeHistogram[i] = 0;
+        }
+        for (size_t i = 0; i < PHASE_COUNT; i++)
+        {
+            phaseStats[i] = PhaseStats();
+        }
+
+        trendHead = 0;
+        trendCount = 0;
+        lastTrendSampleTime = 0;
+        minLargestBlockEver = SIZE_MAX;
+
         Serial.println("Memory statistics reset");
     }
 
-    void MemoryManager::performPeriodicCleanup()
+    void MemoryManager::recordTrendSample(size_t freeHeap, size_t largestBlock)
+    {
+        size_t index = (trendHead + trendCount) % TREND_CAPACITY;
+        if (trendCount < TREND_CAPACITY)
+        {
+            trendCount++;
+        }
+        else
+        {
+            // 満杯なら最も古いサンプルを上書きする
+            trendHead = (trendHead + 1) % TREND_CAPACITY;
+        }
+
+        trend[index].freeHeap = freeHeap;
+        trend[index].largestBlock = largestBlock;
+    }
+
+    void MemoryManager::analyzeMemoryTrend()
     {
+        size_t freeHeap = ESP.getFreeHeap();
+        size_t largestBlock = ESP.getMaxAllocHeap();
+
+        if (largestBlock < minLargestBlockEver)
+        {
+            minLargestBlockEver = largestBlock;
+        }
+
+        // 推移は一定間隔でのみ記録する（最初の呼び出しでは必ず記録する）
         unsigned long currentTime = millis();
+        if (trendCount > 0 && currentTime - lastTrendSampleTime < TREND_INTERVAL)
+        {
+            return;
+        }
+        lastTrendSampleTime = currentTime;
+        recordTrendSample(freeHeap, largestBlock);
+
+        // 最も古いサンプルと比べて最大空きブロックが大きく減っていれば断片化が進んでいる
+        const TrendSample &oldest = trend[trendHead];
+        if (trendCount > 1 && oldest.largestBlock > largestBlock && oldest.largestBlock - largestBlock > memoryLeakThreshold)
+        {
+            Serial.print("Memory trend: largest free block shrank by ");
+            Serial.print(oldest.largestBlock - largestBlock);
+            Serial.print(" bytes over ");
+            Serial.print((trendCount - 1) * (TREND_INTERVAL / 60000));
+            Serial.print(" min (free heap change: ");
+            Serial.print((int)freeHeap - (int)oldest.freeHeap);
+            Serial.println(" bytes)");
+        }
+    }
+
+    const char *MemoryManager::getPhaseName(Phase phase)
+    {
+        switch (phase)
+        {
+        case Phase::FETCH:
+            return "fetch";
+        case Phase::PARSE:
+            return "parse";
+        case Phase::RENDER:
+            return "render";
+        case Phase::PORTAL:
+            return "portal";
+        }
+        return "unknown";
+    }
+
+    String MemoryManager::buildReportJson()
+    {
+        size_t freeHeap, minFreeHeap, maxAllocHeap;
+        getMemoryInfo(freeHeap, minFreeHeap, maxAllocHeap);
 
-        // 5分ごとにクリーンアップを実行
-        if (currentTime - lastCleanupTime >= 300000) // 5分
+        String json;
+        json.reserve(1536);
+
+        json += "{\"free_heap\":" + String(freeHeap);
+        json += ",\"min_free_heap\":" + String(minFreeHeap);
+        json += ",\"largest_block\":" + String(maxAllocHeap);
+        json += ",\"min_largest_block\":" + String(minLargestBlockEver == SIZE_MAX ? maxAllocHeap : minLargestBlockEver);
+        json += ",\"fragmentation\":" + String(getFragmentationRatio(), 3);
+#ifdef MEMORY_MANAGER_WRAP_MALLOC
+        json += ",\"alloc_tracking\":true";
+#else
+        json += ",\"alloc_tracking\":false";
+#endif
+        json += ",\"allocations\":" + String(allocationCount);
+        json += ",\"frees\":" + String(freeCount);
+        json += ",\"failed_allocations\":" + String(failedAllocationCount);
+        json += ",\"largest_failed_allocation\":" + String(largestFailedAllocation);
+
+        json += ",\"phases\":{";
+        for (size_t i = 0; i < PHASE_COUNT; i++)
         {
-            Serial.println("Performing periodic memory cleanup...");
+            const PhaseStats &stats = phaseStats[i];
+            if (i > 0)
+            {
+                json += ",";
+            }
+            json += "\"";
+            json += getPhaseName(static_cast<Phase>(i));
+            json += "\":{\"runs\":" + String(stats.runs);
+            json += ",\"allocations\":" + String(stats.allocations);
+            json += ",\"frees\":" + String(stats.frees);
+            json += ",\"bytes\":" + String(stats.allocatedBytes);
+            json += ",\"last_heap_delta\":" + String(stats.lastHeapDelta);
+            json += ",\"min_largest_block\":" + String(stats.minLargestBlock);
+            json += "}";
+        }
+        json += "}";
 
-            // メモリ使用量をチェック
-            size_t freeHeap = ESP.getFreeHeap();
+        // 上限（バイト）ごとの確保回数。最後のバケットは上限なし
+        json += ",\"histogram\":[";
+        for (size_t i = 0; i < HISTOGRAM_BUCKETS; i++)
+        {
+            if (i > 0)
+            {
+                json += ",";
+            }
+            json += String(sizeHistogram[i]);
+        }
+        json += "]";
 
-            // メモリ使用量が少ない場合は警告
-            if (freeHeap < 15000) // 15KB未満
+        // 古い順の[空きヒープ, 最大空きブロック]
+        json += ",\"trend_interval_min\":" + String(TREND_INTERVAL / 60000);
+        json += ",\"trend\":[";
+        for (size_t i = 0; i < trendCount; i++)
+        {
+            const TrendSample &sample = trend[(trendHead + i) % TREND_CAPACITY];
+            if (i > 0)
             {
-                Serial.println("WARNING: Low memory during cleanup");
+                json += ",";
             }
+            json += "[" + String(sample.freeHeap) + "," + String(sample.largestBlock) + "]";
+        }
+        json += "]}";
+
+        return json;
+    }
+}
 
-            // メモリ使用量の詳細をログ
-            logMemoryUsage("Periodic cleanup");
+// namespace Infrastructure
 
-            lastCleanupTime = currentTime;
+#ifdef MEMORY_MANAGER_WRAP_MALLOC
+// リンカの--wrap=malloc,--wrap=free,--wrap=calloc,--wrap=reallocで全ての呼び出しがここを通る
+// （静的にリンクするlibstdc++のoperator newやライブラリの確保も含む）
+// キャッシュ無効中にも呼ばれうるためIRAMに置く
+extern "C"
+{
+    void *__real_malloc(size_t size);
+    void __real_free(void *ptr);
+    void *__real_calloc(size_t count, size_t size);
+    void *__real_realloc(void *ptr, size_t size);
+
+    IRAM_ATTR void *__wrap_malloc(size_t size)
+    {
+        void *ptr = __real_malloc(size);
+        if (ptr != nullptr)
+        {
+            Infrastructure::MemoryManager::recordAllocation(size);
         }
+        return ptr;
     }
 
-    void MemoryManager::analyzeMemoryTrend()
+    void IRAM_ATTR __wrap_free(void *ptr)
     {
-        // メモリ使用量の傾向を分析
-        if (lastFreeHeap > 0)
+        if (ptr != nullptr)
         {
-            size_t currentFreeHeap = ESP.getFreeHeap();
-            size_t totalMemoryLoss = minFreeHeapEver - currentFreeHeap;
+            Infrastructure::MemoryManager::recordFree();
+        }
+        __real_free(ptr);
+    }
 
-            if (totalMemoryLoss > 50000) // 50KB以上のメモリ損失
-            {
-                Serial.print("Memory trend analysis: Total memory loss: ");
-                Serial.print(totalMemoryLoss);
-                Serial.println(" bytes");
-                Serial.println("Consider implementing memory optimization");
-            }
+    IRAM_ATTR void *__wrap_calloc(size_t count, size_t size)
+    {
+        void *ptr = __real_calloc(count, size);
+        if (ptr != nullptr)
+        {
+            Infrastructure::MemoryManager::recordAllocation(count * size);
         }
+        return ptr;
     }
-}
 
-// namespace Infrastructure
\ No newline at end of file
+    // 再確保は元の領域の解放と新しい領域の確保として数える
+    IRAM_ATTR void *__wrap_realloc(void *ptr, size_t size)
+    {
+        void *result = __real_realloc(ptr, size);
+        if (ptr != nullptr && (result != nullptr || size == 0))
+        {
+            Infrastructure::MemoryManager::recordFree();
+        }
+        if (result != nullptr)
+        {
+            Infrastructure::MemoryManager::recordAllocation(size);
+        }
+        return result;
+    }
+}
+#endif
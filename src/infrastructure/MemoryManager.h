@@ -8,9 +8,78 @@
 
 namespace Infrastructure
 {
+    // ヒープの使用状況を計測し、長期稼働での断片化の原因を調べるためのユーティリティ
+    // MEMORY_MANAGER_WRAP_MALLOCを定義し、リンカの--wrapでmalloc/free/calloc/reallocを包んだビルドでは
+    // 全ての確保・解放を数える（platformio.iniのbuild_flagsで有効にしている）
     class MemoryManager
     {
     public:
+        // 計測対象の処理段階
+        enum class Phase
+        {
+            FETCH,  // スケジュールの取得（解析を含む）
+            PARSE,  // JSONの解析
+            RENDER, // 画面の描画
+            PORTAL  // キャプティブポータルのリクエスト処理
+        };
+
+        static constexpr size_t PHASE_COUNT = 4;
+
+        // 段階ごとの集計のため確保を個別に数えるタスクの数（メインループと取得タスク）
+        static constexpr size_t MAX_TRACKED_TASKS = 4;
+
+        // 確保サイズのヒストグラム（16バイト以下から8KB超までの2の累乗区切り）
+        static constexpr size_t HISTOGRAM_BUCKETS = 11;
+
+        // 最大空きブロックの推移（30分ごとに48件、約1日分）
+        static constexpr size_t TREND_CAPACITY = 48;
+        static constexpr unsigned long TREND_INTERVAL = 30UL * 60 * 1000;
+
+        // 処理段階ごとの累計
+        struct PhaseStats
+        {
+            uint32_t runs;            // 実行回数
+            uint32_t allocations;     // 確保回数（計測無効時は0）
+            uint32_t frees;           // 解放回数（計測無効時は0）
+            uint32_t allocatedBytes;  // 確保したバイト数（計測無効時は0）
+            int32_t lastHeapDelta;    // 直近の実行での空きヒープの増減（全タスクの合計）
+            uint32_t minLargestBlock; // 実行終了時の最大空きブロックの最小値
+        };
+
+        // タスクごとの確保・解放の累計
+        struct TaskCounters
+        {
+            void *volatile task; // 数えるタスク（空きはnullptr）
+            volatile uint32_t allocations;
+            volatile uint32_t frees;
+            volatile uint32_t allocatedBytes;
+        };
+
+        // スコープの間に、スコープを開いたタスクで発生した確保・解放を指定した段階の統計に加える
+        // 別コアの取得タスクと描画が並行しても互いの確保は混ざらない
+        // 段階は入れ子にでき（FETCHの中のPARSEなど）、それぞれ独立に集計する
+        // 空きヒープの増減と最大空きブロックはヒープ全体の値のため、他のタスクの確保も含む
+        class PhaseScope
+        {
+        public:
+            explicit PhaseScope(Phase phase);
+            ~PhaseScope();
+
+        private:
+            Phase phase;
+            TaskCounters *counters; // 数えるタスクが上限を超えた場合はnullptr（段階の確保回数は数えない）
+            uint32_t startAllocations;
+            uint32_t startFrees;
+            uint32_t startBytes;
+            size_t startFreeHeap;
+
+            PhaseScope(const PhaseScope &) = delete;
+            PhaseScope &operator=(const PhaseScope &) = delete;
+        };
+
+        // 確保失敗時のコールバックを登録し、統計を初期化する
+        static void begin();
+
         // メモリ使用量をログ出力
         static void logMemoryUsage(const char *operation);
 
@@ -20,26 +89,62 @@ namespace Infrastructure
         // メモリ使用量の詳細情報を取得
         static void getMemoryInfo(size_t &freeHeap, size_t &minFreeHeap, size_t &maxAllocHeap);
 
-        // メモリの強制ガベージコレクション（可能な場合）
-        static void forceGarbageCollection();
+        // 断片化率（0.0〜1.0、空きヒープのうち最大空きブロックに含まれない割合）
+        static float getFragmentationRatio();
 
         // メモリ使用量の統計情報をリセット
         static void resetMemoryStats();
 
-        // 定期的なメモリクリーンアップ
-        static void performPeriodicCleanup();
-
-        // メモリ使用量の傾向を分析
+        // 最大空きブロックの推移を記録し、減少傾向を分析する（メインループから定期的に呼び出す）
         static void analyzeMemoryTrend();
 
+        // 処理段階ごとの累計
+        static const PhaseStats &getPhaseStats(Phase phase) { return phaseStats[static_cast<size_t>(phase)]; }
+
+        // 全ての統計を1つのJSONとして返す（シリアルコンソールとポータルから参照する）
+        static String buildReportJson();
+
+        // mallocのラッパーから呼び出される（直接呼び出さない）
+        static void recordAllocation(size_t size);
+        static void recordFree();
+        static void recordFailedAllocation(size_t size);
+
     private:
         static size_t lastFreeHeap;
         static size_t minFreeHeapEver;
-        static unsigned long lastMemoryCheck;
-        static unsigned long lastCleanupTime;
         static size_t memoryLeakThreshold;
         static int consecutiveLowMemoryCount;
+
+        // ラッパーで更新する累計（割り込みや別コアからも更新されるためアトミックに加算する）
+        static volatile uint32_t allocationCount;
+        static volatile uint32_t freeCount;
+        static volatile uint32_t allocatedBytes;
+        static volatile uint32_t failedAllocationCount;
+        static volatile uint32_t largestFailedAllocation;
+        static volatile uint32_t sizeHistogram[HISTOGRAM_BUCKETS];
+
+        static TaskCounters taskCounters[MAX_TRACKED_TASKS];
+
+        static PhaseStats phaseStats[PHASE_COUNT];
+
+        // 最大空きブロックと空きヒープの推移（リングバッファ）
+        struct TrendSample
+        {
+            uint32_t freeHeap;
+            uint32_t largestBlock;
+        };
+        static TrendSample trend[TREND_CAPACITY];
+        static size_t trendHead;
+        static size_t trendCount;
+        static unsigned long lastTrendSampleTime;
+        static size_t minLargestBlockEver;
+
+        // 現在のタスクの累計（claimがtrueなら空きを割り当てる。割り込みからはclaimしないこと）
+        static TaskCounters *findTaskCounters(bool claim);
+
+        static void recordTrendSample(size_t freeHeap, size_t largestBlock);
+        static const char *getPhaseName(Phase phase);
     };
 }
 
-#endif // MEMORY_MANAGER_H
\ No newline at end of file
+#endif // MEMORY_MANAGER_H
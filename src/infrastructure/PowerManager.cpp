@@ -0,0 +1,323 @@
+// PowerManager.cpp
+// 省電力モードの実装
+
+#include "PowerManager.h"
+#include <WiFi.h>
+#include <esp_wifi.h>
+#include <esp_pm.h>
+#include <esp_timer.h>
+#include <esp_idf_version.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+namespace Infrastructure
+{
+    constexpr uint16_t PowerManager::LISTEN_INTERVAL;
+    constexpr uint32_t PowerManager::IDLE_CPU_FREQ_MHZ;
+    constexpr uint32_t PowerManager::ACTIVE_CPU_FREQ_MHZ;
+
+    // 静的変数の初期化
+    volatile bool PowerManager::powerSaveActive = false;
+    uint32_t PowerManager::radioBoostDepth = 0;
+    bool PowerManager::frequencyScaling = false;
+
+    uint64_t PowerManager::statsStartMicros = 0;
+    uint64_t PowerManager::totalIdleMicros = 0;
+    uint64_t PowerManager::windowStartMicros = 0;
+    uint64_t PowerManager::windowIdleMicros = 0;
+
+    uint64_t PowerManager::powerSaveMicros = 0;
+    uint64_t PowerManager::powerSaveSinceMicros = 0;
+
+    uint32_t PowerManager::boostDepth = 0;
+    uint64_t PowerManager::boostMicros = 0;
+    uint64_t PowerManager::boostSinceMicros = 0;
+
+    namespace
+    {
+        esp_pm_lock_handle_t boostLock = nullptr;
+        portMUX_TYPE boostMux = portMUX_INITIALIZER_UNLOCKED;
+
+        // WiFi.setSleepはブロックするAPIのためportMUXではなくミューテックスで守る
+        SemaphoreHandle_t radioLock = nullptr;
+
+        void lockRadio()
+        {
+            if (radioLock != nullptr)
+            {
+                xSemaphoreTake(radioLock, portMAX_DELAY);
+            }
+        }
+
+        void unlockRadio()
+        {
+            if (radioLock != nullptr)
+            {
+                xSemaphoreGive(radioLock);
+            }
+        }
+
+        uint64_t nowMicros()
+        {
+            return (uint64_t)esp_timer_get_time();
+        }
+    }
+
+    PowerManager::BoostScope::BoostScope(bool withRadio) : withRadio(withRadio)
+    {
+        beginBoost();
+
+        // 取得の間は毎ビーコンで受信し、応答が次の受信間隔まで待たされないようにする
+        if (withRadio)
+        {
+            beginRadioBoost();
+        }
+    }
+
+    PowerManager::BoostScope::~BoostScope()
+    {
+        if (withRadio)
+        {
+            endRadioBoost();
+        }
+
+        endBoost();
+    }
+
+    void PowerManager::begin()
+    {
+        resetStats();
+
+        if (radioLock == nullptr)
+        {
+            radioLock = xSemaphoreCreateMutex();
+        }
+
+        if (boostLock == nullptr &&
+            esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "boost", &boostLock) != ESP_OK)
+        {
+            boostLock = nullptr;
+        }
+
+        // 省電力モードに入るまでは最大周波数のまま動かす
+        configureFrequency(ACTIVE_CPU_FREQ_MHZ);
+
+        if (frequencyScaling)
+        {
+            Serial.println("Power management: frequency scaling available");
+        }
+        else
+        {
+            Serial.println("Power management: frequency scaling unavailable, modem sleep only");
+        }
+    }
+
+    void PowerManager::enterPowerSave()
+    {
+        lockRadio();
+        if (powerSaveActive)
+        {
+            unlockRadio();
+            return;
+        }
+
+        // 取得中なら浅いモデムスリープのままにし、取得の終了時に深くする
+        powerSaveActive = true;
+        applySleepMode();
+        unlockRadio();
+
+        configureFrequency(IDLE_CPU_FREQ_MHZ);
+        powerSaveSinceMicros = nowMicros();
+        Serial.println("Power save mode entered");
+    }
+
+    void PowerManager::exitPowerSave()
+    {
+        lockRadio();
+        if (!powerSaveActive)
+        {
+            unlockRadio();
+            return;
+        }
+
+        // Arduinoの既定（WIFI_PS_MIN_MODEM）と最大周波数に戻す
+        powerSaveActive = false;
+        applySleepMode();
+        unlockRadio();
+
+        configureFrequency(ACTIVE_CPU_FREQ_MHZ);
+        powerSaveMicros += nowMicros() - powerSaveSinceMicros;
+        Serial.println("Power save mode exited");
+    }
+
+    void PowerManager::beginStation(const char *ssid, const char *password)
+    {
+        // 設定だけを書き込み、listen_intervalを加えてから接続する
+        WiFi.begin(ssid, password, 0, nullptr, false);
+        configureListenInterval();
+        esp_wifi_connect();
+    }
+
+    void PowerManager::recordIdle(unsigned long idleMicros)
+    {
+        totalIdleMicros += idleMicros;
+        windowIdleMicros += idleMicros;
+    }
+
+    float PowerManager::takeDutyCyclePercent()
+    {
+        uint64_t now = nowMicros();
+        uint64_t elapsed = now - windowStartMicros;
+        float awake = toPercent(elapsed > windowIdleMicros ? elapsed - windowIdleMicros : 0, elapsed);
+
+        windowStartMicros = now;
+        windowIdleMicros = 0;
+        return awake;
+    }
+
+    void PowerManager::resetStats()
+    {
+        uint64_t now = nowMicros();
+
+        statsStartMicros = now;
+        totalIdleMicros = 0;
+        windowStartMicros = now;
+        windowIdleMicros = 0;
+        powerSaveMicros = 0;
+        powerSaveSinceMicros = now;
+
+        portENTER_CRITICAL(&boostMux);
+        boostMicros = 0;
+        boostSinceMicros = now;
+        portEXIT_CRITICAL(&boostMux);
+    }
+
+    String PowerManager::buildReportJson()
+    {
+        uint64_t now = nowMicros();
+        uint64_t elapsed = now - statsStartMicros;
+
+        uint64_t powerSave = powerSaveMicros;
+        if (powerSaveActive)
+        {
+            powerSave += now - powerSaveSinceMicros;
+        }
+
+        portENTER_CRITICAL(&boostMux);
+        uint64_t boost = boostMicros;
+        if (boostDepth > 0)
+        {
+            boost += now - boostSinceMicros;
+        }
+        portEXIT_CRITICAL(&boostMux);
+
+        String json;
+        json.reserve(256);
+
+        json += "{\"power_save\":";
+        json += powerSaveActive ? "true" : "false";
+        json += ",\"frequency_scaling\":";
+        json += frequencyScaling ? "true" : "false";
+        json += ",\"cpu_mhz\":" + String(getCpuFrequencyMhz());
+        json += ",\"listen_interval\":" + String(LISTEN_INTERVAL);
+        json += ",\"elapsed_s\":" + String((unsigned long)(elapsed / 1000000));
+        json += ",\"loop_awake_pct\":" + String(toPercent(elapsed > totalIdleMicros ? elapsed - totalIdleMicros : 0, elapsed), 2);
+        json += ",\"boost_pct\":" + String(toPercent(boost, elapsed), 2);
+        json += ",\"power_save_pct\":" + String(toPercent(powerSave, elapsed), 2);
+        json += "}";
+
+        return json;
+    }
+
+    void PowerManager::beginBoost()
+    {
+        portENTER_CRITICAL(&boostMux);
+        if (boostDepth++ == 0)
+        {
+            boostSinceMicros = nowMicros();
+        }
+        portEXIT_CRITICAL(&boostMux);
+
+        if (boostLock != nullptr)
+        {
+            esp_pm_lock_acquire(boostLock);
+        }
+    }
+
+    void PowerManager::endBoost()
+    {
+        if (boostLock != nullptr)
+        {
+            esp_pm_lock_release(boostLock);
+        }
+
+        portENTER_CRITICAL(&boostMux);
+        if (boostDepth > 0 && --boostDepth == 0)
+        {
+            boostMicros += nowMicros() - boostSinceMicros;
+        }
+        portEXIT_CRITICAL(&boostMux);
+    }
+
+    void PowerManager::beginRadioBoost()
+    {
+        lockRadio();
+        radioBoostDepth++;
+        applySleepMode();
+        unlockRadio();
+    }
+
+    void PowerManager::endRadioBoost()
+    {
+        lockRadio();
+        if (radioBoostDepth > 0)
+        {
+            radioBoostDepth--;
+        }
+        applySleepMode();
+        unlockRadio();
+    }
+
+    void PowerManager::applySleepMode()
+    {
+        // radioLockを取った状態で呼ぶ。省電力モード中で無線を使うスコープがない時だけ深く眠る
+        WiFi.setSleep(powerSaveActive && radioBoostDepth == 0 ? WIFI_PS_MAX_MODEM : WIFI_PS_MIN_MODEM);
+    }
+
+    void PowerManager::configureFrequency(uint32_t minFreqMhz)
+    {
+        // 周波数の変更はidleタスクの判断に任せる（ロックがない間は最小周波数まで下がる）
+        // 自動ライトスリープはバックライトのPWMが止まるため使わない
+#if ESP_IDF_VERSION_MAJOR >= 5
+        esp_pm_config_t config = {};
+#else
+        esp_pm_config_esp32_t config = {};
+#endif
+        config.max_freq_mhz = ACTIVE_CPU_FREQ_MHZ;
+        config.min_freq_mhz = minFreqMhz;
+        config.light_sleep_enable = false;
+
+        frequencyScaling = esp_pm_configure(&config) == ESP_OK;
+    }
+
+    void PowerManager::configureListenInterval()
+    {
+        wifi_config_t config;
+        if (esp_wifi_get_config(WIFI_IF_STA, &config) != ESP_OK)
+        {
+            return;
+        }
+
+        // 設定はNVSにも書かれるため、変わる場合だけ書き込む
+        if (config.sta.listen_interval != LISTEN_INTERVAL)
+        {
+            config.sta.listen_interval = LISTEN_INTERVAL;
+            esp_wifi_set_config(WIFI_IF_STA, &config);
+        }
+    }
+
+    float PowerManager::toPercent(uint64_t part, uint64_t whole)
+    {
+        return whole > 0 ? (float)part * 100.0f / (float)whole : 0.0f;
+    }
+}
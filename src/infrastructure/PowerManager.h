@@ -0,0 +1,100 @@
+// PowerManager.h
+// 接続済みで待機している間の省電力モード（モデムスリープと動的周波数制御）
+
+#ifndef POWER_MANAGER_H
+#define POWER_MANAGER_H
+
+#include <Arduino.h>
+
+namespace Infrastructure
+{
+    // Switches the radio and CPU into a low-power mode while the app is connected
+    // and only waiting for its next clock tick or refresh deadline, and measures
+    // how much of the time the loop task is actually awake. The duty cycle covers
+    // the loop task only; the fetch task on core 0 shows up in boost_pct instead.
+    // The backlight PWM is left alone: it runs on the APB clock, which stays at
+    // 80 MHz under frequency scaling.
+    class PowerManager
+    {
+    public:
+        // WIFI_PS_MAX_MODEMで何ビーコンごとに受信するか
+        // APにはアソシエーション要求で伝わるため、beginStationで接続の前に設定する
+        static constexpr uint16_t LISTEN_INTERVAL = 10;
+
+        // 待機中と処理中のCPU周波数（WiFiの動作には80MHz以上が必要）
+        static constexpr uint32_t IDLE_CPU_FREQ_MHZ = 80;
+        static constexpr uint32_t ACTIVE_CPU_FREQ_MHZ = 240;
+
+        // スコープの間はCPUを最大周波数に保つ（TLS、JSONの解析、描画など）
+        // withRadioがtrueの場合は応答を遅らせないよう、スコープの間はモデムスリープも浅くする
+        // （他のコアの省電力モードの開始・終了とはロックで順序を決める）
+        class BoostScope
+        {
+        public:
+            explicit BoostScope(bool withRadio = false);
+            ~BoostScope();
+
+        private:
+            bool withRadio;
+
+            BoostScope(const BoostScope &) = delete;
+            BoostScope &operator=(const BoostScope &) = delete;
+        };
+
+        // 周波数制御のロックを作成し、統計を初期化する
+        static void begin();
+
+        // 省電力モードの開始と終了（接続完了後に開始し、切断やポータル表示で終了する）
+        static void enterPowerSave();
+        static void exitPowerSave();
+        static bool isPowerSaveActive() { return powerSaveActive; }
+
+        // listen_intervalを設定してからWiFiへの接続を始める（完了は待たない）
+        // WiFi.beginは既定値で設定を上書きするため、接続せずに設定だけ行ってから接続する
+        static void beginStation(const char *ssid, const char *password);
+
+        // メインループがイベントを待っていた時間を記録する
+        static void recordIdle(unsigned long idleMicros);
+
+        // 前回の呼び出しからメインループ（loopタスクのみ）が起きていた割合（%）を返し、区間を区切り直す
+        static float takeDutyCyclePercent();
+
+        // 統計をリセット
+        static void resetStats();
+
+        // 省電力の状態と起動率をJSONとして返す（シリアルコンソールから参照する）
+        static String buildReportJson();
+
+    private:
+        // 省電力モードと無線を使うスコープの数（radioLockを取って読み書きする）
+        static volatile bool powerSaveActive;
+        static uint32_t radioBoostDepth;
+        static bool frequencyScaling; // 動的周波数制御が使えるか
+
+        // 累計と、takeDutyCyclePercentで区切る区間の計測値
+        static uint64_t statsStartMicros;
+        static uint64_t totalIdleMicros;
+        static uint64_t windowStartMicros;
+        static uint64_t windowIdleMicros;
+
+        // 省電力モードだった時間
+        static uint64_t powerSaveMicros;
+        static uint64_t powerSaveSinceMicros;
+
+        // 最大周波数を保っていた時間（コアをまたいで入れ子になるためロックで守る）
+        static uint32_t boostDepth;
+        static uint64_t boostMicros;
+        static uint64_t boostSinceMicros;
+
+        static void beginBoost();
+        static void endBoost();
+        static void beginRadioBoost();
+        static void endRadioBoost();
+        static void applySleepMode();
+        static void configureFrequency(uint32_t minFreqMhz);
+        static void configureListenInterval();
+        static float toPercent(uint64_t part, uint64_t whole);
+    };
+}
+
+#endif // POWER_MANAGER_H
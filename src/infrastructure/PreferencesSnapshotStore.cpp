@@ -0,0 +1,152 @@
+// PreferencesSnapshotStore.cpp
+// スケジュールをNVS（Preferences）にCRC付きで保存するSnapshotStoreの実装
+
+#include "PreferencesSnapshotStore.h"
+#include <esp_rom_crc.h>
+#include <string.h>
+
+namespace Infrastructure
+{
+    bool PreferencesSnapshotStore::save(const Domain::ScheduleSnapshot &snapshot)
+    {
+        uint8_t blob[BLOB_SIZE];
+        encode(snapshot, blob);
+
+        if (!preferences.begin(PREF_NAMESPACE, false))
+        {
+            Serial.println("Failed to open snapshot storage");
+            return false;
+        }
+
+        // 更新のたびにフラッシュへ書き込まないよう、内容が変わった場合だけ保存する
+        uint8_t saved[BLOB_SIZE];
+        bool unchanged = preferences.getBytesLength(SNAPSHOT_KEY) == BLOB_SIZE &&
+                         preferences.getBytes(SNAPSHOT_KEY, saved, BLOB_SIZE) == BLOB_SIZE &&
+                         memcmp(saved, blob, BLOB_SIZE) == 0;
+
+        bool result = unchanged || preferences.putBytes(SNAPSHOT_KEY, blob, BLOB_SIZE) == BLOB_SIZE;
+        preferences.end();
+
+        if (!unchanged)
+        {
+            Serial.println(result ? "Schedule snapshot saved" : "Failed to save schedule snapshot");
+        }
+        return result;
+    }
+
+    bool PreferencesSnapshotStore::load(Domain::ScheduleSnapshot &snapshot)
+    {
+        if (!preferences.begin(PREF_NAMESPACE, true))
+        {
+            // 一度も保存していない場合はネームスペースがない
+            return false;
+        }
+
+        uint8_t blob[BLOB_SIZE];
+        bool read = preferences.getBytesLength(SNAPSHOT_KEY) == BLOB_SIZE &&
+                    preferences.getBytes(SNAPSHOT_KEY, blob, BLOB_SIZE) == BLOB_SIZE;
+        preferences.end();
+
+        if (!read)
+        {
+            return false;
+        }
+
+        if (!decode(blob, snapshot))
+        {
+            Serial.println("Saved schedule snapshot is corrupted or outdated");
+            return false;
+        }
+
+        return true;
+    }
+
+    void PreferencesSnapshotStore::encode(const Domain::ScheduleSnapshot &snapshot, uint8_t *blob)
+    {
+        blob[0] = FORMAT_VERSION;
+        blob[1] = Domain::BattleType::TYPE_COUNT;
+        blob[2] = Domain::ScheduleSnapshot::SLOT_COUNT;
+        blob[3] = 0;
+
+        uint8_t *record = blob + HEADER_SIZE;
+        for (size_t type = 0; type < Domain::BattleType::TYPE_COUNT; type++)
+        {
+            for (size_t slot = 0; slot < Domain::ScheduleSnapshot::SLOT_COUNT; slot++)
+            {
+                const Domain::BattleSchedule &schedule =
+                    snapshot.get(static_cast<Domain::BattleType::Type>(type), slot);
+
+                record[0] = schedule.isValid() ? 1 : 0;
+                record[1] = static_cast<uint8_t>(schedule.getRule().getType());
+                record[2] = static_cast<uint8_t>(schedule.getStage1().getType());
+                record[3] = static_cast<uint8_t>(schedule.getStage2().getType());
+                writeUint32(record + 4, (uint32_t)(schedule.getStartEpoch() / 60));
+                writeUint32(record + 8, (uint32_t)(schedule.getEndEpoch() / 60));
+                record += SLOT_RECORD_SIZE;
+            }
+        }
+
+        writeUint32(record, esp_rom_crc32_le(0, blob, BLOB_SIZE - 4));
+    }
+
+    bool PreferencesSnapshotStore::decode(const uint8_t *blob, Domain::ScheduleSnapshot &snapshot)
+    {
+        if (readUint32(blob + BLOB_SIZE - 4) != esp_rom_crc32_le(0, blob, BLOB_SIZE - 4) ||
+            blob[0] != FORMAT_VERSION ||
+            blob[1] != Domain::BattleType::TYPE_COUNT ||
+            blob[2] != Domain::ScheduleSnapshot::SLOT_COUNT)
+        {
+            return false;
+        }
+
+        // 全スロットを確認してから書き込み、途中で失敗しても呼び出し元の内容を壊さない
+        Domain::ScheduleSnapshot decoded;
+        const uint8_t *record = blob + HEADER_SIZE;
+        for (size_t type = 0; type < Domain::BattleType::TYPE_COUNT; type++)
+        {
+            Domain::BattleType battleType = Domain::BattleType::fromType(static_cast<Domain::BattleType::Type>(type));
+            for (size_t slot = 0; slot < Domain::ScheduleSnapshot::SLOT_COUNT; slot++, record += SLOT_RECORD_SIZE)
+            {
+                if (record[0] == 0)
+                {
+                    continue;
+                }
+
+                if (record[1] > static_cast<uint8_t>(Domain::Rule::Type::UNKNOWN) ||
+                    record[2] > static_cast<uint8_t>(Domain::Stage::Type::UNKNOWN) ||
+                    record[3] > static_cast<uint8_t>(Domain::Stage::Type::UNKNOWN))
+                {
+                    return false;
+                }
+
+                decoded.set(battleType.getType(), slot,
+                            Domain::BattleSchedule::create(
+                                battleType,
+                                Domain::Rule::fromType(static_cast<Domain::Rule::Type>(record[1])),
+                                Domain::Stage::fromType(static_cast<Domain::Stage::Type>(record[2])),
+                                Domain::Stage::fromType(static_cast<Domain::Stage::Type>(record[3])),
+                                (time_t)readUint32(record + 4) * 60,
+                                (time_t)readUint32(record + 8) * 60));
+            }
+        }
+
+        snapshot = decoded;
+        return true;
+    }
+
+    void PreferencesSnapshotStore::writeUint32(uint8_t *buffer, uint32_t value)
+    {
+        buffer[0] = (uint8_t)value;
+        buffer[1] = (uint8_t)(value >> 8);
+        buffer[2] = (uint8_t)(value >> 16);
+        buffer[3] = (uint8_t)(value >> 24);
+    }
+
+    uint32_t PreferencesSnapshotStore::readUint32(const uint8_t *buffer)
+    {
+        return (uint32_t)buffer[0] |
+               ((uint32_t)buffer[1] << 8) |
+               ((uint32_t)buffer[2] << 16) |
+               ((uint32_t)buffer[3] << 24);
+    }
+}
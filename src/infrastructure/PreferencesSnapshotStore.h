@@ -0,0 +1,55 @@
+// PreferencesSnapshotStore.h
+// スケジュールをNVS（Preferences）にCRC付きで保存するSnapshotStoreの実装
+
+#ifndef PREFERENCES_SNAPSHOT_STORE_H
+#define PREFERENCES_SNAPSHOT_STORE_H
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include "../application/SnapshotStore.h"
+#include "../domain/ScheduleSnapshot.h"
+
+namespace Infrastructure
+{
+    // Stores the snapshot as one fixed-size NVS blob protected by a CRC32.
+    // Slots are written field by field rather than as the in-memory struct, and the
+    // blob carries a format version, so a firmware update that changes the layout or
+    // the catalogs only loses the cache instead of showing wrong data.
+    // Owns its Preferences handle because it is saved from the fetch task.
+    class PreferencesSnapshotStore : public Application::SnapshotStore
+    {
+    public:
+        // ルール・ステージの列挙の並びや保存形式を変えたら上げる
+        static constexpr uint8_t FORMAT_VERSION = 1;
+
+        // スケジュールを保存する（前回保存したものと同じ場合は書き込まない）
+        bool save(const Domain::ScheduleSnapshot &snapshot) override;
+
+        // 保存したスケジュールを読み込む（保存されていない、または壊れている場合はfalse）
+        bool load(Domain::ScheduleSnapshot &snapshot) override;
+
+    private:
+        static constexpr const char *PREF_NAMESPACE = "schedule";
+        static constexpr const char *SNAPSHOT_KEY = "snapshot";
+
+        // 1スロットの大きさ（有効フラグ、ルール、ステージ2つ、開始・終了時刻の分）
+        static constexpr size_t SLOT_RECORD_SIZE = 12;
+
+        // ヘッダ（形式、バトルタイプ数、スロット数、予約）+ スロット + CRC32
+        static constexpr size_t HEADER_SIZE = 4;
+        static constexpr size_t SLOT_RECORD_COUNT = Domain::BattleType::TYPE_COUNT * Domain::ScheduleSnapshot::SLOT_COUNT;
+        static constexpr size_t BLOB_SIZE = HEADER_SIZE + SLOT_RECORD_COUNT * SLOT_RECORD_SIZE + 4;
+
+        Preferences preferences;
+
+        // スナップショットを保存形式に書き出す・保存形式から読み込む
+        static void encode(const Domain::ScheduleSnapshot &snapshot, uint8_t *blob);
+        static bool decode(const uint8_t *blob, Domain::ScheduleSnapshot &snapshot);
+
+        // リトルエンディアンで32ビット値を読み書きする
+        static void writeUint32(uint8_t *buffer, uint32_t value);
+        static uint32_t readUint32(const uint8_t *buffer);
+    };
+}
+
+#endif // PREFERENCES_SNAPSHOT_STORE_H
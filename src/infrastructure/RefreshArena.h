@@ -0,0 +1,177 @@
+// RefreshArena.h
+// 1回のデータ更新の間だけ使うJSON用のバンプアロケータ
+
+#ifndef REFRESH_ARENA_H
+#define REFRESH_ARENA_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace Infrastructure
+{
+    // Allocates ArduinoJson memory from a fixed block owned by the instance.
+    // Freed blocks are reclaimed when they are the most recent allocation or when
+    // no block is live any more; reset() releases everything at once after the refresh.
+    // Requests that do not fit fall back to the general heap and are counted.
+    template <size_t Capacity>
+    class RefreshArena : public ArduinoJson::Allocator
+    {
+    public:
+        RefreshArena() : used(0), lastBlock(0), liveBlocks(0), peak(0), heapFallbacks(0) {}
+
+        void *allocate(size_t size) override
+        {
+            size_t total = blockSize(size);
+            if (total > Capacity - used)
+            {
+                heapFallbacks++;
+                return malloc(size);
+            }
+
+            Header *header = reinterpret_cast<Header *>(buffer + used);
+            header->size = size;
+            lastBlock = used;
+            used += total;
+            liveBlocks++;
+            if (used > peak)
+            {
+                peak = used;
+            }
+            return header + 1;
+        }
+
+        void deallocate(void *ptr) override
+        {
+            if (ptr == nullptr)
+            {
+                return;
+            }
+            if (!owns(ptr))
+            {
+                free(ptr);
+                return;
+            }
+
+            release(ptr);
+        }
+
+        void *reallocate(void *ptr, size_t newSize) override
+        {
+            if (ptr == nullptr)
+            {
+                return allocate(newSize);
+            }
+            if (!owns(ptr))
+            {
+                return realloc(ptr, newSize);
+            }
+
+            Header *header = reinterpret_cast<Header *>(ptr) - 1;
+
+            // 直前のブロックはその場で伸縮できる（文字列の組み立てやプールの縮小）
+            if (isLastBlock(ptr) && blockSize(newSize) <= Capacity - lastBlock)
+            {
+                header->size = newSize;
+                used = lastBlock + blockSize(newSize);
+                if (used > peak)
+                {
+                    peak = used;
+                }
+                return ptr;
+            }
+
+            if (newSize <= header->size)
+            {
+                header->size = newSize;
+                return ptr;
+            }
+
+            void *moved = allocate(newSize);
+            if (moved != nullptr)
+            {
+                memcpy(moved, ptr, header->size);
+                release(ptr);
+            }
+            return moved;
+        }
+
+        // 全てのブロックを一度に解放する（確保したドキュメントが残っていないこと）
+        void reset()
+        {
+            used = 0;
+            lastBlock = 0;
+            liveBlocks = 0;
+        }
+
+        // 統計情報
+        size_t getUsed() const { return used; }
+        size_t getPeak() const { return peak; }
+        unsigned long getHeapFallbacks() const { return heapFallbacks; }
+        void resetStats()
+        {
+            peak = used;
+            heapFallbacks = 0;
+        }
+
+        static constexpr size_t capacity() { return Capacity; }
+
+    private:
+        static constexpr size_t ALIGNMENT = 8;
+
+        // 各ブロックの先頭に置くサイズ情報（reallocateでの複製に使う）
+        // 直後のブロック本体が揃うようにヘッダ自体をALIGNMENTに揃える
+        struct alignas(ALIGNMENT) Header
+        {
+            size_t size;
+        };
+
+        alignas(ALIGNMENT) uint8_t buffer[Capacity];
+        size_t used;       // 使用済みのバイト数
+        size_t lastBlock;  // 直前に確保したブロックのヘッダ位置
+        size_t liveBlocks; // 解放されていないブロック数
+        size_t peak;       // 使用量の最大値
+        unsigned long heapFallbacks;
+
+        static size_t blockSize(size_t size)
+        {
+            return (sizeof(Header) + size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+        }
+
+        // 領域内のブロックを解放する
+        void release(const void *ptr)
+        {
+            if (liveBlocks > 0)
+            {
+                liveBlocks--;
+            }
+
+            // 全て解放されたら先頭から使い直し、直前のブロックなら巻き戻す
+            // それ以外の隙間はreset()まで残す
+            if (liveBlocks == 0)
+            {
+                used = 0;
+                lastBlock = 0;
+            }
+            else if (isLastBlock(ptr))
+            {
+                used = lastBlock;
+            }
+        }
+
+        bool owns(const void *ptr) const
+        {
+            const uint8_t *p = static_cast<const uint8_t *>(ptr);
+            return p >= buffer && p < buffer + Capacity;
+        }
+
+        bool isLastBlock(const void *ptr) const
+        {
+            return used > lastBlock &&
+                   static_cast<const uint8_t *>(ptr) == buffer + lastBlock + sizeof(Header);
+        }
+    };
+}
+
+#endif // REFRESH_ARENA_H
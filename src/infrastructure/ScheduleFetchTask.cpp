@@ -0,0 +1,122 @@
+// ScheduleFetchTask.cpp
+// スケジュール取得タスクの実装
+
+#include "ScheduleFetchTask.h"
+#include "PowerManager.h"
+
+namespace Infrastructure
+{
+    ScheduleFetchTask::ScheduleFetchTask(
+        Application::ScheduleApplicationService &applicationService,
+        Application::SnapshotStore &snapshotStore,
+        ESP32EventQueue &eventQueue)
+        : applicationService(applicationService),
+          snapshotStore(snapshotStore),
+          eventQueue(eventQueue),
+          taskHandle(nullptr),
+          frontIndex(0),
+          resultPending(false),
+          fetching(false)
+    {
+        portMUX_INITIALIZE(&lock);
+    }
+
+    bool ScheduleFetchTask::start()
+    {
+        if (taskHandle != nullptr)
+        {
+            return true;
+        }
+
+        BaseType_t created = xTaskCreatePinnedToCore(
+            taskEntry,
+            "scheduleFetch",
+            STACK_SIZE,
+            this,
+            PRIORITY,
+            &taskHandle,
+            CORE_ID);
+
+        if (created != pdPASS)
+        {
+            taskHandle = nullptr;
+            Serial.println("Failed to start schedule fetch task; fetching on the loop task");
+            return false;
+        }
+
+        Serial.println("Schedule fetch task started on core 0");
+        return true;
+    }
+
+    bool ScheduleFetchTask::requestFetch()
+    {
+        if (fetching)
+        {
+            return false;
+        }
+        fetching = true;
+
+        if (taskHandle == nullptr)
+        {
+            // タスクがない場合は呼び出し元でそのまま取得する
+            fetchAndPublish();
+            return true;
+        }
+
+        xTaskNotifyGive(taskHandle);
+        return true;
+    }
+
+    bool ScheduleFetchTask::takeResult(Domain::ScheduleSnapshot &snapshot, RefreshMetrics &result)
+    {
+        bool taken = false;
+
+        portENTER_CRITICAL(&lock);
+        if (resultPending)
+        {
+            snapshot = snapshots[frontIndex];
+            result = metrics[frontIndex];
+            resultPending = false;
+            taken = true;
+        }
+        portEXIT_CRITICAL(&lock);
+
+        return taken;
+    }
+
+    void ScheduleFetchTask::taskEntry(void *parameter)
+    {
+        ScheduleFetchTask *task = static_cast<ScheduleFetchTask *>(parameter);
+        for (;;)
+        {
+            // 要求があるまで待機する
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            task->fetchAndPublish();
+        }
+    }
+
+    void ScheduleFetchTask::fetchAndPublish()
+    {
+        // 表裏を切り替えるのはこのタスクだけなので、裏バッファはロックなしで書き込める
+        uint8_t backIndex = 1 - frontIndex;
+        {
+            PowerManager::BoostScope boost(true);
+            metrics[backIndex] = applicationService.fetchAllData(snapshots[backIndex]);
+        }
+
+        portENTER_CRITICAL(&lock);
+        frontIndex = backIndex;
+        resultPending = true;
+        fetching = false;
+        portEXIT_CRITICAL(&lock);
+
+        eventQueue.post(Application::AppEvent::FETCH_COMPLETED);
+
+        // 表バッファを書き換えるのも次の取得を行うこのタスクだけなので、描画と並行して読み出せる
+        // 取得に失敗した場合は前回保存したものを残す
+        if (metrics[frontIndex].updated)
+        {
+            snapshotStore.save(snapshots[frontIndex]);
+        }
+    }
+}
@@ -0,0 +1,72 @@
+// ScheduleFetchTask.h
+// スケジュールの取得と解析をコア0の専用タスクで行い、結果をダブルバッファで受け渡す
+
+#ifndef SCHEDULE_FETCH_TASK_H
+#define SCHEDULE_FETCH_TASK_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "../application/ScheduleApplicationService.h"
+#include "../application/SnapshotStore.h"
+#include "../domain/ScheduleSnapshot.h"
+#include "ESP32EventQueue.h"
+
+namespace Infrastructure
+{
+    // Runs ScheduleApplicationService::fetchAllData on a FreeRTOS task pinned to core 0
+    // so that the loop task on core 1 keeps drawing the clock while a refresh is in flight.
+    // Once started, the task is the only user of the schedule repository and network service.
+    // Each published result is announced to the loop task with AppEvent::FETCH_COMPLETED,
+    // and changed schedules are then saved to flash from this task for the next boot.
+    class ScheduleFetchTask
+    {
+    public:
+        using RefreshMetrics = Application::ScheduleApplicationService::RefreshMetrics;
+
+        // TLSハンドシェイクとJSONの解析に十分なスタック
+        static constexpr uint32_t STACK_SIZE = 12 * 1024;
+        static constexpr UBaseType_t PRIORITY = 1;
+        static constexpr BaseType_t CORE_ID = 0;
+
+        ScheduleFetchTask(
+            Application::ScheduleApplicationService &applicationService,
+            Application::SnapshotStore &snapshotStore,
+            ESP32EventQueue &eventQueue);
+
+        // タスクを起動する（失敗した場合、取得は要求したタスクでそのまま行う）
+        bool start();
+
+        // 取得を要求する（取得中の場合はfalse）
+        bool requestFetch();
+
+        // 取得中かどうか（要求してから結果を公開するまで）
+        bool isFetching() const { return fetching; }
+
+        // 新しい結果が公開されていれば描画側のバッファにコピーしてtrueを返す
+        bool takeResult(Domain::ScheduleSnapshot &snapshot, RefreshMetrics &metrics);
+
+    private:
+        Application::ScheduleApplicationService &applicationService;
+        Application::SnapshotStore &snapshotStore;
+        ESP32EventQueue &eventQueue;
+        TaskHandle_t taskHandle;
+
+        // 取得タスクが書き込む裏バッファと、描画側が読み出す表バッファ
+        // 裏バッファへの書き込みはロックなしで行い、表裏の切り替えと読み出しだけをロックで守る
+        Domain::ScheduleSnapshot snapshots[2];
+        RefreshMetrics metrics[2];
+        uint8_t frontIndex;
+        bool resultPending;
+        volatile bool fetching;
+        portMUX_TYPE lock;
+
+        static void taskEntry(void *parameter);
+
+        // 取得して裏バッファに書き込み、表裏を切り替えてループに通知する
+        // スケジュールが変わった場合は、通知の後で次回の起動用に保存する
+        void fetchAndPublish();
+    };
+}
+
+#endif // SCHEDULE_FETCH_TASK_H
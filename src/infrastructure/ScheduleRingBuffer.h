@@ -0,0 +1,98 @@
+// ScheduleRingBuffer.h
+// Fixed-capacity ring buffer of upcoming schedule slots for one battle type
+
+#ifndef SCHEDULE_RING_BUFFER_H
+#define SCHEDULE_RING_BUFFER_H
+
+#include <Arduino.h>
+#include <time.h>
+#include "../domain/BattleSchedule.h"
+
+namespace Infrastructure
+{
+
+    // Holds up to Capacity upcoming slots in start-time order without heap allocation.
+    // Index 0 is the current slot; expired slots are dropped from the front.
+    template <size_t Capacity>
+    class ScheduleRingBuffer
+    {
+    public:
+        ScheduleRingBuffer() : head(0), count(0) {}
+
+        static constexpr size_t capacity() { return Capacity; }
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+
+        // index番目のスロット（0が現在のスロット）
+        const Domain::BattleSchedule &at(size_t index) const
+        {
+            return slots[(head + index) % Capacity];
+        }
+
+        void clear()
+        {
+            head = 0;
+            count = 0;
+        }
+
+        // 末尾にスロットを追加する（満杯の場合はfalse）
+        bool push(const Domain::BattleSchedule &slot)
+        {
+            if (count >= Capacity)
+            {
+                return false;
+            }
+
+            slots[(head + count) % Capacity] = slot;
+            count++;
+            return true;
+        }
+
+        // index番目のスロットを置き換える（index == size()の場合は末尾に追加）
+        bool set(size_t index, const Domain::BattleSchedule &slot)
+        {
+            if (index == count)
+            {
+                return push(slot);
+            }
+            if (index > count)
+            {
+                return false;
+            }
+
+            slots[(head + index) % Capacity] = slot;
+            return true;
+        }
+
+        // 先頭からnewSize個だけを残す
+        void truncate(size_t newSize)
+        {
+            if (newSize < count)
+            {
+                count = newSize;
+            }
+        }
+
+        // 終了時刻を過ぎたスロットを先頭から取り除き、取り除いた数を返す
+        // 終了時刻が不明なスロットで止める
+        size_t dropExpired(time_t now)
+        {
+            size_t dropped = 0;
+            while (count > 0 && slots[head].getEndEpoch() != 0 && slots[head].getEndEpoch() <= now)
+            {
+                head = (head + 1) % Capacity;
+                count--;
+                dropped++;
+            }
+            return dropped;
+        }
+
+    private:
+        Domain::BattleSchedule slots[Capacity];
+        size_t head;
+        size_t count;
+    };
+
+} // namespace Infrastructure
+
+#endif // SCHEDULE_RING_BUFFER_H
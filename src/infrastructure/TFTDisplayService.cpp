@@ -1,80 +1,228 @@
 #include "TFTDisplayService.h"
 #include <cstring>
 #include "DeviceInfo.h"
+#include "MemoryManager.h"
 
 namespace Infrastructure
 {
     // 静的変数の初期化
     bool TFTDisplayService::isFirstStatusCall = true;
+    constexpr int TFTDisplayService::ROW_OFFSETS[];
+    constexpr int TFTDisplayService::ROW_HEIGHTS[];
+
+    namespace
+    {
+        // 0〜99の値を2桁の数字として書き込む
+        void writeTwoDigits(char *buffer, int value)
+        {
+            buffer[0] = (char)('0' + value / 10);
+            buffer[1] = (char)('0' + value % 10);
+        }
+    }
+
+    void TFTDisplayService::formatBottomInfo(char *currentDateTime, char *lastUpdateTime)
+    {
+        time_t now;
+        struct tm timeinfo;
+        time(&now);
+        localtime_r(&now, &timeinfo);
+
+        // 表示は固定長なので、strftimeを通さずに数字を直接書き込む（"YYYY-MM-DD HH:MM"）
+        int year = timeinfo.tm_year + 1900;
+        writeTwoDigits(currentDateTime, (year / 100) % 100);
+        writeTwoDigits(currentDateTime + 2, year % 100);
+        currentDateTime[4] = '-';
+        writeTwoDigits(currentDateTime + 5, timeinfo.tm_mon + 1);
+        currentDateTime[7] = '-';
+        writeTwoDigits(currentDateTime + 8, timeinfo.tm_mday);
+        currentDateTime[10] = ' ';
+        writeTwoDigits(currentDateTime + 11, timeinfo.tm_hour);
+        currentDateTime[13] = ':';
+        writeTwoDigits(currentDateTime + 14, timeinfo.tm_min);
+        currentDateTime[16] = '\0';
+
+        // 最終更新時刻は現在時刻を5分単位に丸める（例：23:17→23:15）
+        writeTwoDigits(lastUpdateTime, timeinfo.tm_hour);
+        lastUpdateTime[2] = ':';
+        writeTwoDigits(lastUpdateTime + 3, (timeinfo.tm_min / 5) * 5);
+        lastUpdateTime[5] = '\0';
+    }
+
+    void TFTDisplayService::drawChangedGlyphs(int x, int y, const char *text, char *shown)
+    {
+        for (size_t i = 0; text[i] != '\0'; i++)
+        {
+            if (text[i] == shown[i])
+            {
+                continue;
+            }
+
+            // 背景色を指定すると文字セル全体を塗るため、事前の消去は不要
+            tft.drawChar(x + (int)i * GLYPH_WIDTH, y, text[i], TFT_WHITE, TFT_BLACK, 1);
+            pixelsPushed += GLYPH_WIDTH * GLYPH_HEIGHT;
+            shown[i] = text[i];
+        }
+    }
 
     void TFTDisplayService::updateScreen(
-        const Domain::BattleSchedule &regularSchedule,
-        const Domain::BattleSchedule &regularNextSchedule,
-        const Domain::BattleSchedule &xMatchSchedule,
-        const Domain::BattleSchedule &xMatchNextSchedule,
-        const Domain::BattleSchedule &bankaraChallengeSchedule,
-        const Domain::BattleSchedule &bankaraChallengeNextSchedule,
-        const Domain::BattleSchedule &bankaraOpenSchedule,
-        const Domain::BattleSchedule &bankaraOpenNextSchedule,
+        const Domain::ScheduleSnapshot &snapshot,
         const char *currentDateTime,
         const char *lastUpdateTime,
         const Domain::DisplaySettings &displaySettings)
     {
+        MemoryManager::PhaseScope renderScope(MemoryManager::Phase::RENDER);
+
         // 現在の反転状態を保存
         bool currentInverted = isInverted;
 
-        // Clear screen
-        clearScreen();
+        pixelsPushed = 0;
+
+        // 新しい表示内容を組み立てる（区画はBattleType::Typeの順：左上から右下へ）
+        for (int quadrant = 0; quadrant < 4; quadrant++)
+        {
+            Domain::BattleType::Type type = static_cast<Domain::BattleType::Type>(quadrant);
+            buildQuadrantModel(snapshot.getCurrent(type), snapshot.getNext(type), snapshot.isStale(type),
+                               displaySettings, pendingQuadrants[quadrant]);
+        }
+
+        // 別の画面から切り替わった場合は画面全体を描き直す
+        // スケジュール画面のままなら、前回から変化した区画だけを描き直す
+        bool fullRepaint = !showingSchedules;
+        bool dirty[4];
+        bool anyDirty = false;
+        for (int quadrant = 0; quadrant < 4; quadrant++)
+        {
+            dirty[quadrant] = fullRepaint || !pendingQuadrants[quadrant].sameAs(shownQuadrants[quadrant]);
+            anyDirty |= dirty[quadrant];
+        }
 
         // Turn on backlight to full brightness
         setBacklight(255);
 
-        // Draw each quadrant
-        drawBattleQuadrant(0, 0, regularSchedule, regularNextSchedule, displaySettings);
-        drawBattleQuadrant(QUADRANT_WIDTH, 0, xMatchSchedule, xMatchNextSchedule, displaySettings);
-        drawBattleQuadrant(0, QUADRANT_HEIGHT, bankaraChallengeSchedule, bankaraChallengeNextSchedule, displaySettings);
-        drawBattleQuadrant(QUADRANT_WIDTH, QUADRANT_HEIGHT, bankaraOpenSchedule, bankaraOpenNextSchedule, displaySettings);
+        if (anyDirty)
+        {
+            // 一時的に反転を無効化して描画
+            if (currentInverted)
+            {
+                tft.invertDisplay(false);
+            }
 
-        // Draw dividing lines
-        tft.drawLine(QUADRANT_WIDTH, 0, QUADRANT_WIDTH, SCREEN_HEIGHT, TFT_WHITE);
-        tft.drawLine(0, QUADRANT_HEIGHT, SCREEN_WIDTH, QUADRANT_HEIGHT, TFT_WHITE);
+            if (spritesAllocated)
+            {
+                // 区画は区切り線を含めて画面の上部を覆うため、全画面クリアは不要
+                pushQuadrantSprites(dirty);
+            }
+            else
+            {
+                // 初期化時にスプライトを確保できなかった場合は変化した行だけを直接描画する
+                directDrawCount++;
+                if (fullRepaint)
+                {
+                    // Clear screen
+                    clearScreen();
 
-        // Update bottom info (current date/time and update time)
-        updateBottomInfo(currentDateTime, lastUpdateTime);
+                    // Draw dividing lines
+                    tft.drawLine(QUADRANT_WIDTH, 0, QUADRANT_WIDTH, SCREEN_HEIGHT, TFT_WHITE);
+                    tft.drawLine(0, QUADRANT_HEIGHT, SCREEN_WIDTH, QUADRANT_HEIGHT, TFT_WHITE);
+                    pixelsPushed += SCREEN_WIDTH + SCREEN_HEIGHT;
+                }
 
-        // 反転状態を復元
-        if (currentInverted)
+                for (int quadrant = 0; quadrant < 4; quadrant++)
+                {
+                    if (dirty[quadrant])
+                    {
+                        drawBattleQuadrant(
+                            (quadrant % 2) * QUADRANT_WIDTH,
+                            (quadrant / 2) * QUADRANT_HEIGHT,
+                            pendingQuadrants[quadrant],
+                            shownQuadrants[quadrant],
+                            fullRepaint);
+                    }
+                }
+            }
+
+            for (int quadrant = 0; quadrant < 4; quadrant++)
+            {
+                shownQuadrants[quadrant] = pendingQuadrants[quadrant];
+            }
+
+            // 反転状態を復元
+            if (currentInverted)
+            {
+                tft.invertDisplay(true);
+            }
+        }
+
+        // 画面が切り替わった場合は下部情報バーも描き直させる
+        if (fullRepaint)
         {
-            tft.invertDisplay(true);
+            shownDateTime[0] = '\0';
         }
+        showingSchedules = true;
+
+        // Update bottom info (current date/time and update time)
+        updateBottomInfo(currentDateTime, lastUpdateTime);
+
+        lastUpdatePixelsPushed = pixelsPushed;
+        Serial.print("Display update: ");
+        Serial.print(lastUpdatePixelsPushed);
+        Serial.println(" pixels pushed");
     }
 
     void TFTDisplayService::updateBottomInfo(
         const char *currentDateTime,
         const char *lastUpdateTime)
     {
+        // スケジュール画面で同じ長さの文字列が表示済みなら、変化した文字のセルだけを描き直す
+        // 毎分の更新では分の1〜2文字（5分ごとに最終更新時刻の数文字）だけを送る
+        if (showingSchedules && !updateIndicatorVisible && shownDateTime[0] != '\0' &&
+            strlen(currentDateTime) == strlen(shownDateTime) &&
+            strlen(lastUpdateTime) == strlen(shownUpdateTime))
+        {
+            drawChangedGlyphs(DATE_TIME_X, BOTTOM_TEXT_Y, currentDateTime, shownDateTime);
+            drawChangedGlyphs(SCREEN_WIDTH - 10 - tft.textWidth(lastUpdateTime), BOTTOM_TEXT_Y, lastUpdateTime, shownUpdateTime);
+            return;
+        }
+
         // 現在の反転状態を保存
         bool currentInverted = isInverted;
 
+        // 更新インジケータは下部情報バーの1ピクセル上まではみ出すため、その部分も消す
+        if (updateIndicatorVisible)
+        {
+            tft.fillRect(SCREEN_WIDTH - 13, SCREEN_HEIGHT - 13, 7, 1, TFT_BLACK);
+            pixelsPushed += 7;
+            updateIndicatorVisible = false;
+        }
+
         // Clear the bottom info area
         tft.fillRect(0, SCREEN_HEIGHT - 12, SCREEN_WIDTH, 12, TFT_BLACK);
+        pixelsPushed += SCREEN_WIDTH * 12;
 
         // Display current date/time
         tft.setTextColor(TFT_WHITE);
         tft.setTextSize(1);
-        tft.setCursor(4, SCREEN_HEIGHT - 12);
+        tft.setCursor(DATE_TIME_X, BOTTOM_TEXT_Y);
         tft.print(currentDateTime);
 
         // Display last update time at the right side
         tft.setTextColor(TFT_WHITE);
         tft.setTextSize(1);
         int textWidth = tft.textWidth(lastUpdateTime) + tft.textWidth("Updated: ");
-        tft.setCursor(SCREEN_WIDTH - textWidth - 10, SCREEN_HEIGHT - 12);
+        tft.setCursor(SCREEN_WIDTH - textWidth - 10, BOTTOM_TEXT_Y);
         tft.print("Updated: ");
         tft.print(lastUpdateTime);
+        pixelsPushed += (unsigned long)(tft.textWidth(currentDateTime) + textWidth) * 8;
 
         // Redraw any dividing line that crosses the bottom info area
         tft.drawLine(QUADRANT_WIDTH, SCREEN_HEIGHT - 12, QUADRANT_WIDTH, SCREEN_HEIGHT, TFT_WHITE);
+        pixelsPushed += 12;
+
+        // 次回の比較用に表示内容を記録
+        strncpy(shownDateTime, currentDateTime, sizeof(shownDateTime) - 1);
+        shownDateTime[sizeof(shownDateTime) - 1] = '\0';
+        strncpy(shownUpdateTime, lastUpdateTime, sizeof(shownUpdateTime) - 1);
+        shownUpdateTime[sizeof(shownUpdateTime) - 1] = '\0';
 
         // 反転状態を復元
         if (currentInverted)
@@ -95,6 +243,7 @@ namespace Infrastructure
         }
 
         clearScreen();
+        showingSchedules = false;
 
         // 画面上半分に背景色を設定
         tft.fillRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT / 2, SPLATOON_BLUE);
@@ -208,6 +357,9 @@ namespace Infrastructure
             }
         }
 
+        // ここから先は画面を描き換えるため、スケジュール画面ではなくなる
+        showingSchedules = false;
+
         // 初回呼び出し時のみ画面をクリアして背景やヘッダーを描画
         if (isFirstStatusCall)
         {
@@ -442,6 +594,7 @@ namespace Infrastructure
         {
             // 通常のロード画面（フルスクリーン）
             clearScreen();
+            showingSchedules = false;
 
             // 上部に背景色のヘッダーを表示
             tft.fillRect(0, 0, SCREEN_WIDTH, 30, SPLATOON_BLUE);
@@ -484,6 +637,7 @@ namespace Infrastructure
             // 画面下部の右端に小さな更新インジケータを表示
             uint16_t indicatorColor = blinkState ? SPLATOON_GREEN : SPLATOON_BLUE;
             tft.fillCircle(SCREEN_WIDTH - 10, SCREEN_HEIGHT - 10, 3, indicatorColor);
+            updateIndicatorVisible = true;
 
             // シリアルログにのみ更新状態を出力
             Serial.print("Background updating: ");
@@ -500,162 +654,260 @@ namespace Infrastructure
     void TFTDisplayService::drawBattleQuadrant(
         int x,
         int y,
-        const Domain::BattleSchedule &current,
-        const Domain::BattleSchedule &next,
-        const Domain::DisplaySettings &displaySettings)
+        const QuadrantModel &model,
+        QuadrantModel &shown,
+        bool fullRepaint)
     {
-        // 現在の反転状態を保存
-        bool currentInverted = isInverted;
+        // 右側と下側の区画は区切り線を避けて塗る
+        int leftInset = x > 0 ? 1 : 0;
+        int topInset = y > 0 ? 1 : 0;
 
-        // 一時的に反転を無効化して描画
-        if (currentInverted)
+        for (int row = 0; row < QUADRANT_ROWS; row++)
         {
-            tft.invertDisplay(false);
-        }
+            const TextRow &content = model.rows[row];
 
-        // Get the battle type for title and color
-        const Domain::BattleType &battleType = current.getBattleType();
-        uint16_t titleColor = battleType.getColor();
+            // 変化していない行と、全画面クリア直後の空行は描かない
+            if (!fullRepaint && content.sameAs(shown.rows[row]))
+            {
+                continue;
+            }
+            if (fullRepaint && content.prefix[0] == '\0' && content.text[0] == '\0' && content.backgroundColor == TFT_BLACK)
+            {
+                continue;
+            }
 
-        // Draw title background with specific color
-        tft.fillRect(x, y, QUADRANT_WIDTH, 16, titleColor);
+            pixelsPushed += paintRow(tft, x, y, leftInset, topInset, row, content);
+        }
+    }
 
-        // Draw title text
-        tft.setTextColor(TFT_BLACK); // Black text on colored background
-        tft.setTextSize(1);
-        tft.setCursor(x + 4, y + 4);
-        tft.println(battleType.getDisplayName(displaySettings.isUseRomajiForBattleType()));
+    bool TFTDisplayService::createQuadrantSprites()
+    {
+        // 16bitカラーのスプライトはDMAでそのまま転送できる
+        quadrantSprite.setColorDepth(16);
+        quadrantBackSprite.setColorDepth(16);
 
-        // If the schedule is not valid, show error and return
-        if (!current.isValid())
+        if (quadrantSprite.createSprite(QUADRANT_WIDTH, QUADRANT_HEIGHT) == nullptr)
         {
-            tft.setTextColor(TFT_RED);
-            tft.setCursor(x + 4, y + 20);
-            tft.println("Data Error");
+            Serial.println("Not enough memory for quadrant sprites. Drawing directly");
+            return false;
+        }
 
-            // 反転状態を復元
-            if (currentInverted)
-            {
-                tft.invertDisplay(true);
-            }
-            return;
+        if (quadrantBackSprite.createSprite(QUADRANT_WIDTH, QUADRANT_HEIGHT) == nullptr)
+        {
+            Serial.println("Not enough memory for quadrant sprites. Drawing directly");
+            quadrantSprite.deleteSprite();
+            return false;
         }
 
-        // Now draw the current schedule details
-        tft.setTextColor(TFT_WHITE);
-        int yPos = 20;
+        return true;
+    }
 
-        // 1. Time period
-        tft.setCursor(x + 4, y + yPos);
-        tft.print(current.getStartTime());
-        tft.print("-");
-        tft.println(current.getEndTime());
-        yPos += 10;
+    void TFTDisplayService::pushQuadrantSprites(const bool dirty[4])
+    {
+        TFT_eSprite *sprites[2] = {&quadrantSprite, &quadrantBackSprite};
+        int current = 0;
 
-        // 2. Rule with symbol (if not empty)
-        const Domain::Rule &rule = current.getRule();
-        const char *ruleSymbol = rule.getSymbol();
-        const char *ruleName = rule.getDisplayName(displaySettings.isUseRomajiForRule());
+        tft.startWrite();
 
-        if (strlen(ruleName) > 0 || strlen(ruleSymbol) > 0)
+        for (int quadrant = 0; quadrant < 4; quadrant++)
         {
-            // Draw rule symbol with its color
-            tft.setCursor(x + 4, y + yPos);
-            tft.setTextColor(rule.getSymbolColor());
-            tft.print(ruleSymbol);
+            if (!dirty[quadrant])
+            {
+                continue;
+            }
 
-            // Draw rule name in white
-            tft.setTextColor(TFT_WHITE);
-            tft.println(ruleName);
-            yPos += 10;
-        }
+            // 前の区画をDMAで転送している間に次の区画をもう一方のバッファに描く
+            TFT_eSprite &sprite = *sprites[current];
+            renderQuadrantSprite(sprite, quadrant % 2 != 0, quadrant / 2 != 0, pendingQuadrants[quadrant]);
 
-        // 3. Stage names in light grey
-        tft.setTextColor(TFT_LIGHTGREY);
+            int x = (quadrant % 2) * QUADRANT_WIDTH;
+            int y = (quadrant / 2) * QUADRANT_HEIGHT;
+            if (dmaAvailable)
+            {
+                // 前の転送が終わってから次の転送を始める（このバッファへの前回の転送もここで完了している）
+                tft.dmaWait();
+                tft.pushImageDMA(x, y, QUADRANT_WIDTH, QUADRANT_HEIGHT, (uint16_t *)sprite.getPointer());
+            }
+            else
+            {
+                sprite.pushSprite(x, y);
+            }
+            pixelsPushed += (unsigned long)QUADRANT_WIDTH * QUADRANT_HEIGHT;
 
-        // Stage 1
-        tft.setCursor(x + 4, y + yPos);
-        tft.print("- ");
-
-        // Get stage name and limit to 13 chars
-        const char *stage1Name = current.getStage1().getDisplayName(displaySettings.isUseRomajiForStage());
-        char shortenedStage[14]; // 13 chars + null terminator
-        strncpy(shortenedStage, stage1Name, 13);
-        shortenedStage[13] = '\0';
-        tft.println(shortenedStage);
-        yPos += 10;
-
-        // Stage 2
-        tft.setCursor(x + 4, y + yPos);
-        tft.print("- ");
-
-        // Get stage name and limit to 13 chars
-        const char *stage2Name = current.getStage2().getDisplayName(displaySettings.isUseRomajiForStage());
-        strncpy(shortenedStage, stage2Name, 13);
-        shortenedStage[13] = '\0';
-        tft.println(shortenedStage);
-        yPos += 15; // Slightly larger gap before next section
+            current = 1 - current;
+        }
 
-        // Next battle schedule (if valid)
-        if (next.isValid())
+        // 次の更新でバッファに描き始める前に転送の完了を待つ
+        if (dmaAvailable)
         {
-            tft.setTextColor(TFT_WHITE);
+            tft.dmaWait();
+        }
+        tft.endWrite();
+    }
 
-            // 1. Time period
-            tft.setCursor(x + 4, y + yPos);
-            tft.print(next.getStartTime());
-            tft.print("-");
-            tft.println(next.getEndTime());
-            yPos += 10;
+    void TFTDisplayService::renderQuadrantSprite(
+        TFT_eSprite &sprite,
+        bool rightSide,
+        bool bottomSide,
+        const QuadrantModel &model)
+    {
+        sprite.fillSprite(TFT_BLACK);
 
-            // 2. Rule with symbol (if not empty)
-            const Domain::Rule &nextRule = next.getRule();
-            const char *nextRuleSymbol = nextRule.getSymbol();
-            const char *nextRuleName = nextRule.getDisplayName(displaySettings.isUseRomajiForRule());
+        // 区切り線も区画の一部として描く（右側の区画は左端、下側の区画は上端）
+        if (rightSide)
+        {
+            sprite.drawFastVLine(0, 0, QUADRANT_HEIGHT, TFT_WHITE);
+        }
+        if (bottomSide)
+        {
+            sprite.drawFastHLine(0, 0, QUADRANT_WIDTH, TFT_WHITE);
+        }
 
-            if (strlen(nextRuleName) > 0 || strlen(nextRuleSymbol) > 0)
+        for (int row = 0; row < QUADRANT_ROWS; row++)
+        {
+            const TextRow &content = model.rows[row];
+            if (content.prefix[0] == '\0' && content.text[0] == '\0' && content.backgroundColor == TFT_BLACK)
             {
-                // Draw rule symbol with its color
-                tft.setCursor(x + 4, y + yPos);
-                tft.setTextColor(nextRule.getSymbolColor());
-                tft.print(nextRuleSymbol);
-
-                // Draw rule name in white
-                tft.setTextColor(TFT_WHITE);
-                tft.println(nextRuleName);
-                yPos += 10;
+                continue;
             }
 
-            // 3. Stage names in light grey
-            tft.setTextColor(TFT_LIGHTGREY);
+            paintRow(sprite, 0, 0, rightSide ? 1 : 0, bottomSide ? 1 : 0, row, content);
+        }
+    }
 
-            // Stage 1
-            tft.setCursor(x + 4, y + yPos);
-            tft.print("- ");
+    void TFTDisplayService::buildQuadrantModel(
+        const Domain::BattleSchedule &current,
+        const Domain::BattleSchedule &next,
+        bool stale,
+        const Domain::DisplaySettings &displaySettings,
+        QuadrantModel &model)
+    {
+        // Get the battle type for title and color
+        const Domain::BattleType &battleType = current.getBattleType();
 
-            // Get stage name and limit to 13 chars
-            const char *nextStage1Name = next.getStage1().getDisplayName(displaySettings.isUseRomajiForStage());
-            strncpy(shortenedStage, nextStage1Name, 13);
-            shortenedStage[13] = '\0';
-            tft.println(shortenedStage);
-            yPos += 10;
+        // Title: black text on the battle type color
+        // 長い間確認できていないスロットを表示している場合は、バトルタイプの色の文字を灰色の帯に載せる
+        setRow(
+            model.rows[0],
+            "",
+            TFT_BLACK,
+            battleType.getDisplayName(displaySettings.isUseRomajiForBattleType()),
+            stale ? battleType.getColor() : TFT_BLACK,
+            stale ? TFT_DARKGREY : battleType.getColor());
+
+        // If the schedule is not valid, show error only
+        if (!current.isValid())
+        {
+            setRow(model.rows[1], "", TFT_RED, "Data Error", TFT_RED);
+            return;
+        }
 
-            // Stage 2
-            tft.setCursor(x + 4, y + yPos);
-            tft.print("- ");
+        // Current schedule details
+        buildScheduleRows(current, displaySettings, &model.rows[1]);
 
-            // Get stage name and limit to 13 chars
-            const char *nextStage2Name = next.getStage2().getDisplayName(displaySettings.isUseRomajiForStage());
-            strncpy(shortenedStage, nextStage2Name, 13);
-            shortenedStage[13] = '\0';
-            tft.println(shortenedStage);
+        // Next battle schedule (if valid)
+        if (next.isValid())
+        {
+            buildScheduleRows(next, displaySettings, &model.rows[5]);
         }
+    }
 
-        // 反転状態を復元
-        if (currentInverted)
+    void TFTDisplayService::buildScheduleRows(
+        const Domain::BattleSchedule &schedule,
+        const Domain::DisplaySettings &displaySettings,
+        TextRow *rows)
+    {
+        // 1. Time period（描画時にUNIX時間から整形する）
+        char startTime[Domain::BattleSchedule::TIME_TEXT_SIZE];
+        char endTime[Domain::BattleSchedule::TIME_TEXT_SIZE];
+        schedule.formatStartTime(startTime, sizeof(startTime));
+        schedule.formatEndTime(endTime, sizeof(endTime));
+
+        char period[12];
+        snprintf(period, sizeof(period), "%s-%s", startTime, endTime);
+        setRow(rows[0], "", TFT_WHITE, period, TFT_WHITE);
+
+        // 2. Rule symbol with its color, rule name in white
+        const Domain::Rule &rule = schedule.getRule();
+        setRow(
+            rows[1],
+            rule.getSymbol(),
+            rule.getSymbolColor(),
+            rule.getDisplayName(displaySettings.isUseRomajiForRule()),
+            TFT_WHITE);
+
+        // 3. Stage names in light grey, limited to 13 chars
+        setRow(
+            rows[2],
+            "- ",
+            TFT_LIGHTGREY,
+            schedule.getStage1().getDisplayName(displaySettings.isUseRomajiForStage()),
+            TFT_LIGHTGREY,
+            TFT_BLACK,
+            13);
+        setRow(
+            rows[3],
+            "- ",
+            TFT_LIGHTGREY,
+            schedule.getStage2().getDisplayName(displaySettings.isUseRomajiForStage()),
+            TFT_LIGHTGREY,
+            TFT_BLACK,
+            13);
+    }
+
+    void TFTDisplayService::setRow(
+        TextRow &row,
+        const char *prefix,
+        uint16_t prefixColor,
+        const char *text,
+        uint16_t textColor,
+        uint16_t backgroundColor,
+        int maxTextLength)
+    {
+        snprintf(row.prefix, sizeof(row.prefix), "%s", prefix);
+        snprintf(row.text, sizeof(row.text), "%.*s", maxTextLength, text);
+        row.prefixColor = prefixColor;
+        row.textColor = textColor;
+        row.backgroundColor = backgroundColor;
+    }
+
+    unsigned long TFTDisplayService::paintRow(
+        TFT_eSPI &target,
+        int x,
+        int y,
+        int leftInset,
+        int topInset,
+        int row,
+        const TextRow &content)
+    {
+        // 区切り線（右側の区画の左端と下側の区画の上端）は塗りつぶさない
+        int rowX = x + leftInset;
+        int rowY = y + ROW_OFFSETS[row];
+        int rowWidth = QUADRANT_WIDTH - leftInset;
+        int rowHeight = ROW_HEIGHTS[row];
+        if (row == 0)
         {
-            tft.invertDisplay(true);
+            rowY += topInset;
+            rowHeight -= topInset;
         }
+
+        target.fillRect(rowX, rowY, rowWidth, rowHeight, content.backgroundColor);
+        unsigned long pixels = (unsigned long)rowWidth * rowHeight;
+
+        if (content.prefix[0] == '\0' && content.text[0] == '\0')
+        {
+            return pixels;
+        }
+
+        // タイトル行は帯の中央寄りに文字を置く
+        target.setTextSize(1);
+        target.setCursor(x + 4, y + ROW_OFFSETS[row] + (row == 0 ? 4 : 0));
+        target.setTextColor(content.prefixColor);
+        target.print(content.prefix);
+        target.setTextColor(content.textColor);
+        target.print(content.text);
+
+        return pixels + (unsigned long)(target.textWidth(content.prefix) + target.textWidth(content.text)) * 8;
     }
 
     void TFTDisplayService::showDeviceInfo()
@@ -670,6 +922,7 @@ namespace Infrastructure
         }
 
         clearScreen();
+        showingSchedules = false;
 
         // 上部に背景色のヘッダーを表示
         tft.fillRect(0, 0, SCREEN_WIDTH, 30, SPLATOON_BLUE);
@@ -15,8 +15,14 @@ namespace Infrastructure
     {
     public:
         TFTDisplayService(uint8_t backlightPin, uint8_t pwmChannel)
-            : backlightPin(backlightPin), pwmChannel(pwmChannel), isInverted(false)
+            : backlightPin(backlightPin), pwmChannel(pwmChannel), isInverted(false), showingSchedules(false),
+              updateIndicatorVisible(false), pixelsPushed(0), lastUpdatePixelsPushed(0),
+              dmaAvailable(false), quadrantSprite(&tft), quadrantBackSprite(&tft), spritesAllocated(false),
+              directDrawCount(0)
         {
+            shownDateTime[0] = '\0';
+            shownUpdateTime[0] = '\0';
+
             Serial.print("TFTDisplayService constructed. Initial invert state: ");
             Serial.println(isInverted ? "true" : "false");
         }
@@ -32,6 +38,16 @@ namespace Infrastructure
             tft.init();
             tft.setRotation(1); // Landscape mode
 
+            // 区画の転送にDMAを使う（使えない場合は通常の転送になる）
+            dmaAvailable = tft.initDMA();
+
+            // 区画用のスプライトはここで1回だけ確保し、以降の更新で使い回す
+            // ヒープが断片化する前に確保するため、確保できないのは起動時にメモリが足りない場合だけ
+            if (!spritesAllocated)
+            {
+                spritesAllocated = createQuadrantSprites();
+            }
+
             // 初期化時に前回の反転状態を適用
             Serial.print("TFTDisplayService::initialize - Setting initial invert state to: ");
             Serial.println(isInverted ? "true" : "false");
@@ -45,6 +61,12 @@ namespace Infrastructure
             isFirstStatusCall = true;
         }
 
+        // スケジュール画面が表示されているかどうか
+        bool isShowingSchedules() override
+        {
+            return showingSchedules;
+        }
+
         // Set backlight brightness level (0-255)
         void setBacklight(uint8_t brightness) override
         {
@@ -55,6 +77,28 @@ namespace Infrastructure
         void clearScreen() override
         {
             tft.fillScreen(TFT_BLACK);
+            pixelsPushed += (unsigned long)SCREEN_WIDTH * SCREEN_HEIGHT;
+
+            // 保持している表示内容は無効になる
+            showingSchedules = false;
+        }
+
+        // バックグラウンド更新のインジケータを表示中かどうか
+        bool isUpdateIndicatorVisible() const
+        {
+            return updateIndicatorVisible;
+        }
+
+        // 直近のupdateScreenでSPIに送ったピクセル数（塗りつぶし面積と文字セルの合計）
+        unsigned long getLastUpdatePixelsPushed() const override
+        {
+            return lastUpdatePixelsPushed;
+        }
+
+        // スプライトを確保できず、変化した行を直接描画したupdateScreenの回数
+        unsigned long getDirectDrawCount() const override
+        {
+            return directDrawCount;
         }
 
         // 画面の色を反転する
@@ -94,14 +138,7 @@ namespace Infrastructure
 
         // Update the entire screen with all schedule data
         void updateScreen(
-            const Domain::BattleSchedule &regularSchedule,
-            const Domain::BattleSchedule &regularNextSchedule,
-            const Domain::BattleSchedule &xMatchSchedule,
-            const Domain::BattleSchedule &xMatchNextSchedule,
-            const Domain::BattleSchedule &bankaraChallengeSchedule,
-            const Domain::BattleSchedule &bankaraChallengeNextSchedule,
-            const Domain::BattleSchedule &bankaraOpenSchedule,
-            const Domain::BattleSchedule &bankaraOpenNextSchedule,
+            const Domain::ScheduleSnapshot &snapshot,
             const char *currentDateTime,
             const char *lastUpdateTime,
             const Domain::DisplaySettings &displaySettings) override;
@@ -129,73 +166,27 @@ namespace Infrastructure
         // Update time display at bottom of screen
         void updateTimeDisplay() override
         {
-            // 現在時刻を取得して表示を更新
-            char currentDateTime[64];
-            char lastUpdateTime[64];
-
-            // 現在時刻のフォーマット（年月日と時分までを表示、秒は省略）
-            time_t now;
-            struct tm timeinfo;
-            time(&now);
-            localtime_r(&now, &timeinfo);
-            strftime(currentDateTime, sizeof(currentDateTime), "%Y-%m-%d %H:%M", &timeinfo);
-
-            // 最終更新時刻は現在時刻を5分単位に丸める（例：23:17→23:15）
-            struct tm updateTime = timeinfo;
-            // 分を5の倍数に丸める（0, 5, 10, 15...）
-            updateTime.tm_min = (updateTime.tm_min / 5) * 5;
-            updateTime.tm_sec = 0;
-
-            // 時刻のみの形式でフォーマット（HH:MM）
-            time_t roundedTime = mktime(&updateTime);
-            strftime(lastUpdateTime, sizeof(lastUpdateTime), "%H:%M", &updateTime);
+            // 現在時刻と最終更新時刻を組み立て、変化した文字だけを描き直す
+            char currentDateTime[DATE_TIME_TEXT_SIZE];
+            char lastUpdateTime[UPDATE_TIME_TEXT_SIZE];
+            formatBottomInfo(currentDateTime, lastUpdateTime);
 
             // 下部情報バーを更新
             updateBottomInfo(currentDateTime, lastUpdateTime);
         }
 
-        // Update display with the specified schedules
+        // Update display with the schedules in the snapshot
         void updateDisplay(
-            const Domain::BattleSchedule &regularSchedule,
-            const Domain::BattleSchedule &xSchedule,
-            const Domain::BattleSchedule &anarchyChallengeSchedule,
-            const Domain::BattleSchedule &anarchyOpenSchedule,
-            const Domain::BattleSchedule &regularNextSchedule,
-            const Domain::BattleSchedule &xNextSchedule,
-            const Domain::BattleSchedule &anarchyChallengeNextSchedule,
-            const Domain::BattleSchedule &anarchyOpenNextSchedule,
+            const Domain::ScheduleSnapshot &snapshot,
             const Domain::DisplaySettings &displaySettings) override
         {
-            char currentDateTime[64];
-            char lastUpdateTime[64];
-
-            // 現在時刻のフォーマット（年月日と時分までを表示、秒は省略）
-            time_t now;
-            struct tm timeinfo;
-            time(&now);
-            localtime_r(&now, &timeinfo);
-            strftime(currentDateTime, sizeof(currentDateTime), "%Y-%m-%d %H:%M", &timeinfo);
-
-            // 最終更新時刻は現在時刻を5分単位に丸める（例：23:17→23:15）
-            struct tm updateTime = timeinfo;
-            // 分を5の倍数に丸める（0, 5, 10, 15...）
-            updateTime.tm_min = (updateTime.tm_min / 5) * 5;
-            updateTime.tm_sec = 0;
-
-            // 時刻のみの形式でフォーマット（HH:MM）
-            time_t roundedTime = mktime(&updateTime);
-            strftime(lastUpdateTime, sizeof(lastUpdateTime), "%H:%M", &updateTime);
+            char currentDateTime[DATE_TIME_TEXT_SIZE];
+            char lastUpdateTime[UPDATE_TIME_TEXT_SIZE];
+            formatBottomInfo(currentDateTime, lastUpdateTime);
 
             // 画面全体を更新（次の予定情報も含めて表示）
             updateScreen(
-                regularSchedule,
-                regularNextSchedule,
-                xSchedule,
-                xNextSchedule,
-                anarchyChallengeSchedule,
-                anarchyChallengeNextSchedule,
-                anarchyOpenSchedule,
-                anarchyOpenNextSchedule,
+                snapshot,
                 currentDateTime,
                 lastUpdateTime,
                 displaySettings);
@@ -206,6 +197,12 @@ namespace Infrastructure
         uint8_t backlightPin;
         uint8_t pwmChannel;
         bool isInverted; // 画面反転状態の管理用
+        bool showingSchedules; // スケジュール画面が表示中かどうか
+        bool updateIndicatorVisible; // バックグラウンド更新のインジケータを表示中かどうか
+
+        // 送信したピクセル数（updateScreenごとに集計）
+        unsigned long pixelsPushed;
+        unsigned long lastUpdatePixelsPushed;
 
         // showConnectionStatusメソッドの状態管理用
         static bool isFirstStatusCall;
@@ -228,13 +225,148 @@ namespace Infrastructure
         // バージョン情報
         static constexpr const char *VERSION = "v1.2.1";
 
-        // Helper method to draw a battle quadrant
+        // 区画ごとの行数（タイトル + 現在のスケジュール4行 + 次のスケジュール4行）
+        static constexpr int QUADRANT_ROWS = 9;
+
+        // 区画内の各行の位置と高さ
+        static constexpr int ROW_OFFSETS[QUADRANT_ROWS] = {0, 20, 30, 40, 50, 65, 75, 85, 95};
+        static constexpr int ROW_HEIGHTS[QUADRANT_ROWS] = {16, 10, 10, 10, 10, 10, 10, 10, 10};
+
+        // 1行分の表示内容
+        struct TextRow
+        {
+            char prefix[8]; // ルール記号や"- "（prefixColorで描画）
+            char text[24];
+            uint16_t prefixColor;
+            uint16_t textColor;
+            uint16_t backgroundColor;
+
+            TextRow() { clear(); }
+
+            void clear()
+            {
+                prefix[0] = '\0';
+                text[0] = '\0';
+                prefixColor = TFT_WHITE;
+                textColor = TFT_WHITE;
+                backgroundColor = TFT_BLACK;
+            }
+
+            bool sameAs(const TextRow &other) const
+            {
+                return prefixColor == other.prefixColor &&
+                       textColor == other.textColor &&
+                       backgroundColor == other.backgroundColor &&
+                       strcmp(prefix, other.prefix) == 0 &&
+                       strcmp(text, other.text) == 0;
+            }
+        };
+
+        // 1つの区画に表示している内容（前回描画した内容と比較して変化した区画だけを描き直す）
+        struct QuadrantModel
+        {
+            TextRow rows[QUADRANT_ROWS];
+
+            bool sameAs(const QuadrantModel &other) const
+            {
+                for (int row = 0; row < QUADRANT_ROWS; row++)
+                {
+                    if (!rows[row].sameAs(other.rows[row]))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+        };
+
+        // 各区画に最後に描画した内容と、これから描画する内容（レギュラー、X、チャレンジ、オープンの順）
+        QuadrantModel shownQuadrants[4];
+        QuadrantModel pendingQuadrants[4];
+
+        // 下部情報バーの文字列（"YYYY-MM-DD HH:MM"と"HH:MM"）のバッファサイズ
+        static constexpr size_t DATE_TIME_TEXT_SIZE = 17;
+        static constexpr size_t UPDATE_TIME_TEXT_SIZE = 6;
+
+        // 下部情報バーの文字セル（GLCDフォント、文字サイズ1）
+        static constexpr int GLYPH_WIDTH = 6;
+        static constexpr int GLYPH_HEIGHT = 8;
+        static constexpr int BOTTOM_TEXT_Y = SCREEN_HEIGHT - 12;
+        static constexpr int DATE_TIME_X = 4;
+
+        // 下部情報バーに最後に描画した内容
+        char shownDateTime[32];
+        char shownUpdateTime[16];
+
+        // 現在時刻（年月日と時分、秒は省略）と、5分単位に丸めた最終更新時刻を組み立てる
+        static void formatBottomInfo(char *currentDateTime, char *lastUpdateTime);
+
+        // shownと異なる文字のセルだけを描き直し、shownを更新する（同じ長さの文字列に限る）
+        void drawChangedGlyphs(int x, int y, const char *text, char *shown);
+
+        // 区画を描画するオフスクリーンバッファ（初期化時に確保して保持し、交互に使ってDMA転送と描画を重ねる）
+        bool dmaAvailable;
+        TFT_eSprite quadrantSprite;
+        TFT_eSprite quadrantBackSprite;
+        bool spritesAllocated;
+        unsigned long directDrawCount;
+
+        // Draw the changed rows of a battle quadrant directly to the display
+        // Used when the quadrant sprites cannot be allocated
         void drawBattleQuadrant(
             int x,
             int y,
+            const QuadrantModel &model,
+            QuadrantModel &shown,
+            bool fullRepaint);
+
+        // 区画用のスプライトを2枚とも確保する（片方しか確保できない場合は解放してfalse）
+        bool createQuadrantSprites();
+
+        // 変化した区画をスプライトに描画し、DMAで転送する
+        void pushQuadrantSprites(const bool dirty[4]);
+
+        // 区切り線を含む区画全体をスプライトに描画する
+        static void renderQuadrantSprite(
+            TFT_eSprite &sprite,
+            bool rightSide,
+            bool bottomSide,
+            const QuadrantModel &model);
+
+        // 区画に表示する内容を組み立てる（staleは前回までのスロットを確認できないまま表示している場合）
+        static void buildQuadrantModel(
             const Domain::BattleSchedule &current,
             const Domain::BattleSchedule &next,
-            const Domain::DisplaySettings &displaySettings);
+            bool stale,
+            const Domain::DisplaySettings &displaySettings,
+            QuadrantModel &model);
+
+        // 1つのスケジュールを4行（時間帯、ルール、ステージ2つ）に展開する
+        static void buildScheduleRows(
+            const Domain::BattleSchedule &schedule,
+            const Domain::DisplaySettings &displaySettings,
+            TextRow *rows);
+
+        // 行の内容を設定する（textはmaxTextLength文字までに切り詰める）
+        static void setRow(
+            TextRow &row,
+            const char *prefix,
+            uint16_t prefixColor,
+            const char *text,
+            uint16_t textColor,
+            uint16_t backgroundColor = TFT_BLACK,
+            int maxTextLength = sizeof(TextRow::text) - 1);
+
+        // 1行の背景を塗り直して文字を描画し、塗ったピクセル数を返す
+        // leftInset/topInsetは区切り線を避けるために空けるピクセル数
+        static unsigned long paintRow(
+            TFT_eSPI &target,
+            int x,
+            int y,
+            int leftInset,
+            int topInset,
+            int row,
+            const TextRow &content);
     };
 
 } // namespace Infrastructure
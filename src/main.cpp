@@ -4,6 +4,7 @@
 #include <HTTPClient.h>
 #include <ArduinoJson.h>
 #include <time.h>
+#include <esp_sntp.h>
 #include <Preferences.h>
 
 // Domain layer
@@ -22,8 +23,10 @@
 #include "application/ScheduleApplicationService.h"
 #include "application/WiFiService.h"
 #include "application/SettingsService.h"
+#include "application/SnapshotStore.h"
 #include "application/AppInitializationService.h"
 #include "application/WiFiConnectionManager.h"
+#include "application/EventScheduler.h"
 
 // Infrastructure layer
 #include "infrastructure/TFTDisplayService.h"
@@ -31,11 +34,15 @@
 #include "infrastructure/APIScheduleRepository.h"
 #include "infrastructure/ESP32WiFiService.h"
 #include "infrastructure/PreferencesSettingsService.h"
+#include "infrastructure/PreferencesSnapshotStore.h"
 #include "infrastructure/AppStateManager.h"
 #include "infrastructure/ESP32AppInitializationService.h"
 #include "infrastructure/ESP32WiFiConnectionManager.h"
 #include "infrastructure/MemoryManager.h"
 #include "infrastructure/DeviceInfo.h"
+#include "infrastructure/ESP32EventQueue.h"
+#include "infrastructure/PowerManager.h"
+#include "infrastructure/BootProfiler.h"
 
 // Preferences for storing WiFi credentials and user settings
 Preferences preferences;
@@ -43,6 +50,10 @@ Preferences preferences;
 // Display settings
 #define TFT_BL 21 // バックライトピンをUser_Setup.hと同じに設定
 
+// メインループのタイマーと、他のタスクからのイベントを受け取るキュー
+Application::EventScheduler eventScheduler;
+Infrastructure::ESP32EventQueue eventQueue;
+
 // Applicationの状態を管理するマネージャ
 Infrastructure::AppStateManager appStateManager;
 
@@ -52,6 +63,7 @@ Infrastructure::APIScheduleRepository scheduleRepository(networkService);
 Infrastructure::TFTDisplayService displayService(TFT_BL, 0); // PWM Channel 0 for backlight control
 Infrastructure::ESP32WiFiService wifiService;
 Infrastructure::PreferencesSettingsService settingsService(preferences);
+Infrastructure::PreferencesSnapshotStore snapshotStore;
 
 // Application services
 Application::ScheduleService scheduleService(scheduleRepository);
@@ -65,12 +77,18 @@ Infrastructure::ESP32AppInitializationService appInitializationService(
     applicationService,
     wifiConnectionManager,
     settingsService,
-    appStateManager);
+    snapshotStore,
+    appStateManager,
+    eventScheduler,
+    eventQueue);
 
-// メモリ監視用の変数
-unsigned long lastMemoryCheck = 0;
+// メモリ監視の間隔
 const unsigned long MEMORY_CHECK_INTERVAL = 60000; // 1分ごとにメモリチェック
 
+// シリアルコンソールの入力バッファ
+char serialCommand[32];
+size_t serialCommandLength = 0;
+
 // 表示設定切り替え関数
 void switchToEnglishDisplay()
 {
@@ -88,20 +106,145 @@ void switchToRomajiDisplay()
     applicationService.updateDisplay(); // 表示を更新
 }
 
+// シリアルコンソールのコマンドを処理する
+//   mem       : メモリ統計をJSONで出力（行頭は"MEMORY "）
+//   mem reset : メモリ統計をリセット
+//   power       : 省電力の状態と起動率をJSONで出力（行頭は"POWER "）
+//   power reset : 起動率の統計をリセット
+//   boot      : 起動の各段階の時刻をJSONで出力（行頭は"BOOT "）
+void processSerialCommands()
+{
+    while (Serial.available() > 0)
+    {
+        char c = (char)Serial.read();
+        if (c != '\n' && c != '\r')
+        {
+            // 長すぎる行は切り詰める
+            if (serialCommandLength < sizeof(serialCommand) - 1)
+            {
+                serialCommand[serialCommandLength++] = c;
+            }
+            continue;
+        }
+
+        serialCommand[serialCommandLength] = '\0';
+        serialCommandLength = 0;
+
+        if (strcmp(serialCommand, "mem") == 0)
+        {
+            Serial.print("MEMORY ");
+            Serial.println(Infrastructure::MemoryManager::buildReportJson());
+        }
+        else if (strcmp(serialCommand, "mem reset") == 0)
+        {
+            Infrastructure::MemoryManager::resetMemoryStats();
+        }
+        else if (strcmp(serialCommand, "power") == 0)
+        {
+            Serial.print("POWER ");
+            Serial.println(Infrastructure::PowerManager::buildReportJson());
+        }
+        else if (strcmp(serialCommand, "power reset") == 0)
+        {
+            Infrastructure::PowerManager::resetStats();
+        }
+        else if (strcmp(serialCommand, "boot") == 0)
+        {
+            Serial.print("BOOT ");
+            Serial.println(Infrastructure::BootProfiler::buildReportJson());
+        }
+        else if (serialCommand[0] != '\0')
+        {
+            Serial.print("Unknown command: ");
+            Serial.println(serialCommand);
+        }
+    }
+}
+
+// WiFiの接続・切断をメインループに通知する（WiFiイベントタスクから呼ばれる）
+void onWiFiEvent(WiFiEvent_t event)
+{
+    switch (event)
+    {
+    case ARDUINO_EVENT_WIFI_STA_GOT_IP:
+    case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
+    case ARDUINO_EVENT_WIFI_AP_STACONNECTED:
+    case ARDUINO_EVENT_WIFI_AP_STADISCONNECTED:
+        eventQueue.post(Application::AppEvent::WIFI_CHANGED);
+        break;
+
+    default:
+        break;
+    }
+}
+
+// シリアル入力をメインループに通知する（UARTのイベントタスクから呼ばれる）
+void onSerialReceive()
+{
+    eventQueue.post(Application::AppEvent::SERIAL_INPUT);
+}
+
+// NTPでの時刻同期をメインループに通知する（TCP/IPタスクから呼ばれる）
+void onTimeSynced(struct timeval *tv)
+{
+    eventQueue.post(Application::AppEvent::TIME_SYNCED);
+}
+
+// 定期的なメモリ監視
+void processMemoryCheck()
+{
+    Infrastructure::MemoryManager::logMemoryUsage("Periodic check");
+
+    // 最大空きブロックの推移を記録して分析
+    Infrastructure::MemoryManager::analyzeMemoryTrend();
+}
+
+// メインループに届いたイベントを処理する
+void dispatchEvent(Application::AppEvent event, unsigned long currentMillis)
+{
+    switch (event)
+    {
+    case Application::AppEvent::MEMORY_CHECK:
+        processMemoryCheck();
+        break;
+
+    case Application::AppEvent::SERIAL_INPUT:
+        // シリアルコンソールからの問い合わせ
+        processSerialCommands();
+        break;
+
+    default:
+        // アプリケーションのイベント処理
+        appInitializationService.handleEvent(event, currentMillis);
+        break;
+    }
+}
+
 void setup()
 {
     // シリアル初期化
     Serial.begin(115200);
+    Infrastructure::BootProfiler::mark("setup");
 
     // デバイス情報を表示
     Infrastructure::DeviceInfo::printDeviceInfo();
 
-    // メモリ統計をリセット
-    Infrastructure::MemoryManager::resetMemoryStats();
+    // メモリ計測を開始
+    Infrastructure::MemoryManager::begin();
+
+    // 省電力の制御と起動率の計測を開始
+    Infrastructure::PowerManager::begin();
 
     // 初期メモリ使用量をログ
     Infrastructure::MemoryManager::logMemoryUsage("Setup start");
 
+    // 他のタスクからのイベントを受け取れるようにする
+    eventQueue.begin();
+    WiFi.onEvent(onWiFiEvent);
+    Serial.onReceive(onSerialReceive);
+    sntp_set_time_sync_notification_cb(onTimeSynced);
+    eventScheduler.scheduleEvery(Application::AppEvent::MEMORY_CHECK, millis(), MEMORY_CHECK_INTERVAL);
+
     // アプリケーションのセットアップ処理
     appInitializationService.performSetup();
 
@@ -111,31 +254,18 @@ void setup()
 
 void loop()
 {
-    // 現在時刻を取得
+    // 発生したイベントと期限の来たタイマーをすべて処理
+    Application::AppEvent event;
     unsigned long currentMillis = millis();
-
-    // 定期的なメモリ監視
-    if (currentMillis - lastMemoryCheck >= MEMORY_CHECK_INTERVAL)
+    while (eventScheduler.takeNext(currentMillis, event))
     {
-        Infrastructure::MemoryManager::logMemoryUsage("Periodic check");
-        lastMemoryCheck = currentMillis;
-
-        // メモリ不足の場合は強制ガベージコレクションを試行
-        if (Infrastructure::MemoryManager::isLowMemory())
-        {
-            Infrastructure::MemoryManager::forceGarbageCollection();
-        }
-
-        // メモリ傾向分析を実行
-        Infrastructure::MemoryManager::analyzeMemoryTrend();
+        dispatchEvent(event, currentMillis);
+        currentMillis = millis();
     }
 
-    // 定期的なメモリクリーンアップ
-    Infrastructure::MemoryManager::performPeriodicCleanup();
-
-    // アプリケーションのメインループ処理
-    appInitializationService.performLoop(currentMillis);
-
-    // 適度な遅延
-    delay(10);
-}
\ No newline at end of file
+    // 次のタイマーの期限まで、または他のタスクからイベントが届くまで待機
+    // 待っていた時間を起動率の計測に加える
+    unsigned long waitStart = micros();
+    eventQueue.waitAndCollect(eventScheduler, eventScheduler.getMillisUntilNextEvent(currentMillis));
+    Infrastructure::PowerManager::recordIdle(micros() - waitStart);
+}
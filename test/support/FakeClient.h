@@ -0,0 +1,132 @@
+// FakeClient.h
+// 送信内容を記録し、テストが渡した分だけ受信データを返すClient（ネイティブ環境のテスト用）
+
+#ifndef FAKE_CLIENT_H
+#define FAKE_CLIENT_H
+
+#include <Arduino.h>
+#include <Client.h>
+#include <string>
+
+namespace TestSupport
+{
+    // 受信データはfeed()で少しずつ届けられ、届いていない分は読めない（available()が0）
+    // respondWith()で次のリクエストに返すレスポンスを予約すると、送信と同時に届く
+    class FakeClient : public Client
+    {
+    public:
+        FakeClient() : open(false), refuseConnect(false), closeWhenDrained(false), connectCount(0), position(0) {}
+
+        // 受信データを届ける
+        void feed(const std::string &data) { inbound += data; }
+
+        // 次のリクエストを送った時点で届くレスポンス
+        void respondWith(const std::string &response) { pendingResponse = response; }
+
+        // 届いたデータを読み終えたら相手が接続を閉じる
+        void setCloseWhenDrained(bool value) { closeWhenDrained = value; }
+
+        // 相手が接続を閉じる（届いているデータは読める）
+        void closeRemote() { closeWhenDrained = true; }
+
+        // 接続を拒否する
+        void setRefuseConnect(bool value) { refuseConnect = value; }
+
+        const std::string &getSent() const { return sent; }
+        void clearSent() { sent.clear(); }
+        unsigned long getConnectCount() const { return connectCount; }
+        const std::string &getConnectedHost() const { return host; }
+
+        int connect(const char *hostName, uint16_t port) override
+        {
+            (void)port;
+            connectCount++;
+            if (refuseConnect)
+            {
+                return 0;
+            }
+            host = hostName;
+            open = true;
+            closeWhenDrained = false;
+            inbound.clear();
+            position = 0;
+            return 1;
+        }
+
+        size_t write(uint8_t c) override { return write(&c, 1); }
+
+        size_t write(const uint8_t *buffer, size_t size) override
+        {
+            if (!open)
+            {
+                return 0;
+            }
+            sent.append((const char *)buffer, size);
+
+            // リクエストの終わり（空行）でレスポンスを届ける
+            if (!pendingResponse.empty() && sent.size() >= 4 && sent.compare(sent.size() - 4, 4, "\r\n\r\n") == 0)
+            {
+                feed(pendingResponse);
+                pendingResponse.clear();
+            }
+            return size;
+        }
+
+        int available() override { return open ? (int)(inbound.size() - position) : 0; }
+
+        int read() override
+        {
+            if (available() <= 0)
+            {
+                return -1;
+            }
+            return (unsigned char)inbound[position++];
+        }
+
+        int read(uint8_t *buffer, size_t size) override
+        {
+            size_t count = (size_t)available();
+            if (count > size)
+            {
+                count = size;
+            }
+            inbound.copy((char *)buffer, count, position);
+            position += count;
+            return (int)count;
+        }
+
+        int peek() override { return available() > 0 ? (unsigned char)inbound[position] : -1; }
+        void flush() override {}
+
+        void stop() override
+        {
+            open = false;
+            inbound.clear();
+            position = 0;
+        }
+
+        uint8_t connected() override
+        {
+            if (open && closeWhenDrained && position >= inbound.size())
+            {
+                open = false;
+            }
+            return open ? 1 : 0;
+        }
+
+        operator bool() override { return connected() != 0; }
+
+    private:
+        bool open;
+        bool refuseConnect;
+        bool closeWhenDrained;
+        unsigned long connectCount;
+        std::string host;
+        std::string sent;
+        std::string inbound;
+        size_t position;
+        std::string pendingResponse;
+    };
+}
+
+#endif // FAKE_CLIENT_H
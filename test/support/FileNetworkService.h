@@ -0,0 +1,448 @@
+// FileNetworkService.h
+// 記録したAPIレスポンスのファイルを返すNetworkService（ネイティブ環境のテストとベンチマーク用）
+
+#ifndef FILE_NETWORK_SERVICE_H
+#define FILE_NETWORK_SERVICE_H
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <map>
+#include <string>
+#include <vector>
+#include "application/NetworkService.h"
+#include "infrastructure/KeepAliveHttpClient.h"
+
+#ifndef FIXTURE_DIR
+#define FIXTURE_DIR "test/fixtures"
+#endif
+
+namespace TestSupport
+{
+    // メモリ上のレスポンスボディを読み出すストリーム
+    // chunkSizeを指定すると1回のreadBytesで返す量を制限し、パケットに分かれて届く様子を再現する
+    // 解析中のヒープの最大使用量を残すため、一定量を読むごとに空きヒープを記録する
+    class MemoryStream : public Stream
+    {
+    public:
+        MemoryStream(const std::string &body, size_t chunkSize)
+            : body(body), position(0), chunkSize(chunkSize) {}
+
+        int available() override { return (int)(body.length() - position); }
+        int read() override
+        {
+            if (position >= body.length())
+            {
+                return -1;
+            }
+            sampleHeap(position, position + 1);
+            return (unsigned char)body[position++];
+        }
+        int peek() override { return position < body.length() ? (unsigned char)body[position] : -1; }
+        size_t write(uint8_t) override { return 0; }
+
+        size_t readBytes(char *buffer, size_t length) override
+        {
+            size_t count = body.length() - position;
+            if (count > length)
+            {
+                count = length;
+            }
+            if (chunkSize > 0 && count > chunkSize)
+            {
+                count = chunkSize;
+            }
+            body.copy(buffer, count, position);
+            sampleHeap(position, position + count);
+            position += count;
+            return count;
+        }
+
+        size_t getPosition() const { return position; }
+
+    private:
+        static constexpr size_t HEAP_SAMPLE_INTERVAL = 256;
+
+        static void sampleHeap(size_t from, size_t to)
+        {
+            if (from / HEAP_SAMPLE_INTERVAL != to / HEAP_SAMPLE_INTERVAL)
+            {
+                ESP.getFreeHeap();
+            }
+        }
+
+        const std::string &body;
+        size_t position;
+        size_t chunkSize;
+    };
+
+    // URLの"/api/"以降をルートからのパスとみなし、"<root>/<path>.json"を返すNetworkService
+    // (例: https://spla3.yuu26.com/api/regular/now -> <root>/regular/now.json)
+    // ファイルがない、または失敗を指定したパスは通信エラーになる
+    // ETagはファイルの内容から求めるため、同じ内容を再取得すると304になる
+    // 非同期のリクエストは指定した遅延（millis()の時計）が過ぎたpoll()で完了する
+    // 転送量は、KeepAliveHttpClientが送るリクエストと、同じ内容をサーバーが返した場合の
+    // ステータス行・ヘッダ・ボディの長さで数える（HTTPの層は通さずにボディを渡す）
+    class FileNetworkService : public Application::NetworkService
+    {
+    public:
+        explicit FileNetworkService(const char *scenario = "spla3")
+            : latencyMillis(0), maxInFlight(2), chunkSize(0), connected(true), requestCount(0), handshakeCount(0),
+              requestBytes(0), headerBytes(0), bodyBytes(0), openConnections(0)
+        {
+            setScenario(scenario);
+        }
+
+        // FIXTURE_DIRの下のシナリオのディレクトリに切り替える
+        void setScenario(const char *scenario) { root = std::string(FIXTURE_DIR) + "/" + scenario; }
+
+        // 指定したパス（"schedule"、"regular/next"など）への要求を失敗させる
+        void setFailing(const char *path, bool failing)
+        {
+            for (size_t i = 0; i < failingPaths.size(); i++)
+            {
+                if (failingPaths[i] == path)
+                {
+                    failingPaths.erase(failingPaths.begin() + (long)i);
+                    break;
+                }
+            }
+            if (failing)
+            {
+                failingPaths.push_back(path);
+            }
+        }
+
+        // 1リクエストあたりの応答時間、同時に処理できるリクエスト数、1回に読める量
+        void setLatency(unsigned long millis) { latencyMillis = millis; }
+
+        // 指定したパスへの非同期のリクエストだけ応答時間を延ばす（応答の届く順を入れ替える）
+        void setExtraLatency(const char *path, unsigned long millis) { extraLatencies[path] = millis; }
+        void setMaxInFlight(size_t count) { maxInFlight = count; }
+        void setChunkSize(size_t bytes) { chunkSize = bytes; }
+        void setConnected(bool value) { connected = value; }
+
+        // 要求したパスの履歴（"schedule"、"regular/now"など）
+        const std::vector<std::string> &getRequestLog() const { return requestLog; }
+        void clearRequestLog() { requestLog.clear(); }
+
+        bool connect(const char *ssid, const char *password) override
+        {
+            (void)ssid;
+            (void)password;
+            return connected;
+        }
+
+        bool isConnected() override { return connected; }
+
+        String getIPAddress() override { return String("127.0.0.1"); }
+
+        String httpGet(const char *url) override
+        {
+            std::string body;
+            if (!request(url, nullptr, body))
+            {
+                return String();
+            }
+            countResponse(200, body, computeEtag(body));
+            return String(body);
+        }
+
+        bool httpGetStream(const char *url, const StreamHandler &handler) override
+        {
+            std::string body;
+            if (!request(url, nullptr, body))
+            {
+                return false;
+            }
+            countResponse(200, body, computeEtag(body));
+
+            MemoryStream stream(body, chunkSize);
+            return handler(stream);
+        }
+
+        FetchResult httpGetStreamIfModified(
+            const char *url,
+            CacheValidators &validators,
+            const StreamHandler &handler) override
+        {
+            std::string body;
+            if (!request(url, &validators, body))
+            {
+                return FetchResult::FAILED;
+            }
+            return respond(body, validators, handler);
+        }
+
+        bool startHttpGetIfModified(
+            const char *url,
+            CacheValidators &validators,
+            const StreamHandler &handler,
+            const CompletionHandler &onComplete) override
+        {
+            if (!connected || pending.size() >= maxInFlight)
+            {
+                return false;
+            }
+
+            PendingRequest entry;
+            entry.url = url;
+            entry.validators = &validators;
+            entry.handler = handler;
+            entry.onComplete = onComplete;
+            entry.startMillis = millis();
+            entry.latencyMillis = latencyMillis + extraLatencyOf(url);
+            pending.push_back(entry);
+            return true;
+        }
+
+        bool poll() override
+        {
+            // 応答時間の過ぎたリクエストを開始した順に完了させる
+            for (size_t i = 0; i < pending.size();)
+            {
+                if (millis() - pending[i].startMillis < pending[i].latencyMillis)
+                {
+                    i++;
+                    continue;
+                }
+
+                PendingRequest entry = pending[i];
+                pending.erase(pending.begin() + (long)i);
+
+                std::string body;
+                bool received = requestWithoutDelay(entry.url.c_str(), entry.validators, body);
+                entry.onComplete(received ? respond(body, *entry.validators, entry.handler) : FetchResult::FAILED);
+            }
+            return !pending.empty();
+        }
+
+        ConnectionStats getConnectionStats() override
+        {
+            ConnectionStats stats;
+            stats.requestCount = requestCount;
+            stats.handshakeCount = handshakeCount;
+            stats.requestBytes = requestBytes;
+            stats.headerBytes = headerBytes;
+            stats.bodyBytes = bodyBytes;
+            return stats;
+        }
+
+        void resetConnectionStats() override
+        {
+            requestCount = 0;
+            handshakeCount = 0;
+            requestBytes = 0;
+            headerBytes = 0;
+            bodyBytes = 0;
+        }
+
+        // 保持している接続を閉じる（次の要求ではハンドシェイクからやり直す）
+        void closeConnections() override
+        {
+            pending.clear();
+            openConnections = 0;
+        }
+
+        void configureTimeService() override {}
+
+        bool getCurrentDateTime(char *buffer, size_t bufferSize) override
+        {
+            return formatLocalTime(buffer, bufferSize, "%Y/%m/%d %H:%M");
+        }
+
+        bool getLastUpdateTime(char *buffer, size_t bufferSize) override
+        {
+            return formatLocalTime(buffer, bufferSize, "%m/%d %H:%M");
+        }
+
+        // ファイルの内容からETagを求める（FNV-1a）
+        static std::string computeEtag(const std::string &body)
+        {
+            uint32_t hash = 2166136261u;
+            for (char c : body)
+            {
+                hash = (hash ^ (uint8_t)c) * 16777619u;
+            }
+
+            char etag[16];
+            snprintf(etag, sizeof(etag), "\"%08x\"", (unsigned int)hash);
+            return etag;
+        }
+
+    private:
+        struct PendingRequest
+        {
+            std::string url;
+            CacheValidators *validators;
+            StreamHandler handler;
+            CompletionHandler onComplete;
+            unsigned long startMillis;
+            unsigned long latencyMillis;
+        };
+
+        std::string root;
+        std::vector<std::string> failingPaths;
+        std::vector<std::string> requestLog;
+        std::map<std::string, unsigned long> extraLatencies;
+        std::vector<PendingRequest> pending;
+        unsigned long latencyMillis;
+        size_t maxInFlight;
+        size_t chunkSize;
+        bool connected;
+        unsigned long requestCount;
+        unsigned long handshakeCount;
+        unsigned long requestBytes;
+        unsigned long headerBytes;
+        unsigned long bodyBytes;
+        size_t openConnections;
+
+        // 同期の要求は応答時間の分だけ時計を進める
+        bool request(const char *url, const CacheValidators *validators, std::string &body)
+        {
+            delay(latencyMillis);
+            return requestWithoutDelay(url, validators, body);
+        }
+
+        bool requestWithoutDelay(const char *url, const CacheValidators *validators, std::string &body)
+        {
+            if (!connected)
+            {
+                return false;
+            }
+            countRequest(url, validators);
+
+            std::string path = pathOf(url);
+            requestLog.push_back(path);
+            requestCount++;
+
+            // 同時に使う接続の数までは接続ごとに1回ずつハンドシェイクする
+            if (openConnections < maxInFlight)
+            {
+                openConnections++;
+                handshakeCount++;
+            }
+
+            for (const std::string &failing : failingPaths)
+            {
+                if (failing == path)
+                {
+                    return false;
+                }
+            }
+
+            return readFile(root + "/" + path + ".json", body);
+        }
+
+        FetchResult respond(const std::string &body, CacheValidators &validators, const StreamHandler &handler)
+        {
+            std::string etag = computeEtag(body);
+            if (etag == validators.etag)
+            {
+                countResponse(304, body, etag);
+                return FetchResult::NOT_MODIFIED;
+            }
+            countResponse(200, body, etag);
+
+            MemoryStream stream(body, chunkSize);
+            if (!handler(stream))
+            {
+                return FetchResult::FAILED;
+            }
+
+            snprintf(validators.etag, sizeof(validators.etag), "%s", etag.c_str());
+            validators.lastModified[0] = '\0';
+            return FetchResult::UPDATED;
+        }
+
+        static std::string pathOf(const char *url)
+        {
+            const char *api = strstr(url, "/api/");
+            return api != nullptr ? api + 5 : url;
+        }
+
+        unsigned long extraLatencyOf(const char *url) const
+        {
+            std::map<std::string, unsigned long>::const_iterator found = extraLatencies.find(pathOf(url));
+            return found != extraLatencies.end() ? found->second : 0;
+        }
+
+        // KeepAliveHttpClientが送るのと同じリクエストの長さを数える
+        void countRequest(const char *url, const CacheValidators *validators)
+        {
+            const char *host = strstr(url, "://");
+            host = host != nullptr ? host + 3 : url;
+            const char *path = strchr(host, '/');
+            std::string hostName = path != nullptr ? std::string(host, path) : std::string(host);
+
+            char buffer[Infrastructure::KeepAliveHttpClient::REQUEST_BUFFER_SIZE];
+            int length = Infrastructure::KeepAliveHttpClient::formatRequest(
+                buffer, sizeof(buffer), hostName.c_str(), path != nullptr ? path : "/", validators);
+            if (length > 0)
+            {
+                requestBytes += (unsigned long)length;
+            }
+        }
+
+        // サーバーが返すステータス行とヘッダ（304はボディなし）の長さを数える
+        void countResponse(int statusCode, const std::string &body, const std::string &etag)
+        {
+            char head[256];
+            int length;
+            if (statusCode == 304)
+            {
+                length = snprintf(head, sizeof(head),
+                                  "HTTP/1.1 304 Not Modified\r\n"
+                                  "ETag: %s\r\n"
+                                  "Connection: keep-alive\r\n"
+                                  "\r\n",
+                                  etag.c_str());
+            }
+            else
+            {
+                length = snprintf(head, sizeof(head),
+                                  "HTTP/1.1 200 OK\r\n"
+                                  "Content-Type: application/json\r\n"
+                                  "Content-Length: %u\r\n"
+                                  "ETag: %s\r\n"
+                                  "Connection: keep-alive\r\n"
+                                  "\r\n",
+                                  (unsigned int)body.length(), etag.c_str());
+                // ハンドラが途中で読むのをやめても、接続を使い回すため残りは読み捨てる
+                bodyBytes += body.length();
+            }
+            if (length > 0)
+            {
+                headerBytes += (unsigned long)length;
+            }
+        }
+
+        static bool readFile(const std::string &path, std::string &body)
+        {
+            FILE *file = fopen(path.c_str(), "rb");
+            if (file == nullptr)
+            {
+                return false;
+            }
+
+            char buffer[4096];
+            size_t length;
+            body.clear();
+            while ((length = fread(buffer, 1, sizeof(buffer), file)) > 0)
+            {
+                body.append(buffer, length);
+            }
+            fclose(file);
+            return true;
+        }
+
+        static bool formatLocalTime(char *buffer, size_t bufferSize, const char *format)
+        {
+            time_t now = time(nullptr);
+            struct tm timeinfo;
+            localtime_r(&now, &timeinfo);
+            return strftime(buffer, bufferSize, format, &timeinfo) > 0;
+        }
+    };
+}
+
+#endif // FILE_NETWORK_SERVICE_H
@@ -0,0 +1,57 @@
+// RecordedFixture.h
+// 記録したAPIレスポンス（test/fixtures）に合わせた時刻と、それを取得する手順（ネイティブ環境のテスト用）
+
+#ifndef RECORDED_FIXTURE_H
+#define RECORDED_FIXTURE_H
+
+#include <stdlib.h>
+#include <time.h>
+#include <NativeHal.h>
+#include "domain/ScheduleSnapshot.h"
+#include "infrastructure/APIScheduleRepository.h"
+#include "support/FileNetworkService.h"
+
+namespace TestSupport
+{
+    // 記録したレスポンスの最初のスロット（2024-06-01 09:00 JST）
+    constexpr time_t FIRST_SLOT_START = 1717200000;
+    constexpr time_t SLOT_SECONDS = 2 * 60 * 60;
+
+    // 最初のスロットの10分後（記録したレスポンスの/nowが現在のスロットになる時刻）
+    constexpr time_t FIXTURE_EPOCH = FIRST_SLOT_START + 10 * 60;
+
+    // 記録したレスポンスの時刻を日本時間で解釈する
+    inline void setRecordedTimeZone()
+    {
+        setenv("TZ", "JST-9", 1);
+        tzset();
+    }
+
+    // 疑似HALを初期化し、時計を止めてFIXTURE_EPOCHに合わせる
+    inline void resetRecordedClock(unsigned long millis = 1000)
+    {
+        NativeHal::reset();
+        NativeHal::freezeClock(millis);
+        NativeHal::setEpoch(FIXTURE_EPOCH);
+        setRecordedTimeZone();
+    }
+
+    // 記録したレスポンスを指定した取得方法と1回に読める量で取得し、スナップショットに読み出す
+    // 取得が確認された（すべてのリクエストが成功した）場合はtrue
+    inline bool fetchRecordedSnapshot(Domain::ScheduleSnapshot &snapshot,
+                                      Infrastructure::APIScheduleRepository::FetchMode mode =
+                                          Infrastructure::APIScheduleRepository::FetchMode::BULK,
+                                      size_t chunkSize = 0)
+    {
+        FileNetworkService network;
+        network.setChunkSize(chunkSize);
+        Infrastructure::APIScheduleRepository repository(network);
+        repository.setFetchMode(mode);
+
+        bool updated = repository.updateAllSchedules();
+        repository.readSnapshot(snapshot);
+        return updated && repository.getLastUpdateStats().confirmed;
+    }
+}
+
+#endif // RECORDED_FIXTURE_H
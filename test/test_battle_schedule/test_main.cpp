@@ -0,0 +1,138 @@
+// test_main.cpp
+// 12バイトに詰めたBattleScheduleから、作成時の値がそのまま読み出せることのテスト
+
+#include <unity.h>
+#include <time.h>
+#include "domain/BattleSchedule.h"
+#include "support/RecordedFixture.h"
+
+using Domain::BattleSchedule;
+using Domain::BattleType;
+using Domain::Rule;
+using Domain::Stage;
+using TestSupport::FIRST_SLOT_START;
+using TestSupport::SLOT_SECONDS;
+
+namespace
+{
+    BattleSchedule createSlot(BattleType::Type battleType, Rule::Type rule, Stage::Type stage1, Stage::Type stage2,
+                              time_t start, time_t end)
+    {
+        return BattleSchedule::create(BattleType::fromType(battleType), Rule::fromType(rule),
+                                      Stage::fromType(stage1), Stage::fromType(stage2), start, end);
+    }
+}
+
+void setUp(void)
+{
+    TestSupport::setRecordedTimeZone();
+}
+
+void tearDown(void)
+{
+}
+
+// 全てのバトルタイプ・ルール・ステージの組み合わせが詰めた後も同じ値で読み出せる
+void test_every_value_round_trips(void)
+{
+    const int battleTypeCount = static_cast<int>(BattleType::TYPE_COUNT);
+    const int ruleCount = static_cast<int>(Rule::Type::UNKNOWN) + 1;
+    const int stageCount = static_cast<int>(Stage::Type::UNKNOWN) + 1;
+
+    for (int battleType = 0; battleType < battleTypeCount; battleType++)
+    {
+        for (int rule = 0; rule < ruleCount; rule++)
+        {
+            for (int stage = 0; stage < stageCount; stage++)
+            {
+                // 2つ目のステージは1つ目と別の値にする
+                int otherStage = (stage + 1) % stageCount;
+                BattleSchedule slot = createSlot(
+                    static_cast<BattleType::Type>(battleType), static_cast<Rule::Type>(rule),
+                    static_cast<Stage::Type>(stage), static_cast<Stage::Type>(otherStage),
+                    FIRST_SLOT_START, FIRST_SLOT_START + SLOT_SECONDS);
+
+                TEST_ASSERT_TRUE(slot.isValid());
+                TEST_ASSERT_EQUAL(battleType, static_cast<int>(slot.getBattleType().getType()));
+                TEST_ASSERT_EQUAL(rule, static_cast<int>(slot.getRule().getType()));
+                TEST_ASSERT_EQUAL(stage, static_cast<int>(slot.getStage1().getType()));
+                TEST_ASSERT_EQUAL(otherStage, static_cast<int>(slot.getStage2().getType()));
+            }
+        }
+    }
+}
+
+// 時刻は分単位で保持し、2106年以降の時刻も桁あふれしない
+void test_times_round_trip_in_minutes(void)
+{
+    BattleSchedule slot = createSlot(BattleType::Type::X_MATCH, Rule::Type::CLAM_BLITZ, Stage::Type::BLUEFIN_DEPOT,
+                                     Stage::Type::UMAMI_RUINS, FIRST_SLOT_START + 59, FIRST_SLOT_START + SLOT_SECONDS);
+    TEST_ASSERT_EQUAL(FIRST_SLOT_START, slot.getStartEpoch());
+    TEST_ASSERT_EQUAL(FIRST_SLOT_START + SLOT_SECONDS, slot.getEndEpoch());
+
+    // 2200-01-01 00:00 UTC
+    const time_t farFuture = 7258118400LL;
+    BattleSchedule later = createSlot(BattleType::Type::REGULAR, Rule::Type::TURF_WAR, Stage::Type::SCORCH_GORGE,
+                                      Stage::Type::MAKO_MART, farFuture, farFuture + SLOT_SECONDS);
+    TEST_ASSERT_TRUE(later.getStartEpoch() == farFuture);
+    TEST_ASSERT_TRUE(later.getEndEpoch() == farFuture + SLOT_SECONDS);
+}
+
+// 表示用の時刻は現地時刻で組み立て、不明な時刻は"--:--"になる
+void test_formats_local_time(void)
+{
+    char start[BattleSchedule::TIME_TEXT_SIZE];
+    char end[BattleSchedule::TIME_TEXT_SIZE];
+
+    BattleSchedule slot = createSlot(BattleType::Type::BANKARA_OPEN, Rule::Type::RAINMAKER, Stage::Type::MAKO_MART,
+                                     Stage::Type::BLUEFIN_DEPOT, FIRST_SLOT_START, FIRST_SLOT_START + SLOT_SECONDS);
+    slot.formatStartTime(start, sizeof(start));
+    slot.formatEndTime(end, sizeof(end));
+    TEST_ASSERT_EQUAL_STRING("09:00", start);
+    TEST_ASSERT_EQUAL_STRING("11:00", end);
+
+    BattleSchedule unknownTimes = createSlot(BattleType::Type::REGULAR, Rule::Type::TURF_WAR,
+                                             Stage::Type::SCORCH_GORGE, Stage::Type::MAKO_MART, -1, 0);
+    TEST_ASSERT_EQUAL(0, unknownTimes.getStartEpoch());
+    TEST_ASSERT_EQUAL(0, unknownTimes.getEndEpoch());
+    unknownTimes.formatStartTime(start, sizeof(start));
+    unknownTimes.formatEndTime(end, sizeof(end));
+    TEST_ASSERT_EQUAL_STRING("--:--", start);
+    TEST_ASSERT_EQUAL_STRING("--:--", end);
+    TEST_ASSERT_EQUAL(0, unknownTimes.getSecondsUntilEnd(FIRST_SLOT_START));
+}
+
+// 空のスロットはバトルタイプだけを保持し、無効として扱われる
+void test_empty_slot_keeps_battle_type(void)
+{
+    BattleSchedule empty = BattleSchedule::createEmpty(BattleType::bankaraChallenge());
+    TEST_ASSERT_FALSE(empty.isValid());
+    TEST_ASSERT_TRUE(empty.getBattleType().getType() == BattleType::Type::BANKARA_CHALLENGE);
+    TEST_ASSERT_TRUE(empty.getRule().getType() == Rule::Type::UNKNOWN);
+    TEST_ASSERT_TRUE(empty.getStage1().getType() == Stage::Type::UNKNOWN);
+    TEST_ASSERT_TRUE(empty.getStage2().getType() == Stage::Type::UNKNOWN);
+    TEST_ASSERT_EQUAL(0, empty.getSecondsUntilEnd(FIRST_SLOT_START));
+}
+
+// 終了までの秒数は渡したUNIX時間から数える
+void test_seconds_until_end(void)
+{
+    BattleSchedule slot = createSlot(BattleType::Type::REGULAR, Rule::Type::TURF_WAR, Stage::Type::SCORCH_GORGE,
+                                     Stage::Type::MAKO_MART, FIRST_SLOT_START, FIRST_SLOT_START + SLOT_SECONDS);
+    TEST_ASSERT_EQUAL(SLOT_SECONDS, slot.getSecondsUntilEnd(FIRST_SLOT_START));
+    TEST_ASSERT_EQUAL(1, slot.getSecondsUntilEnd(FIRST_SLOT_START + SLOT_SECONDS - 1));
+    TEST_ASSERT_TRUE(slot.getSecondsUntilEnd(FIRST_SLOT_START + SLOT_SECONDS + 60) < 0);
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_every_value_round_trips);
+    RUN_TEST(test_times_round_trip_in_minutes);
+    RUN_TEST(test_formats_local_time);
+    RUN_TEST(test_empty_slot_keeps_battle_type);
+    RUN_TEST(test_seconds_until_end);
+    return UNITY_END();
+}
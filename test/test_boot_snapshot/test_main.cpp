@@ -0,0 +1,183 @@
+// test_main.cpp
+// 保存したスケジュールを再起動後すぐに表示できることと、PreferencesSnapshotStoreの保存形式のテスト
+
+#include <unity.h>
+#include <Preferences.h>
+#include <NativeHal.h>
+#include <TFT_eSPI.h>
+#include "application/ScheduleApplicationService.h"
+#include "application/ScheduleService.h"
+#include "infrastructure/APIScheduleRepository.h"
+#include "infrastructure/PreferencesSnapshotStore.h"
+#include "infrastructure/TFTDisplayService.h"
+#include "support/FileNetworkService.h"
+#include "support/RecordedFixture.h"
+
+using Domain::BattleType;
+using Domain::ScheduleSnapshot;
+
+namespace
+{
+    // 再起動から保存したスケジュールを表示するまでの仮想の時刻
+    constexpr unsigned long BOOT_MILLIS = 800;
+
+    // 記録したレスポンスを取得してスナップショットにする
+    ScheduleSnapshot fetchRecordedSnapshot()
+    {
+        ScheduleSnapshot snapshot;
+        TEST_ASSERT_TRUE(TestSupport::fetchRecordedSnapshot(snapshot));
+        return snapshot;
+    }
+
+    void expectSameSchedules(const ScheduleSnapshot &expected, const ScheduleSnapshot &actual)
+    {
+        for (size_t type = 0; type < BattleType::TYPE_COUNT; type++)
+        {
+            for (size_t slot = 0; slot < ScheduleSnapshot::SLOT_COUNT; slot++)
+            {
+                const Domain::BattleSchedule &a = expected.get(static_cast<BattleType::Type>(type), slot);
+                const Domain::BattleSchedule &b = actual.get(static_cast<BattleType::Type>(type), slot);
+                TEST_ASSERT_EQUAL(a.isValid(), b.isValid());
+                TEST_ASSERT_TRUE(a.getRule().getType() == b.getRule().getType());
+                TEST_ASSERT_TRUE(a.getStage1().getType() == b.getStage1().getType());
+                TEST_ASSERT_TRUE(a.getStage2().getType() == b.getStage2().getType());
+                TEST_ASSERT_TRUE(a.getStartEpoch() == b.getStartEpoch());
+                TEST_ASSERT_TRUE(a.getEndEpoch() == b.getEndEpoch());
+            }
+        }
+    }
+
+    // 保存された形式のバイト列を書き換える
+    void corruptSavedByte(size_t offset, uint8_t mask)
+    {
+        Preferences preferences;
+        TEST_ASSERT_TRUE(preferences.begin("schedule", false));
+        size_t length = preferences.getBytesLength("snapshot");
+        TEST_ASSERT_TRUE(offset < length);
+
+        uint8_t blob[512];
+        TEST_ASSERT_TRUE(length <= sizeof(blob));
+        preferences.getBytes("snapshot", blob, length);
+        blob[offset] ^= mask;
+        preferences.putBytes("snapshot", blob, length);
+        preferences.end();
+    }
+}
+
+void setUp(void)
+{
+    TestSupport::resetRecordedClock();
+}
+
+void tearDown(void)
+{
+}
+
+// 保存したスケジュールは再起動後も同じ内容で読み込める
+void test_saved_snapshot_round_trips(void)
+{
+    ScheduleSnapshot fetched = fetchRecordedSnapshot();
+    Infrastructure::PreferencesSnapshotStore store;
+    TEST_ASSERT_TRUE(store.save(fetched));
+
+    Infrastructure::PreferencesSnapshotStore storeAfterReboot;
+    ScheduleSnapshot loaded;
+    TEST_ASSERT_TRUE(storeAfterReboot.load(loaded));
+    expectSameSchedules(fetched, loaded);
+}
+
+// 内容が同じなら書き込まず、フラッシュを摩耗させない
+void test_unchanged_snapshot_is_not_rewritten(void)
+{
+    ScheduleSnapshot fetched = fetchRecordedSnapshot();
+    Infrastructure::PreferencesSnapshotStore store;
+    TEST_ASSERT_TRUE(store.save(fetched));
+
+    unsigned long writes = Preferences::getWriteCount();
+    TEST_ASSERT_TRUE(store.save(fetched));
+    TEST_ASSERT_EQUAL(writes, Preferences::getWriteCount());
+}
+
+// 保存されていない、壊れている、形式が違う場合は読み込まず、呼び出し元の内容も変えない
+void test_missing_or_corrupt_snapshot_is_rejected(void)
+{
+    Infrastructure::PreferencesSnapshotStore store;
+    ScheduleSnapshot loaded;
+    TEST_ASSERT_FALSE(store.load(loaded));
+
+    ScheduleSnapshot fetched = fetchRecordedSnapshot();
+    TEST_ASSERT_TRUE(store.save(fetched));
+
+    // スロットの1ビットが変わればCRCで検出する
+    corruptSavedByte(20, 0x01);
+    TEST_ASSERT_FALSE(store.load(loaded));
+    TEST_ASSERT_FALSE(loaded.getCurrent(BattleType::Type::REGULAR).isValid());
+
+    // 形式の版が違う場合も読み込まない（CRCは正しくても使わない）
+    TestSupport::resetRecordedClock();
+    TEST_ASSERT_TRUE(store.save(fetched));
+    corruptSavedByte(0, 0xFF);
+    TEST_ASSERT_FALSE(store.load(loaded));
+}
+
+// 再起動直後は通信を待たずに保存したスケジュールを描き、次の取得で確認されるまで古い扱いにする
+void test_boot_shows_saved_schedules_before_network(void)
+{
+    ScheduleSnapshot fetched = fetchRecordedSnapshot();
+    {
+        Infrastructure::PreferencesSnapshotStore store;
+        TEST_ASSERT_TRUE(store.save(fetched));
+    }
+
+    // 再起動：保存領域以外は作り直し、時計は起動直後から進める（時刻は保存前と同じ）
+    NativeHal::freezeClock(BOOT_MILLIS);
+    NativeHal::setEpoch(TestSupport::FIXTURE_EPOCH);
+    TestSupport::FileNetworkService network;
+    network.setConnected(false);
+    Infrastructure::APIScheduleRepository repository(network);
+    Application::ScheduleService scheduleService(repository);
+    Infrastructure::TFTDisplayService display(21, 0);
+    Application::ScheduleApplicationService app(scheduleService, display, network);
+    Infrastructure::PreferencesSnapshotStore store;
+
+    display.initialize();
+    TFT_eSPI::resetPanelStats();
+
+    ScheduleSnapshot saved;
+    TEST_ASSERT_TRUE(store.load(saved));
+    app.showSavedSnapshot(saved);
+
+    TEST_ASSERT_EQUAL(BOOT_MILLIS, millis());
+    TEST_ASSERT_TRUE(network.getRequestLog().empty());
+    TEST_ASSERT_TRUE(display.isShowingSchedules());
+    const TftPanelStats &stats = TFT_eSPI::panelStats();
+    TEST_ASSERT_GREATER_THAN(0, stats.pixels);
+    const char *stageName = fetched.getCurrent(BattleType::Type::REGULAR).getStage1().getRomajiName();
+    TEST_ASSERT_TRUE(stats.text.find(stageName) != std::string::npos);
+
+    const ScheduleSnapshot &shown = scheduleService.getSnapshot();
+    expectSameSchedules(fetched, shown);
+    for (size_t type = 0; type < BattleType::TYPE_COUNT; type++)
+    {
+        TEST_ASSERT_TRUE(shown.isStale(static_cast<BattleType::Type>(type)));
+    }
+
+    // 接続後の取得で確認されると古い扱いが外れる
+    network.setConnected(true);
+    NativeHal::advanceMillis(5000);
+    scheduleService.updateAllSchedules();
+    TEST_ASSERT_TRUE(scheduleService.getLastUpdateStats().confirmed);
+    TEST_ASSERT_FALSE(scheduleService.getSnapshot().isStale(BattleType::Type::REGULAR));
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_saved_snapshot_round_trips);
+    RUN_TEST(test_unchanged_snapshot_is_not_rewritten);
+    RUN_TEST(test_missing_or_corrupt_snapshot_is_rejected);
+    RUN_TEST(test_boot_shows_saved_schedules_before_network);
+    return UNITY_END();
+}
@@ -0,0 +1,139 @@
+// test_main.cpp
+// Rule/Stage/BattleTypeのカタログに、すべての種類の値がそろっていることのテスト
+
+#include <unity.h>
+#include <string.h>
+#include <string>
+#include "domain/BattleType.h"
+#include "domain/Rule.h"
+#include "domain/Stage.h"
+
+using Domain::BattleType;
+using Domain::Rule;
+using Domain::Stage;
+
+namespace
+{
+    // 画面の背景色（TFT_BLACK）。同じ色の記号や見出しは見えなくなる
+    constexpr uint16_t BACKGROUND_COLOR = 0x0000;
+
+    void assertText(const char *value, const std::string &label)
+    {
+        TEST_ASSERT_NOT_NULL_MESSAGE(value, label.c_str());
+        TEST_ASSERT_TRUE_MESSAGE(value[0] != '\0', label.c_str());
+    }
+
+    // 同じ列の中で値が重ならない（カタログの行を写し間違えると重なる）
+    void assertDistinct(const char *value, const char *other, const std::string &label)
+    {
+        TEST_ASSERT_TRUE_MESSAGE(strcmp(value, other) != 0, label.c_str());
+    }
+
+    std::string labelOf(const char *column, int index)
+    {
+        return std::string(column) + "[" + std::to_string(index) + "]";
+    }
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+// UNKNOWNを含むすべてのルールに名前・記号・記号の色がある
+void test_every_rule_has_catalog_entries(void)
+{
+    for (int i = 0; i <= static_cast<int>(Rule::Type::UNKNOWN); i++)
+    {
+        Rule rule = Rule::fromType(static_cast<Rule::Type>(i));
+        assertText(rule.getJapaneseName(), labelOf("rule japaneseNames", i));
+        assertText(rule.getEnglishName(), labelOf("rule englishNames", i));
+        assertText(rule.getRomajiName(), labelOf("rule romajiNames", i));
+        assertText(rule.getDisplayName(true), labelOf("rule displayName(romaji)", i));
+        assertText(rule.getDisplayName(false), labelOf("rule displayName(english)", i));
+
+        // 記号のないルール（ナワバリ、不明）は空文字列になる
+        TEST_ASSERT_NOT_NULL_MESSAGE(rule.getSymbol(), labelOf("rule symbols", i).c_str());
+        TEST_ASSERT_NOT_EQUAL_MESSAGE(BACKGROUND_COLOR, rule.getSymbolColor(), labelOf("rule symbolColors", i).c_str());
+
+        for (int j = 0; j < i; j++)
+        {
+            Rule earlier = Rule::fromType(static_cast<Rule::Type>(j));
+            assertDistinct(rule.getJapaneseName(), earlier.getJapaneseName(), labelOf("rule japaneseNames", i));
+            assertDistinct(rule.getEnglishName(), earlier.getEnglishName(), labelOf("rule englishNames", i));
+            assertDistinct(rule.getRomajiName(), earlier.getRomajiName(), labelOf("rule romajiNames", i));
+        }
+    }
+}
+
+// UNKNOWNを含むすべてのステージに名前がある
+void test_every_stage_has_catalog_entries(void)
+{
+    for (int i = 0; i <= static_cast<int>(Stage::Type::UNKNOWN); i++)
+    {
+        Stage stage = Stage::fromType(static_cast<Stage::Type>(i));
+        assertText(stage.getJapaneseName(), labelOf("stage japaneseNames", i));
+        assertText(stage.getEnglishName(), labelOf("stage englishNames", i));
+        assertText(stage.getRomajiName(), labelOf("stage romajiNames", i));
+
+        for (int j = 0; j < i; j++)
+        {
+            Stage earlier = Stage::fromType(static_cast<Stage::Type>(j));
+            assertDistinct(stage.getJapaneseName(), earlier.getJapaneseName(), labelOf("stage japaneseNames", i));
+            assertDistinct(stage.getEnglishName(), earlier.getEnglishName(), labelOf("stage englishNames", i));
+            assertDistinct(stage.getRomajiName(), earlier.getRomajiName(), labelOf("stage romajiNames", i));
+        }
+    }
+}
+
+// すべてのバトルタイプに名前・色・取得先がある
+void test_every_battle_type_has_catalog_entries(void)
+{
+    for (int i = 0; i < static_cast<int>(BattleType::TYPE_COUNT); i++)
+    {
+        BattleType battleType = BattleType::fromType(static_cast<BattleType::Type>(i));
+        assertText(battleType.getJapaneseName(), labelOf("battle type japaneseNames", i));
+        assertText(battleType.getEnglishName(), labelOf("battle type englishNames", i));
+        assertText(battleType.getRomajiName(), labelOf("battle type romajiNames", i));
+        assertText(battleType.getDisplayName(true), labelOf("battle type displayName(romaji)", i));
+        assertText(battleType.getDisplayName(false), labelOf("battle type displayName(english)", i));
+        assertText(battleType.getApiKey(), labelOf("battle type apiKeys", i));
+        TEST_ASSERT_NOT_EQUAL_MESSAGE(BACKGROUND_COLOR, battleType.getColor(),
+                                      labelOf("battle type colors", i).c_str());
+
+        // エンドポイントごとの取得先は/api/<種類>/nowと/api/<種類>/next
+        std::string current = battleType.getCurrentScheduleUrl() != nullptr ? battleType.getCurrentScheduleUrl() : "";
+        std::string next = battleType.getNextScheduleUrl() != nullptr ? battleType.getNextScheduleUrl() : "";
+        std::string base = current.substr(0, current.rfind('/'));
+        std::string expectedCurrent = base + "/now";
+        std::string expectedNext = base + "/next";
+        TEST_ASSERT_TRUE_MESSAGE(current.compare(0, 8, "https://") == 0, labelOf("battle type currentScheduleUrls", i).c_str());
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(expectedCurrent.c_str(), current.c_str(),
+                                         labelOf("battle type currentScheduleUrls", i).c_str());
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(expectedNext.c_str(), next.c_str(),
+                                         labelOf("battle type nextScheduleUrls", i).c_str());
+
+        for (int j = 0; j < i; j++)
+        {
+            BattleType earlier = BattleType::fromType(static_cast<BattleType::Type>(j));
+            assertDistinct(battleType.getJapaneseName(), earlier.getJapaneseName(), labelOf("battle type japaneseNames", i));
+            assertDistinct(battleType.getApiKey(), earlier.getApiKey(), labelOf("battle type apiKeys", i));
+            assertDistinct(battleType.getCurrentScheduleUrl(), earlier.getCurrentScheduleUrl(),
+                           labelOf("battle type currentScheduleUrls", i));
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_every_rule_has_catalog_entries);
+    RUN_TEST(test_every_stage_has_catalog_entries);
+    RUN_TEST(test_every_battle_type_has_catalog_entries);
+    return UNITY_END();
+}
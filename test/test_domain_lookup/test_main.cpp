@@ -0,0 +1,107 @@
+// test_main.cpp
+// 日本語名からのRule/Stageの検索が、名前を順に比較する方法と同じ結果になることのテスト
+
+#include <unity.h>
+#include <string.h>
+#include <string>
+#include "domain/Rule.h"
+#include "domain/Stage.h"
+
+using Domain::Rule;
+using Domain::Stage;
+
+namespace
+{
+    // 以前の実装と同じく、UNKNOWN以外の名前を順に比較する
+    template <typename T>
+    typename T::Type findByComparison(const char *name)
+    {
+        for (int i = 0; i < static_cast<int>(T::Type::UNKNOWN); i++)
+        {
+            T candidate = T::fromType(static_cast<typename T::Type>(i));
+            if (strcmp(name, candidate.getJapaneseName()) == 0)
+            {
+                return candidate.getType();
+            }
+        }
+        return T::Type::UNKNOWN;
+    }
+
+    // 名前と、一致しないよう少し変えた名前で両方の検索を比べる
+    template <typename T>
+    void assertEquivalentForAllNames()
+    {
+        for (int i = 0; i <= static_cast<int>(T::Type::UNKNOWN); i++)
+        {
+            std::string name = T::fromType(static_cast<typename T::Type>(i)).getJapaneseName();
+            const std::string variants[] = {
+                name,
+                name.substr(0, name.size() - 3), // 最後の1文字（UTF-8で3バイト）を欠く
+                name + "X",
+                " " + name,
+                T::fromType(static_cast<typename T::Type>(i)).getEnglishName(),
+            };
+
+            for (const std::string &variant : variants)
+            {
+                TEST_ASSERT_EQUAL_MESSAGE(static_cast<int>(findByComparison<T>(variant.c_str())),
+                                          static_cast<int>(T::fromJapaneseName(variant.c_str()).getType()),
+                                          variant.c_str());
+            }
+        }
+    }
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+// カタログのすべての名前から元の種類に戻る
+void test_every_catalog_name_round_trips(void)
+{
+    for (int i = 0; i < static_cast<int>(Rule::Type::UNKNOWN); i++)
+    {
+        Rule rule = Rule::fromType(static_cast<Rule::Type>(i));
+        TEST_ASSERT_TRUE(Rule::fromJapaneseName(rule.getJapaneseName()) == rule);
+    }
+    for (int i = 0; i < static_cast<int>(Stage::Type::UNKNOWN); i++)
+    {
+        Stage stage = Stage::fromType(static_cast<Stage::Type>(i));
+        TEST_ASSERT_TRUE(Stage::fromJapaneseName(stage.getJapaneseName()).getType() == stage.getType());
+    }
+}
+
+void test_rule_lookup_matches_comparison(void)
+{
+    assertEquivalentForAllNames<Rule>();
+}
+
+void test_stage_lookup_matches_comparison(void)
+{
+    assertEquivalentForAllNames<Stage>();
+}
+
+// 空文字列やAPIにない名前はUNKNOWNになる
+void test_unknown_names(void)
+{
+    TEST_ASSERT_TRUE(Rule::fromJapaneseName("") == Rule::unknown());
+    TEST_ASSERT_TRUE(Rule::fromJapaneseName("トリカラバトル") == Rule::unknown());
+    TEST_ASSERT_TRUE(Stage::fromJapaneseName("").getType() == Stage::Type::UNKNOWN);
+    TEST_ASSERT_TRUE(Stage::fromJapaneseName("Bエリア").getType() == Stage::Type::UNKNOWN);
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_every_catalog_name_round_trips);
+    RUN_TEST(test_rule_lookup_matches_comparison);
+    RUN_TEST(test_stage_lookup_matches_comparison);
+    RUN_TEST(test_unknown_names);
+    return UNITY_END();
+}
@@ -0,0 +1,199 @@
+// test_main.cpp
+// 仮想の時計でEventSchedulerを動かし、イベントの発生時刻と順序を確かめるテスト
+
+#include <unity.h>
+#include <limits.h>
+#include "application/EventScheduler.h"
+
+using Application::AppEvent;
+using Application::EventScheduler;
+
+namespace
+{
+    constexpr size_t EVENT_COUNT = static_cast<size_t>(AppEvent::COUNT);
+
+    // メインループと同じく、次のイベントまで仮想の時計を進めて処理する
+    // 処理したイベントの回数と、ループが起きた回数を数える
+    struct VirtualLoop
+    {
+        EventScheduler &scheduler;
+        unsigned long now;
+        unsigned int counts[EVENT_COUNT];
+        unsigned int wakeups;
+
+        VirtualLoop(EventScheduler &scheduler, unsigned long start) : scheduler(scheduler), now(start), wakeups(0)
+        {
+            for (size_t i = 0; i < EVENT_COUNT; i++)
+            {
+                counts[i] = 0;
+            }
+        }
+
+        void runFor(unsigned long durationMillis)
+        {
+            unsigned long end = now + durationMillis;
+            while (true)
+            {
+                unsigned long wait = scheduler.getMillisUntilNextEvent(now);
+                if (wait == EventScheduler::NO_DEADLINE || wait > end - now)
+                {
+                    now = end;
+                    return;
+                }
+
+                now += wait;
+                wakeups++;
+                AppEvent event;
+                while (scheduler.takeNext(now, event))
+                {
+                    counts[static_cast<size_t>(event)]++;
+                }
+            }
+        }
+
+        unsigned int count(AppEvent event) const { return counts[static_cast<size_t>(event)]; }
+    };
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+// 一度だけのタイマーは期限に1回だけ発生する
+void test_one_shot_fires_once_at_deadline(void)
+{
+    EventScheduler scheduler;
+    AppEvent event;
+
+    scheduler.scheduleAfter(AppEvent::REFRESH_DUE, 1000, 500);
+    TEST_ASSERT_EQUAL(500, scheduler.getMillisUntilNextEvent(1000));
+    TEST_ASSERT_FALSE(scheduler.takeNext(1499, event));
+    TEST_ASSERT_TRUE(scheduler.takeNext(1500, event));
+    TEST_ASSERT_TRUE(event == AppEvent::REFRESH_DUE);
+    TEST_ASSERT_FALSE(scheduler.isScheduled(AppEvent::REFRESH_DUE));
+    TEST_ASSERT_FALSE(scheduler.takeNext(5000, event));
+    TEST_ASSERT_EQUAL(EventScheduler::NO_DEADLINE, scheduler.getMillisUntilNextEvent(5000));
+}
+
+// 周期タイマーは処理が遅れても周期がずれず、ループは期限のときだけ起きる
+void test_periodic_timers_keep_cadence(void)
+{
+    EventScheduler scheduler;
+    scheduler.scheduleEvery(AppEvent::TIME_DISPLAY, 0, 1000);
+    scheduler.scheduleEvery(AppEvent::MEMORY_CHECK, 0, 60000);
+
+    VirtualLoop loop(scheduler, 0);
+    loop.runFor(10UL * 60 * 1000);
+
+    TEST_ASSERT_EQUAL(600, loop.count(AppEvent::TIME_DISPLAY));
+    TEST_ASSERT_EQUAL(10, loop.count(AppEvent::MEMORY_CHECK));
+    // 両方の期限が重なる時刻は1回の起床でまとめて処理する
+    TEST_ASSERT_EQUAL(600, loop.wakeups);
+
+    // 期限から少し遅れて処理しても、次の期限は元の周期のまま
+    AppEvent event;
+    unsigned long now = loop.now + 1000 + 300;
+    TEST_ASSERT_TRUE(scheduler.takeNext(now, event));
+    TEST_ASSERT_TRUE(event == AppEvent::TIME_DISPLAY);
+    TEST_ASSERT_EQUAL(700, scheduler.getMillisUntilNextEvent(now));
+}
+
+// 大きく遅れた周期タイマーは取りこぼした分を1回にまとめる
+void test_missed_periods_are_dropped(void)
+{
+    EventScheduler scheduler;
+    AppEvent event;
+    scheduler.scheduleEvery(AppEvent::TIME_DISPLAY, 0, 1000);
+
+    TEST_ASSERT_TRUE(scheduler.takeNext(5500, event));
+    TEST_ASSERT_FALSE(scheduler.takeNext(5500, event));
+    TEST_ASSERT_EQUAL(1000, scheduler.getMillisUntilNextEvent(5500));
+    TEST_ASSERT_EQUAL(1000, scheduler.getPeriod(AppEvent::TIME_DISPLAY));
+}
+
+// 発生済みのイベントは同じ種類が1つにまとまり、タイマーより先に列挙順で返る
+void test_posted_events_coalesce_and_come_first(void)
+{
+    EventScheduler scheduler;
+    AppEvent event;
+    scheduler.scheduleAfter(AppEvent::WIFI_POLL, 0, 100);
+    scheduler.post(AppEvent::SERIAL_INPUT);
+    scheduler.post(AppEvent::FETCH_COMPLETED);
+    scheduler.post(AppEvent::FETCH_COMPLETED);
+    TEST_ASSERT_EQUAL(0, scheduler.getMillisUntilNextEvent(0));
+
+    TEST_ASSERT_TRUE(scheduler.takeNext(200, event));
+    TEST_ASSERT_TRUE(event == AppEvent::FETCH_COMPLETED);
+    TEST_ASSERT_TRUE(scheduler.takeNext(200, event));
+    TEST_ASSERT_TRUE(event == AppEvent::SERIAL_INPUT);
+    TEST_ASSERT_TRUE(scheduler.takeNext(200, event));
+    TEST_ASSERT_TRUE(event == AppEvent::WIFI_POLL);
+    TEST_ASSERT_FALSE(scheduler.takeNext(200, event));
+}
+
+// 期限の来たタイマーは期限の早い順に返る
+void test_most_overdue_timer_first(void)
+{
+    EventScheduler scheduler;
+    AppEvent event;
+    scheduler.scheduleAfter(AppEvent::WIFI_POLL, 0, 300);
+    scheduler.scheduleAfter(AppEvent::MEMORY_CHECK, 0, 100);
+    scheduler.scheduleAfter(AppEvent::INITIALIZE_CHECK, 0, 200);
+
+    TEST_ASSERT_TRUE(scheduler.takeNext(1000, event));
+    TEST_ASSERT_TRUE(event == AppEvent::MEMORY_CHECK);
+    TEST_ASSERT_TRUE(scheduler.takeNext(1000, event));
+    TEST_ASSERT_TRUE(event == AppEvent::INITIALIZE_CHECK);
+    TEST_ASSERT_TRUE(scheduler.takeNext(1000, event));
+    TEST_ASSERT_TRUE(event == AppEvent::WIFI_POLL);
+}
+
+// 止めたタイマーは発生せず、設定し直すと期限が置き換わる
+void test_cancel_and_reschedule(void)
+{
+    EventScheduler scheduler;
+    AppEvent event;
+    scheduler.scheduleEvery(AppEvent::WIFI_POLL, 0, 100);
+    scheduler.cancel(AppEvent::WIFI_POLL);
+    TEST_ASSERT_EQUAL(0, scheduler.getPeriod(AppEvent::WIFI_POLL));
+    TEST_ASSERT_FALSE(scheduler.takeNext(1000, event));
+
+    scheduler.scheduleAfter(AppEvent::REFRESH_DUE, 0, 100);
+    scheduler.scheduleAfter(AppEvent::REFRESH_DUE, 50, 1000);
+    TEST_ASSERT_FALSE(scheduler.takeNext(500, event));
+    TEST_ASSERT_TRUE(scheduler.takeNext(1050, event));
+    TEST_ASSERT_TRUE(event == AppEvent::REFRESH_DUE);
+}
+
+// millis()が一周しても期限の判定が狂わない
+void test_timers_survive_millis_wraparound(void)
+{
+    EventScheduler scheduler;
+    AppEvent event;
+    const unsigned long start = ULONG_MAX - 250;
+    scheduler.scheduleEvery(AppEvent::TIME_DISPLAY, start, 1000);
+
+    TEST_ASSERT_EQUAL(1000, scheduler.getMillisUntilNextEvent(start));
+    TEST_ASSERT_FALSE(scheduler.takeNext(start + 999, event));
+    TEST_ASSERT_TRUE(scheduler.takeNext(start + 1000, event));
+    TEST_ASSERT_EQUAL(1000, scheduler.getMillisUntilNextEvent(start + 1000));
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_one_shot_fires_once_at_deadline);
+    RUN_TEST(test_periodic_timers_keep_cadence);
+    RUN_TEST(test_missed_periods_are_dropped);
+    RUN_TEST(test_posted_events_coalesce_and_come_first);
+    RUN_TEST(test_most_overdue_timer_first);
+    RUN_TEST(test_cancel_and_reschedule);
+    RUN_TEST(test_timers_survive_millis_wraparound);
+    return UNITY_END();
+}
@@ -0,0 +1,459 @@
+// test_main.cpp
+// KeepAliveHttpClientを偽のソケットで動かすテスト
+
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <NativeHal.h>
+#include "infrastructure/KeepAliveHttpClient.h"
+#include "support/FakeClient.h"
+
+using Infrastructure::KeepAliveHttpClient;
+
+namespace
+{
+    const char *const URL = "https://spla3.yuu26.com/api/regular/now";
+
+    // ボディをすべて読み出すハンドラ
+    KeepAliveHttpClient::BodyHandler collectInto(std::string &body)
+    {
+        return [&body](Stream &stream)
+        {
+            char buffer[64];
+            size_t length;
+            while ((length = stream.readBytes(buffer, sizeof(buffer))) > 0)
+            {
+                body.append(buffer, length);
+            }
+            return true;
+        };
+    }
+
+    // 長さsizeのボディをチャンク転送で返すレスポンス
+    std::string chunkedResponse(size_t size, size_t chunkSize)
+    {
+        std::string response = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\nETag: \"big\"\r\n\r\n";
+        for (size_t sent = 0; sent < size; sent += chunkSize)
+        {
+            size_t length = size - sent < chunkSize ? size - sent : chunkSize;
+            char line[16];
+            snprintf(line, sizeof(line), "%zx\r\n", length);
+            response += line;
+            response.append(length, 'x');
+            response += "\r\n";
+        }
+        return response + "0\r\n\r\n";
+    }
+
+    // 指定した長さの検証子の値（終端を除いて配列いっぱい）
+    template <size_t N>
+    void fillValidator(char (&value)[N], char c)
+    {
+        memset(value, c, N - 1);
+        value[N - 1] = '\0';
+    }
+
+    // 完了を記録するハンドラ
+    struct Completion
+    {
+        bool done;
+        int statusCode;
+        bool handlerResult;
+
+        Completion() : done(false), statusCode(0), handlerResult(false) {}
+
+        KeepAliveHttpClient::CompletionHandler handler()
+        {
+            return [this](int code, bool result)
+            {
+                done = true;
+                statusCode = code;
+                handlerResult = result;
+            };
+        }
+    };
+
+    // リクエストが終わるまでpoll()を呼ぶ（無限に回らないよう回数を区切る）
+    void pollUntilIdle(KeepAliveHttpClient &client)
+    {
+        for (int i = 0; i < 100 && client.poll(); i++)
+        {
+        }
+        TEST_ASSERT_FALSE(client.isBusy());
+    }
+}
+
+void setUp(void)
+{
+    NativeHal::reset();
+    NativeHal::freezeClock(1000);
+}
+
+void tearDown(void)
+{
+}
+
+// 最大長のETagとLast-Modifiedも切り詰めずに送る
+void test_conditional_headers_fit_longest_validators(void)
+{
+    TestSupport::FakeClient socket;
+    KeepAliveHttpClient client(socket);
+    socket.respondWith("HTTP/1.1 304 Not Modified\r\nContent-Length: 0\r\n\r\n");
+
+    KeepAliveHttpClient::CacheValidators validators;
+    fillValidator(validators.etag, 'e');
+    fillValidator(validators.lastModified, 'm');
+
+    std::string body;
+    bool handlerResult = false;
+    TEST_ASSERT_EQUAL(304, client.get(URL, collectInto(body), handlerResult, &validators));
+
+    const std::string &sent = socket.getSent();
+    TEST_ASSERT_TRUE(sent.find("If-None-Match: " + std::string(validators.etag) + "\r\n") != std::string::npos);
+    TEST_ASSERT_TRUE(sent.find("If-Modified-Since: " + std::string(validators.lastModified) + "\r\n") !=
+                     std::string::npos);
+    TEST_ASSERT_TRUE(sent.compare(sent.size() - 4, 4, "\r\n\r\n") == 0);
+}
+
+// 上限を超えるContent-Lengthはボディを読まずに失敗させる
+void test_oversized_content_length_is_rejected_up_front(void)
+{
+    TestSupport::FakeClient socket;
+    KeepAliveHttpClient client(socket);
+    socket.respondWith("HTTP/1.1 200 OK\r\nContent-Length: 200000\r\n\r\n{\"result\":[");
+
+    bool called = false;
+    bool handlerResult = true;
+    int status = client.get(
+        URL,
+        [&called](Stream &stream)
+        {
+            (void)stream;
+            called = true;
+            return true;
+        },
+        handlerResult);
+
+    TEST_ASSERT_EQUAL(KeepAliveHttpClient::ERROR_BODY_TOO_LARGE, status);
+    TEST_ASSERT_FALSE(called);
+    TEST_ASSERT_FALSE(handlerResult);
+    TEST_ASSERT_FALSE(socket.connected());
+}
+
+// 長さの分からないチャンク転送も上限で読み出しを止め、検証子を更新しない
+void test_chunked_body_stops_at_limit(void)
+{
+    TestSupport::FakeClient socket;
+    KeepAliveHttpClient client(socket);
+    socket.respondWith(chunkedResponse(KeepAliveHttpClient::MAX_BODY_SIZE + 100, 4096));
+
+    KeepAliveHttpClient::CacheValidators validators;
+    std::string body;
+    bool handlerResult = true;
+    int status = client.get(URL, collectInto(body), handlerResult, &validators);
+
+    TEST_ASSERT_EQUAL(KeepAliveHttpClient::ERROR_BODY_TOO_LARGE, status);
+    TEST_ASSERT_EQUAL(KeepAliveHttpClient::MAX_BODY_SIZE, body.size());
+    TEST_ASSERT_FALSE(handlerResult);
+    TEST_ASSERT_EQUAL_STRING("", validators.etag);
+    TEST_ASSERT_FALSE(socket.connected());
+}
+
+// ちょうど上限のボディは受け付ける
+void test_body_at_limit_is_accepted(void)
+{
+    TestSupport::FakeClient socket;
+    KeepAliveHttpClient client(socket);
+    socket.respondWith(chunkedResponse(KeepAliveHttpClient::MAX_BODY_SIZE, 4096));
+
+    KeepAliveHttpClient::CacheValidators validators;
+    std::string body;
+    bool handlerResult = false;
+    int status = client.get(URL, collectInto(body), handlerResult, &validators);
+
+    TEST_ASSERT_EQUAL(200, status);
+    TEST_ASSERT_TRUE(handlerResult);
+    TEST_ASSERT_EQUAL(KeepAliveHttpClient::MAX_BODY_SIZE, body.size());
+    TEST_ASSERT_EQUAL_STRING("\"big\"", validators.etag);
+    TEST_ASSERT_TRUE(socket.connected());
+}
+
+// 少しずつ届くステータス行とヘッダを、待たずに1段階ずつ読み進める
+void test_partial_feeds_advance_without_blocking(void)
+{
+    TestSupport::FakeClient socket;
+    KeepAliveHttpClient client(socket);
+    Completion completion;
+    std::string body;
+
+    TEST_ASSERT_TRUE(client.start(URL, collectInto(body), nullptr, completion.handler()));
+    TEST_ASSERT_TRUE(client.getState() == KeepAliveHttpClient::State::CONNECTING);
+    TEST_ASSERT_TRUE(client.poll());
+    TEST_ASSERT_TRUE(client.getState() == KeepAliveHttpClient::State::SENDING);
+    TEST_ASSERT_TRUE(client.poll());
+    TEST_ASSERT_TRUE(client.getState() == KeepAliveHttpClient::State::READING_STATUS);
+    TEST_ASSERT_TRUE(socket.getSent().find("GET /api/regular/now HTTP/1.1\r\nHost: spla3.yuu26.com\r\n") == 0);
+
+    // 何も届いていない間は同じ段階に留まる
+    TEST_ASSERT_TRUE(client.poll());
+    TEST_ASSERT_TRUE(client.getState() == KeepAliveHttpClient::State::READING_STATUS);
+
+    socket.feed("HTTP/1.1 2");
+    TEST_ASSERT_TRUE(client.poll());
+    TEST_ASSERT_TRUE(client.getState() == KeepAliveHttpClient::State::READING_STATUS);
+    socket.feed("00 OK\r\nContent-Le");
+    TEST_ASSERT_TRUE(client.poll());
+    TEST_ASSERT_TRUE(client.getState() == KeepAliveHttpClient::State::READING_HEADERS);
+    TEST_ASSERT_TRUE(client.poll());
+    TEST_ASSERT_TRUE(client.getState() == KeepAliveHttpClient::State::READING_HEADERS);
+    socket.feed("ngth: 11\r\nETag: \"a\"\r\n\r");
+    TEST_ASSERT_TRUE(client.poll());
+    TEST_ASSERT_TRUE(client.getState() == KeepAliveHttpClient::State::READING_HEADERS);
+    socket.feed("\n");
+    TEST_ASSERT_TRUE(client.poll());
+    TEST_ASSERT_TRUE(client.getState() == KeepAliveHttpClient::State::READING_BODY);
+
+    // ボディの先頭が届くまではハンドラを呼ばない
+    TEST_ASSERT_TRUE(client.poll());
+    TEST_ASSERT_FALSE(completion.done);
+    socket.feed("{\"ok\":true}");
+    TEST_ASSERT_FALSE(client.poll());
+
+    TEST_ASSERT_TRUE(completion.done);
+    TEST_ASSERT_EQUAL(200, completion.statusCode);
+    TEST_ASSERT_TRUE(completion.handlerResult);
+    TEST_ASSERT_EQUAL_STRING("{\"ok\":true}", body.c_str());
+    TEST_ASSERT_TRUE(socket.connected());
+}
+
+// チャンク転送のボディをつなぎ合わせ、チャンク拡張とトレーラーは読み捨てる
+void test_chunked_body_is_reassembled(void)
+{
+    TestSupport::FakeClient socket;
+    KeepAliveHttpClient client(socket);
+    socket.respondWith("HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n"
+                       "5\r\n{\"res\r\n"
+                       "B;ext=1\r\nults\":[1,2]\r\n"
+                       "1\r\n}\r\n"
+                       "0\r\nX-Trailer: 1\r\n\r\n");
+
+    std::string body;
+    bool handlerResult = false;
+    TEST_ASSERT_EQUAL(200, client.get(URL, collectInto(body), handlerResult));
+    TEST_ASSERT_TRUE(handlerResult);
+    TEST_ASSERT_EQUAL_STRING("{\"results\":[1,2]}", body.c_str());
+
+    // 終端まで読み切ったので接続は次のリクエストに使える
+    TEST_ASSERT_TRUE(socket.connected());
+    TEST_ASSERT_EQUAL(0, socket.available());
+}
+
+// 転送量はリクエスト、ステータス行とヘッダ、ボディ（チャンクの区切りを除く）に分けて数える
+void test_counts_bytes_on_the_wire(void)
+{
+    TestSupport::FakeClient socket;
+    KeepAliveHttpClient client(socket);
+    const std::string head = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\nETag: \"big\"\r\n\r\n";
+    socket.respondWith(chunkedResponse(100, 40));
+
+    // ハンドラが途中で読むのをやめても、読み捨てた残りをボディに含める
+    KeepAliveHttpClient::CacheValidators validators;
+    bool handlerResult = false;
+    TEST_ASSERT_EQUAL(200, client.get(
+                               URL,
+                               [](Stream &stream)
+                               {
+                                   char buffer[10];
+                                   return stream.readBytes(buffer, sizeof(buffer)) == sizeof(buffer);
+                               },
+                               handlerResult, &validators));
+    TEST_ASSERT_TRUE(handlerResult);
+
+    TEST_ASSERT_EQUAL(socket.getSent().size(), client.getRequestBytes());
+    TEST_ASSERT_EQUAL(head.size(), client.getHeaderBytes());
+    TEST_ASSERT_EQUAL(100, client.getBodyBytes());
+
+    // 304はヘッダだけを数え、条件付きリクエストのヘッダも送信量に含める
+    socket.clearSent();
+    socket.respondWith("HTTP/1.1 304 Not Modified\r\n\r\n");
+    std::string body;
+    TEST_ASSERT_EQUAL(304, client.get(URL, collectInto(body), handlerResult, &validators));
+    TEST_ASSERT_TRUE(socket.getSent().find("If-None-Match: \"big\"\r\n") != std::string::npos);
+
+    char expected[KeepAliveHttpClient::REQUEST_BUFFER_SIZE];
+    int requestLength = KeepAliveHttpClient::formatRequest(expected, sizeof(expected), "spla3.yuu26.com",
+                                                           "/api/regular/now", &validators);
+    TEST_ASSERT_EQUAL_STRING(expected, socket.getSent().c_str());
+    TEST_ASSERT_EQUAL(head.size() + strlen("HTTP/1.1 304 Not Modified\r\n\r\n"), client.getHeaderBytes());
+    TEST_ASSERT_EQUAL(100, client.getBodyBytes());
+    TEST_ASSERT_TRUE(requestLength > 0);
+
+    client.resetStats();
+    TEST_ASSERT_EQUAL(0, client.getRequestBytes());
+    TEST_ASSERT_EQUAL(0, client.getHeaderBytes());
+    TEST_ASSERT_EQUAL(0, client.getBodyBytes());
+}
+
+// 同じホストへの続くリクエストは接続を使い回し、ハンドシェイクは1回だけ
+void test_keep_alive_reuses_connection(void)
+{
+    TestSupport::FakeClient socket;
+    KeepAliveHttpClient client(socket);
+    const char *const urls[] = {
+        "https://spla3.yuu26.com/api/regular/now",
+        "https://spla3.yuu26.com/api/regular/next",
+        "https://spla3.yuu26.com/api/x/now"};
+
+    for (const char *url : urls)
+    {
+        socket.respondWith("HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\n{}");
+        std::string body;
+        bool handlerResult = false;
+        TEST_ASSERT_EQUAL(200, client.get(url, collectInto(body), handlerResult));
+        TEST_ASSERT_EQUAL_STRING("{}", body.c_str());
+    }
+
+    TEST_ASSERT_EQUAL(1, socket.getConnectCount());
+    TEST_ASSERT_EQUAL(3, client.getRequestCount());
+    TEST_ASSERT_EQUAL(1, client.getHandshakeCount());
+}
+
+// Connection: closeのレスポンスの後は新しく接続する
+void test_connection_close_forces_new_connection(void)
+{
+    TestSupport::FakeClient socket;
+    KeepAliveHttpClient client(socket);
+    std::string body;
+    bool handlerResult = false;
+
+    socket.respondWith("HTTP/1.1 200 OK\r\nContent-Length: 2\r\nConnection: close\r\n\r\n{}");
+    TEST_ASSERT_EQUAL(200, client.get(URL, collectInto(body), handlerResult));
+    TEST_ASSERT_FALSE(socket.connected());
+
+    socket.respondWith("HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\n{}");
+    TEST_ASSERT_EQUAL(200, client.get(URL, collectInto(body), handlerResult));
+    TEST_ASSERT_EQUAL(2, socket.getConnectCount());
+    TEST_ASSERT_EQUAL(2, client.getHandshakeCount());
+}
+
+// 保持していた接続がリクエストの送信後に閉じられていた場合は、1回だけ再接続して送り直す
+void test_reconnects_when_kept_connection_was_closed(void)
+{
+    TestSupport::FakeClient socket;
+    KeepAliveHttpClient client(socket);
+    std::string body;
+    bool handlerResult = false;
+
+    socket.respondWith("HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\n{}");
+    TEST_ASSERT_EQUAL(200, client.get(URL, collectInto(body), handlerResult));
+
+    Completion completion;
+    body.clear();
+    TEST_ASSERT_TRUE(client.start(URL, collectInto(body), nullptr, completion.handler()));
+    TEST_ASSERT_TRUE(client.poll()); // 保持していた接続を使う
+    TEST_ASSERT_TRUE(client.poll()); // 送信
+    TEST_ASSERT_EQUAL(1, socket.getConnectCount());
+
+    // サーバーは応答せずに接続を閉じていた
+    socket.closeRemote();
+    socket.respondWith("HTTP/1.1 200 OK\r\nContent-Length: 4\r\n\r\n[42]");
+    pollUntilIdle(client);
+
+    TEST_ASSERT_TRUE(completion.done);
+    TEST_ASSERT_EQUAL(200, completion.statusCode);
+    TEST_ASSERT_EQUAL_STRING("[42]", body.c_str());
+    TEST_ASSERT_EQUAL(2, socket.getConnectCount());
+    TEST_ASSERT_EQUAL(2, client.getRequestCount());
+}
+
+// 新しい接続で応答がなければ再接続せずに時間切れにする
+void test_fresh_connection_times_out_without_retry(void)
+{
+    TestSupport::FakeClient socket;
+    KeepAliveHttpClient client(socket);
+    Completion completion;
+    std::string body;
+
+    TEST_ASSERT_TRUE(client.start(URL, collectInto(body), nullptr, completion.handler()));
+    TEST_ASSERT_TRUE(client.poll());
+    TEST_ASSERT_TRUE(client.poll());
+    TEST_ASSERT_TRUE(client.poll());
+    TEST_ASSERT_FALSE(completion.done);
+
+    NativeHal::advanceMillis(10000);
+    pollUntilIdle(client);
+
+    TEST_ASSERT_TRUE(completion.done);
+    TEST_ASSERT_EQUAL(KeepAliveHttpClient::ERROR_READ_TIMEOUT, completion.statusCode);
+    TEST_ASSERT_EQUAL(1, socket.getConnectCount());
+    TEST_ASSERT_FALSE(socket.connected());
+}
+
+// 接続を拒否された場合はハンドラを呼ばずに失敗する
+void test_refused_connect_fails(void)
+{
+    TestSupport::FakeClient socket;
+    KeepAliveHttpClient client(socket);
+    socket.setRefuseConnect(true);
+
+    bool called = false;
+    bool handlerResult = true;
+    int status = client.get(
+        URL,
+        [&called](Stream &stream)
+        {
+            (void)stream;
+            called = true;
+            return true;
+        },
+        handlerResult);
+
+    TEST_ASSERT_EQUAL(KeepAliveHttpClient::ERROR_CONNECTION_FAILED, status);
+    TEST_ASSERT_FALSE(called);
+    TEST_ASSERT_FALSE(handlerResult);
+    TEST_ASSERT_TRUE(socket.getSent().empty());
+    TEST_ASSERT_FALSE(client.isBusy());
+}
+
+// リクエスト中は次のリクエストを受け付けない
+void test_rejects_request_while_busy(void)
+{
+    TestSupport::FakeClient socket;
+    KeepAliveHttpClient client(socket);
+    Completion completion;
+    std::string body;
+
+    TEST_ASSERT_TRUE(client.start(URL, collectInto(body), nullptr, completion.handler()));
+    TEST_ASSERT_FALSE(client.start(URL, collectInto(body), nullptr, completion.handler()));
+
+    bool handlerResult = true;
+    TEST_ASSERT_EQUAL(KeepAliveHttpClient::ERROR_BUSY, client.get(URL, collectInto(body), handlerResult));
+    TEST_ASSERT_FALSE(handlerResult);
+
+    // 中断すると完了は通知されず、次のリクエストを開始できる
+    client.close();
+    TEST_ASSERT_FALSE(completion.done);
+    TEST_ASSERT_TRUE(client.start(URL, collectInto(body), nullptr, completion.handler()));
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_conditional_headers_fit_longest_validators);
+    RUN_TEST(test_oversized_content_length_is_rejected_up_front);
+    RUN_TEST(test_chunked_body_stops_at_limit);
+    RUN_TEST(test_body_at_limit_is_accepted);
+    RUN_TEST(test_partial_feeds_advance_without_blocking);
+    RUN_TEST(test_chunked_body_is_reassembled);
+    RUN_TEST(test_counts_bytes_on_the_wire);
+    RUN_TEST(test_keep_alive_reuses_connection);
+    RUN_TEST(test_connection_close_forces_new_connection);
+    RUN_TEST(test_reconnects_when_kept_connection_was_closed);
+    RUN_TEST(test_fresh_connection_times_out_without_retry);
+    RUN_TEST(test_refused_connect_fails);
+    RUN_TEST(test_rejects_request_while_busy);
+    return UNITY_END();
+}
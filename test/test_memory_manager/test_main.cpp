@@ -0,0 +1,118 @@
+// test_main.cpp
+// MemoryManagerの確保の計測（mallocのラッパーと処理段階ごとの集計）のテスト
+
+#include <unity.h>
+#include <stdlib.h>
+#include <atomic>
+#include <thread>
+#include <NativeHal.h>
+#include <esp_heap_caps.h>
+#include "infrastructure/MemoryManager.h"
+
+using Infrastructure::MemoryManager;
+
+void setUp(void)
+{
+    NativeHal::reset();
+    MemoryManager::resetMemoryStats();
+}
+
+void tearDown(void)
+{
+}
+
+// 段階の中での確保・解放を数える
+void test_phase_counts_wrapped_allocations(void)
+{
+    {
+        MemoryManager::PhaseScope scope(MemoryManager::Phase::PARSE);
+        void *block = malloc(100);
+        void *zeroed = calloc(4, 50);
+        block = realloc(block, 300);
+        free(zeroed);
+        free(block);
+    }
+
+    const MemoryManager::PhaseStats &stats = MemoryManager::getPhaseStats(MemoryManager::Phase::PARSE);
+    TEST_ASSERT_EQUAL(1, stats.runs);
+    TEST_ASSERT_EQUAL(3, stats.allocations);
+    TEST_ASSERT_EQUAL(3, stats.frees);
+    TEST_ASSERT_EQUAL(100 + 200 + 300, stats.allocatedBytes);
+}
+
+// 別のタスク（スレッド）での確保は、並行して開いている段階に含めない
+void test_other_task_allocations_do_not_leak_into_phase(void)
+{
+    // スレッドの生成自体も確保を伴うため、段階を開く前に作っておく
+    std::atomic<int> step(0);
+    std::thread fetchTask(
+        [&step]()
+        {
+            while (step.load() != 1)
+            {
+                std::this_thread::yield();
+            }
+            {
+                MemoryManager::PhaseScope fetchScope(MemoryManager::Phase::FETCH);
+                for (int i = 0; i < 50; i++)
+                {
+                    free(malloc(64));
+                }
+            }
+            step.store(2);
+        });
+
+    {
+        MemoryManager::PhaseScope scope(MemoryManager::Phase::RENDER);
+        step.store(1);
+        while (step.load() != 2)
+        {
+            std::this_thread::yield();
+        }
+        free(malloc(32));
+    }
+    fetchTask.join();
+
+    const MemoryManager::PhaseStats &render = MemoryManager::getPhaseStats(MemoryManager::Phase::RENDER);
+    TEST_ASSERT_EQUAL(1, render.allocations);
+    TEST_ASSERT_EQUAL(32, render.allocatedBytes);
+
+    const MemoryManager::PhaseStats &fetch = MemoryManager::getPhaseStats(MemoryManager::Phase::FETCH);
+    TEST_ASSERT_EQUAL(50, fetch.allocations);
+    TEST_ASSERT_EQUAL(50, fetch.frees);
+}
+
+// 失敗した確保の最大サイズは小さい失敗で上書きされない
+void test_largest_failed_allocation_keeps_maximum(void)
+{
+    std::thread other(
+        []()
+        {
+            for (size_t size = 1; size <= 4000; size++)
+            {
+                heap_caps_notify_failed_alloc(size, MALLOC_CAP_DEFAULT, "test");
+            }
+        });
+    for (size_t size = 4000; size >= 1; size--)
+    {
+        heap_caps_notify_failed_alloc(size, MALLOC_CAP_DEFAULT, "test");
+    }
+    other.join();
+
+    String report = MemoryManager::buildReportJson();
+    TEST_ASSERT_TRUE(report.indexOf("\"largest_failed_allocation\":4000") >= 0);
+    TEST_ASSERT_TRUE(report.indexOf("\"failed_allocations\":8000") >= 0);
+    TEST_ASSERT_TRUE(report.indexOf("\"alloc_tracking\":true") >= 0);
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    MemoryManager::begin();
+    UNITY_BEGIN();
+    RUN_TEST(test_phase_counts_wrapped_allocations);
+    RUN_TEST(test_other_task_allocations_do_not_leak_into_phase);
+    RUN_TEST(test_largest_failed_allocation_keeps_maximum);
+    return UNITY_END();
+}
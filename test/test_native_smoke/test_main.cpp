@@ -0,0 +1,177 @@
+// test_main.cpp
+// ネイティブ環境でドメイン層とアプリケーション層を組み合わせて動かすテスト
+
+#include <unity.h>
+#include <string>
+#include <NativeHal.h>
+#include <TFT_eSPI.h>
+#include "application/ScheduleApplicationService.h"
+#include "application/ScheduleService.h"
+#include "infrastructure/APIScheduleRepository.h"
+#include "infrastructure/MemoryManager.h"
+#include "infrastructure/TFTDisplayService.h"
+#include "support/FileNetworkService.h"
+#include "support/RecordedFixture.h"
+
+void setUp(void)
+{
+    TestSupport::resetRecordedClock();
+}
+
+void tearDown(void)
+{
+}
+
+void test_fetch_and_render_recorded_schedules(void)
+{
+    TestSupport::FileNetworkService network;
+    Infrastructure::APIScheduleRepository repository(network);
+    Application::ScheduleService scheduleService(repository);
+    Infrastructure::TFTDisplayService display(21, 0);
+    Application::ScheduleApplicationService app(scheduleService, display, network);
+
+    display.initialize();
+    TFT_eSPI::resetPanelStats();
+
+    Domain::ScheduleSnapshot snapshot;
+    Application::ScheduleApplicationService::RefreshMetrics metrics = app.fetchAllData(snapshot);
+    app.applyFetchedData(snapshot, metrics);
+
+    TEST_ASSERT_TRUE(metrics.updated);
+    TEST_ASSERT_EQUAL(1, network.getRequestLog().size());
+    TEST_ASSERT_EQUAL_STRING("schedule", network.getRequestLog()[0].c_str());
+
+    // 全バトルタイプの現在と次のスロットが埋まる
+    for (size_t type = 0; type < Domain::BattleType::TYPE_COUNT; type++)
+    {
+        Domain::BattleType::Type battleType = static_cast<Domain::BattleType::Type>(type);
+        TEST_ASSERT_TRUE(snapshot.getCurrent(battleType).isValid());
+        TEST_ASSERT_TRUE(snapshot.getNext(battleType).isValid());
+        TEST_ASSERT_FALSE(snapshot.isStale(battleType));
+    }
+
+    // 画面に描画され、ステージ名（既定の表示はローマ字）が表示される
+    const TftPanelStats &stats = TFT_eSPI::panelStats();
+    TEST_ASSERT_GREATER_THAN(0, stats.pixels);
+    TEST_ASSERT_GREATER_THAN(0, app.getLastRefreshMetrics().pixelsPushed);
+    const char *stageName = snapshot.getCurrent(Domain::BattleType::Type::REGULAR).getStage1().getRomajiName();
+    TEST_ASSERT_TRUE(stats.text.find(stageName) != std::string::npos);
+}
+
+// 変化のない更新でも、取得中に出した更新インジケータは消える
+void test_unchanged_refresh_clears_update_indicator(void)
+{
+    TestSupport::FileNetworkService network;
+    Infrastructure::APIScheduleRepository repository(network);
+    Application::ScheduleService scheduleService(repository);
+    Infrastructure::TFTDisplayService display(21, 0);
+    Application::ScheduleApplicationService app(scheduleService, display, network);
+
+    display.initialize();
+    Domain::ScheduleSnapshot snapshot;
+    app.applyFetchedData(snapshot, app.fetchAllData(snapshot));
+    TEST_ASSERT_TRUE(display.isShowingSchedules());
+
+    display.showLoadingMessage("Updating data...", true);
+    TEST_ASSERT_TRUE(display.isUpdateIndicatorVisible());
+
+    Application::ScheduleApplicationService::RefreshMetrics metrics = app.fetchAllData(snapshot);
+    TEST_ASSERT_TRUE(metrics.result == Application::ScheduleApplicationService::RefreshResult::NOT_MODIFIED);
+    app.applyFetchedData(snapshot, metrics);
+
+    TEST_ASSERT_FALSE(display.isUpdateIndicatorVisible());
+}
+
+// 区画のスプライトは初期化時に1回だけ確保し、以降の描画では確保しない
+void test_quadrant_sprites_are_kept_between_updates(void)
+{
+    using Infrastructure::MemoryManager;
+
+    TestSupport::FileNetworkService network;
+    Infrastructure::APIScheduleRepository repository(network);
+    Application::ScheduleService scheduleService(repository);
+    Infrastructure::TFTDisplayService display(21, 0);
+    Application::ScheduleApplicationService app(scheduleService, display, network);
+
+    display.initialize();
+    uint32_t renderAllocations = MemoryManager::getPhaseStats(MemoryManager::Phase::RENDER).allocations;
+
+    Domain::ScheduleSnapshot snapshot;
+    app.applyFetchedData(snapshot, app.fetchAllData(snapshot));
+
+    // 別の画面を挟んで全区画を描き直しても確保しない
+    display.clearScreen();
+    app.applyFetchedData(snapshot, app.fetchAllData(snapshot));
+
+    TEST_ASSERT_EQUAL(renderAllocations, MemoryManager::getPhaseStats(MemoryManager::Phase::RENDER).allocations);
+    TEST_ASSERT_EQUAL(0, display.getDirectDrawCount());
+    TEST_ASSERT_EQUAL(0, app.getLastRefreshMetrics().directDraws);
+}
+
+// 初期化時にスプライトを確保できなかった場合は直接描画し、その回数を計測値に残す
+void test_direct_draw_is_counted_when_sprites_cannot_be_allocated(void)
+{
+    TFT_eSprite::setCreateLimit(1);
+
+    TestSupport::FileNetworkService network;
+    Infrastructure::APIScheduleRepository repository(network);
+    Application::ScheduleService scheduleService(repository);
+    Infrastructure::TFTDisplayService display(21, 0);
+    Application::ScheduleApplicationService app(scheduleService, display, network);
+
+    display.initialize();
+    TFT_eSPI::resetPanelStats();
+
+    Domain::ScheduleSnapshot snapshot;
+    app.applyFetchedData(snapshot, app.fetchAllData(snapshot));
+
+    TEST_ASSERT_EQUAL(1, display.getDirectDrawCount());
+    TEST_ASSERT_EQUAL(1, app.getLastRefreshMetrics().directDraws);
+    const char *stageName = snapshot.getCurrent(Domain::BattleType::Type::REGULAR).getStage1().getRomajiName();
+    TEST_ASSERT_TRUE(TFT_eSPI::panelStats().text.find(stageName) != std::string::npos);
+
+    // 変化のない更新は描き直さないため数えない
+    app.applyFetchedData(snapshot, app.fetchAllData(snapshot));
+    TEST_ASSERT_EQUAL(1, display.getDirectDrawCount());
+}
+
+void test_unchanged_refresh_is_not_modified(void)
+{
+    TestSupport::FileNetworkService network;
+    Infrastructure::APIScheduleRepository repository(network);
+    Application::ScheduleService scheduleService(repository);
+
+    TEST_ASSERT_TRUE(scheduleService.updateAllSchedules());
+
+    // 同じ内容の再取得は304になり、変化なしとして扱う
+    TEST_ASSERT_FALSE(scheduleService.updateAllSchedules());
+    TEST_ASSERT_EQUAL(2, network.getRequestLog().size());
+}
+
+void test_network_failure_keeps_previous_schedules(void)
+{
+    TestSupport::FileNetworkService network;
+    Infrastructure::APIScheduleRepository repository(network);
+    Application::ScheduleService scheduleService(repository);
+
+    TEST_ASSERT_TRUE(scheduleService.updateAllSchedules());
+    network.setConnected(false);
+    scheduleService.updateAllSchedules();
+
+    const Domain::ScheduleSnapshot &snapshot = scheduleService.getSnapshot();
+    TEST_ASSERT_TRUE(snapshot.getCurrent(Domain::BattleType::Type::X_MATCH).isValid());
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_fetch_and_render_recorded_schedules);
+    RUN_TEST(test_unchanged_refresh_clears_update_indicator);
+    RUN_TEST(test_quadrant_sprites_are_kept_between_updates);
+    RUN_TEST(test_direct_draw_is_counted_when_sprites_cannot_be_allocated);
+    RUN_TEST(test_unchanged_refresh_is_not_modified);
+    RUN_TEST(test_network_failure_keeps_previous_schedules);
+    return UNITY_END();
+}
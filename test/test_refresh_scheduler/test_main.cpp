@@ -0,0 +1,137 @@
+// test_main.cpp
+// RefreshSchedulerの境界に合わせた取得時刻と、ジッター付き指数バックオフのテスト
+
+#include <unity.h>
+#include <limits.h>
+#include "application/RefreshScheduler.h"
+
+using Application::RefreshScheduler;
+
+namespace
+{
+    // 現在時刻から次回の取得までの待ち時間
+    unsigned long delayFrom(const RefreshScheduler &scheduler, unsigned long nowMillis)
+    {
+        return scheduler.getNextRefreshMillis() - nowMillis;
+    }
+
+    // 揺らぎを除いた待ち時間の±25%に収まっているか
+    void expectWithinJitter(unsigned long baseDelay, unsigned long actualDelay)
+    {
+        TEST_ASSERT_TRUE(actualDelay >= baseDelay - baseDelay / 4);
+        TEST_ASSERT_TRUE(actualDelay <= baseDelay + baseDelay / 4);
+    }
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+// 境界の少し後に取得し、境界が遠い場合も上限の間隔で取得する
+void test_schedules_after_boundary(void)
+{
+    RefreshScheduler scheduler;
+    const unsigned long now = 5000;
+
+    scheduler.scheduleAtBoundary(now, 30 * 60);
+    TEST_ASSERT_EQUAL(30UL * 60 * 1000 + RefreshScheduler::SETTLE_DELAY, delayFrom(scheduler, now));
+    TEST_ASSERT_FALSE(scheduler.isRefreshDue(now + 30UL * 60 * 1000));
+    TEST_ASSERT_TRUE(scheduler.isRefreshDue(now + 30UL * 60 * 1000 + RefreshScheduler::SETTLE_DELAY));
+
+    scheduler.scheduleAtBoundary(now, 24 * 60 * 60);
+    TEST_ASSERT_EQUAL(RefreshScheduler::MAX_REFRESH_INTERVAL, delayFrom(scheduler, now));
+}
+
+// 失敗するたびに待ち時間が倍になり、上限で止まる
+void test_retry_backs_off_to_the_limit(void)
+{
+    RefreshScheduler scheduler(12345);
+    unsigned long now = 1000;
+    unsigned long baseDelay = RefreshScheduler::RETRY_BASE_DELAY;
+
+    for (unsigned int attempt = 0; attempt < 10; attempt++)
+    {
+        scheduler.scheduleRetry(now);
+        expectWithinJitter(baseDelay, delayFrom(scheduler, now));
+        TEST_ASSERT_EQUAL(attempt + 1, scheduler.getFailureCount());
+
+        now = scheduler.getNextRefreshMillis();
+        baseDelay *= 2;
+        if (baseDelay > RefreshScheduler::RETRY_MAX_DELAY)
+        {
+            baseDelay = RefreshScheduler::RETRY_MAX_DELAY;
+        }
+    }
+}
+
+// 成功すると失敗回数が戻り、次の失敗は初回の待ち時間から始まる
+void test_success_resets_backoff(void)
+{
+    RefreshScheduler scheduler(7);
+    for (int i = 0; i < 5; i++)
+    {
+        scheduler.scheduleRetry(0);
+    }
+
+    scheduler.scheduleAtBoundary(0, 60);
+    TEST_ASSERT_EQUAL(0, scheduler.getFailureCount());
+
+    scheduler.scheduleRetry(0);
+    expectWithinJitter(RefreshScheduler::RETRY_BASE_DELAY, delayFrom(scheduler, 0));
+}
+
+// 種が違う端末は同じ失敗でも再試行の時刻がずれる
+void test_jitter_spreads_devices(void)
+{
+    unsigned long firstDelay = 0;
+    bool spread = false;
+    for (uint32_t seed = 1; seed <= 8; seed++)
+    {
+        RefreshScheduler scheduler(seed);
+        scheduler.scheduleRetry(0);
+        unsigned long delay = delayFrom(scheduler, 0);
+        expectWithinJitter(RefreshScheduler::RETRY_BASE_DELAY, delay);
+
+        if (seed == 1)
+        {
+            firstDelay = delay;
+        }
+        else if (delay != firstDelay)
+        {
+            spread = true;
+        }
+    }
+    TEST_ASSERT_TRUE(spread);
+}
+
+// millis()が一周しても取得時刻の判定が狂わない
+void test_due_check_survives_millis_wraparound(void)
+{
+    RefreshScheduler scheduler;
+    const unsigned long now = ULONG_MAX - 10000;
+
+    scheduler.scheduleAtBoundary(now, 0);
+    TEST_ASSERT_FALSE(scheduler.isRefreshDue(now));
+    TEST_ASSERT_FALSE(scheduler.isRefreshDue(now + RefreshScheduler::SETTLE_DELAY - 1));
+    TEST_ASSERT_TRUE(scheduler.isRefreshDue(now + RefreshScheduler::SETTLE_DELAY));
+
+    scheduler.requestImmediateRefresh(now);
+    TEST_ASSERT_TRUE(scheduler.isRefreshDue(now));
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_schedules_after_boundary);
+    RUN_TEST(test_retry_backs_off_to_the_limit);
+    RUN_TEST(test_success_resets_backoff);
+    RUN_TEST(test_jitter_spreads_devices);
+    RUN_TEST(test_due_check_survives_millis_wraparound);
+    return UNITY_END();
+}
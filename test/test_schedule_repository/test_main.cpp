@@ -0,0 +1,241 @@
+// test_main.cpp
+// APIScheduleRepositoryのスロットの格納と、取得結果の判定のテスト
+
+#include <unity.h>
+#include <NativeHal.h>
+#include <TFT_eSPI.h>
+#include "application/ScheduleApplicationService.h"
+#include "application/ScheduleService.h"
+#include "infrastructure/APIScheduleRepository.h"
+#include "infrastructure/TFTDisplayService.h"
+#include "support/FileNetworkService.h"
+#include "support/RecordedFixture.h"
+
+using Domain::BattleType;
+using Infrastructure::APIScheduleRepository;
+using TestSupport::FIRST_SLOT_START;
+using TestSupport::SLOT_SECONDS;
+
+namespace
+{
+    // 時刻が未同期の状態（スロットの終了を時計では判定できない）
+    constexpr time_t UNSYNCED_EPOCH = 1000;
+
+    void expectSlot(const Domain::BattleSchedule &schedule, time_t start)
+    {
+        TEST_ASSERT_TRUE(schedule.isValid());
+        TEST_ASSERT_EQUAL(start, schedule.getStartEpoch());
+        TEST_ASSERT_EQUAL(start + SLOT_SECONDS, schedule.getEndEpoch());
+    }
+}
+
+void setUp(void)
+{
+    TestSupport::resetRecordedClock();
+}
+
+void tearDown(void)
+{
+}
+
+// 境界後の更新で/nextが失敗しても、次回のスロットに現在のスロットが重複しない
+void test_boundary_refresh_with_failed_next_keeps_cached_next(void)
+{
+    TestSupport::FileNetworkService network;
+    APIScheduleRepository repository(network);
+    repository.setFetchMode(APIScheduleRepository::FetchMode::PER_ENDPOINT);
+    TEST_ASSERT_TRUE(repository.updateAllSchedules());
+
+    NativeHal::advanceMillis(SLOT_SECONDS * 1000);
+    network.setScenario("spla3_next");
+    network.setFailing("regular/next", true);
+    repository.updateAllSchedules();
+    TEST_ASSERT_FALSE(repository.getLastUpdateStats().confirmed);
+
+    Domain::ScheduleSnapshot snapshot;
+    repository.readSnapshot(snapshot);
+    expectSlot(snapshot.getCurrent(BattleType::Type::REGULAR), FIRST_SLOT_START + SLOT_SECONDS);
+    expectSlot(snapshot.getNext(BattleType::Type::REGULAR), FIRST_SLOT_START + 2 * SLOT_SECONDS);
+    expectSlot(snapshot.getNext(BattleType::Type::X_MATCH), FIRST_SLOT_START + 2 * SLOT_SECONDS);
+}
+
+// 時計で進められなくても、/nowのレスポンスで保持しているスロットをずらす
+void test_current_response_shifts_held_slots(void)
+{
+    NativeHal::setEpoch(UNSYNCED_EPOCH);
+    TestSupport::FileNetworkService network;
+    APIScheduleRepository repository(network);
+    repository.setFetchMode(APIScheduleRepository::FetchMode::PER_ENDPOINT);
+    repository.updateAllSchedules();
+
+    network.setScenario("spla3_next");
+    network.setFailing("x/next", true);
+    repository.updateAllSchedules();
+
+    Domain::ScheduleSnapshot snapshot;
+    repository.readSnapshot(snapshot);
+    expectSlot(snapshot.getCurrent(BattleType::Type::X_MATCH), FIRST_SLOT_START + SLOT_SECONDS);
+    expectSlot(snapshot.getNext(BattleType::Type::X_MATCH), FIRST_SLOT_START + 2 * SLOT_SECONDS);
+}
+
+// /nowが失敗した場合、/nextは終わった先頭のスロットではなく、その続きのスロットの後ろに格納する
+void test_next_response_skips_ended_current_slot(void)
+{
+    NativeHal::setEpoch(UNSYNCED_EPOCH);
+    TestSupport::FileNetworkService network;
+    APIScheduleRepository repository(network);
+    repository.setFetchMode(APIScheduleRepository::FetchMode::PER_ENDPOINT);
+    repository.updateAllSchedules();
+
+    network.setScenario("spla3_next");
+    network.setFailing("bankara-open/now", true);
+    repository.updateAllSchedules();
+
+    Domain::ScheduleSnapshot snapshot;
+    repository.readSnapshot(snapshot);
+    expectSlot(snapshot.getCurrent(BattleType::Type::BANKARA_OPEN), FIRST_SLOT_START + SLOT_SECONDS);
+    expectSlot(snapshot.getNext(BattleType::Type::BANKARA_OPEN), FIRST_SLOT_START + 2 * SLOT_SECONDS);
+}
+
+// 取得結果：失敗（保持分で進んだ場合を含む）、変化なし（304）、更新
+void test_refresh_result_reports_failure_separately_from_change(void)
+{
+    TestSupport::FileNetworkService network;
+    APIScheduleRepository repository(network);
+    Application::ScheduleService scheduleService(repository);
+    Infrastructure::TFTDisplayService display(21, 0);
+    Application::ScheduleApplicationService app(scheduleService, display, network);
+    Domain::ScheduleSnapshot snapshot;
+
+    TEST_ASSERT_TRUE(app.fetchAllData(snapshot).result ==
+                     Application::ScheduleApplicationService::RefreshResult::UPDATED);
+    TEST_ASSERT_TRUE(app.fetchAllData(snapshot).result ==
+                     Application::ScheduleApplicationService::RefreshResult::NOT_MODIFIED);
+
+    // 通信できないまま境界を過ぎると、保持分で次のスロットに進むが結果は失敗になる
+    network.setConnected(false);
+    NativeHal::advanceMillis(SLOT_SECONDS * 1000);
+    Application::ScheduleApplicationService::RefreshMetrics metrics = app.fetchAllData(snapshot);
+    TEST_ASSERT_TRUE(metrics.updated);
+    TEST_ASSERT_TRUE(metrics.result == Application::ScheduleApplicationService::RefreshResult::FAILED);
+    expectSlot(snapshot.getCurrent(BattleType::Type::REGULAR), FIRST_SLOT_START + SLOT_SECONDS);
+}
+
+// 取得が止まっていても、時間の経過だけで古いことを示して描き直す
+void test_staleness_is_reevaluated_without_fetching(void)
+{
+    TestSupport::FileNetworkService network;
+    APIScheduleRepository repository(network);
+    Application::ScheduleService scheduleService(repository);
+    Infrastructure::TFTDisplayService display(21, 0);
+    Application::ScheduleApplicationService app(scheduleService, display, network);
+    display.initialize();
+
+    Domain::ScheduleSnapshot snapshot;
+    Application::ScheduleApplicationService::RefreshMetrics metrics = app.fetchAllData(snapshot);
+    app.applyFetchedData(snapshot, metrics);
+    TEST_ASSERT_FALSE(snapshot.isStale(BattleType::Type::REGULAR));
+
+    // 毎分の時刻表示の更新を3時間の直前まで繰り返しても古くならない
+    unsigned long confirmedAt = millis();
+    while (millis() - confirmedAt < Domain::ScheduleSnapshot::STALE_AFTER_MILLIS - 60000)
+    {
+        NativeHal::advanceMillis(60000);
+        TEST_ASSERT_FALSE(app.refreshStaleness(millis()));
+    }
+
+    TFT_eSPI::resetPanelStats();
+    NativeHal::advanceMillis(60000);
+    TEST_ASSERT_TRUE(app.refreshStaleness(millis()));
+    TEST_ASSERT_GREATER_THAN(0, TFT_eSPI::panelStats().pixels);
+
+    // 一度示した後は変わらない限り描き直さない
+    NativeHal::advanceMillis(60000);
+    TEST_ASSERT_FALSE(app.refreshStaleness(millis()));
+}
+
+// 並行して要求すると、サーバーの応答待ちが重なる（結果は1本ずつと同じ）
+// /nextは同じバトルタイプの/nowを待たずに要求するため、8リクエストを接続数で割った回数分で終わる
+void test_requests_in_flight_overlap_server_latency(void)
+{
+    const unsigned long latency = 100;
+    const size_t maxInFlightCounts[] = {1, 2, 3};
+    const unsigned long expectedRounds[] = {8, 4, 3};
+    Domain::ScheduleSnapshot snapshots[3];
+
+    for (size_t run = 0; run < 3; run++)
+    {
+        TestSupport::FileNetworkService network;
+        network.setLatency(latency);
+        network.setMaxInFlight(maxInFlightCounts[run]);
+        APIScheduleRepository repository(network);
+        repository.setFetchMode(APIScheduleRepository::FetchMode::PER_ENDPOINT);
+
+        unsigned long start = millis();
+        TEST_ASSERT_TRUE(repository.updateAllSchedules());
+        unsigned long elapsed = millis() - start;
+        TEST_ASSERT_EQUAL(8, repository.getLastUpdateStats().requestCount);
+        TEST_ASSERT_TRUE(repository.getLastUpdateStats().confirmed);
+        repository.readSnapshot(snapshots[run]);
+
+        // 待機ループの1msずつを許容する
+        TEST_ASSERT_GREATER_OR_EQUAL(expectedRounds[run] * latency, elapsed);
+        TEST_ASSERT_LESS_OR_EQUAL(expectedRounds[run] * latency + 20, elapsed);
+    }
+
+    for (size_t run = 1; run < 3; run++)
+    {
+        for (size_t index = 0; index < BattleType::TYPE_COUNT; index++)
+        {
+            BattleType::Type type = static_cast<BattleType::Type>(index);
+            TEST_ASSERT_EQUAL(snapshots[0].getCurrent(type).getStartEpoch(), snapshots[run].getCurrent(type).getStartEpoch());
+            TEST_ASSERT_EQUAL(snapshots[0].getNext(type).getStartEpoch(), snapshots[run].getNext(type).getStartEpoch());
+            TEST_ASSERT_TRUE(snapshots[0].getCurrent(type).getStage1().getType() ==
+                             snapshots[run].getCurrent(type).getStage1().getType());
+        }
+    }
+}
+
+// /nextの応答が/nowより先に届いても、/nowで保持しているスロットをずらしてから後ろに続ける
+void test_next_arriving_before_current_is_stored_after_it(void)
+{
+    NativeHal::setEpoch(UNSYNCED_EPOCH);
+    TestSupport::FileNetworkService network;
+    network.setLatency(100);
+    network.setMaxInFlight(8);
+    APIScheduleRepository repository(network);
+    repository.setFetchMode(APIScheduleRepository::FetchMode::PER_ENDPOINT);
+    TEST_ASSERT_TRUE(repository.updateAllSchedules());
+
+    // 次のスロットに進んだレスポンスで、/nowだけを遅らせる
+    NativeHal::advanceMillis(60 * 1000);
+    network.setScenario("spla3_next");
+    network.setExtraLatency("x/now", 200);
+    TEST_ASSERT_TRUE(repository.updateAllSchedules());
+    TEST_ASSERT_TRUE(repository.getLastUpdateStats().confirmed);
+
+    Domain::ScheduleSnapshot snapshot;
+    repository.readSnapshot(snapshot);
+    expectSlot(snapshot.getCurrent(BattleType::Type::X_MATCH), FIRST_SLOT_START + SLOT_SECONDS);
+    expectSlot(snapshot.getNext(BattleType::Type::X_MATCH), FIRST_SLOT_START + 2 * SLOT_SECONDS);
+
+    // 格納できた/nextの検証子は保存され、同じ内容の再取得は304になる
+    NativeHal::advanceMillis(60 * 1000);
+    TEST_ASSERT_FALSE(repository.updateAllSchedules());
+    TEST_ASSERT_TRUE(repository.getLastUpdateStats().confirmed);
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_boundary_refresh_with_failed_next_keeps_cached_next);
+    RUN_TEST(test_current_response_shifts_held_slots);
+    RUN_TEST(test_next_response_skips_ended_current_slot);
+    RUN_TEST(test_refresh_result_reports_failure_separately_from_change);
+    RUN_TEST(test_staleness_is_reevaluated_without_fetching);
+    RUN_TEST(test_requests_in_flight_overlap_server_latency);
+    RUN_TEST(test_next_arriving_before_current_is_stored_after_it);
+    return UNITY_END();
+}
@@ -0,0 +1,143 @@
+// test_main.cpp
+// 記録したレスポンスをストリームで少しずつ渡し、フィルタ付きの解析で同じスケジュールになることのテスト
+
+#include <unity.h>
+#include <NativeHal.h>
+#include "infrastructure/APIScheduleRepository.h"
+#include "support/FileNetworkService.h"
+#include "support/RecordedFixture.h"
+
+using Domain::BattleType;
+using Domain::Rule;
+using Domain::Stage;
+using Infrastructure::APIScheduleRepository;
+using TestSupport::FIRST_SLOT_START;
+using TestSupport::SLOT_SECONDS;
+
+namespace
+{
+    // 記録したレスポンスの最初のスロットのルールとステージ
+    struct ExpectedSlot
+    {
+        BattleType::Type battleType;
+        Rule::Type rule;
+        Stage::Type stage1;
+        Stage::Type stage2;
+    };
+
+    const ExpectedSlot FIRST_SLOTS[] = {
+        {BattleType::Type::REGULAR, Rule::Type::TURF_WAR, Stage::Type::SCORCH_GORGE, Stage::Type::MINCEMEAT_METALWORKS},
+        {BattleType::Type::X_MATCH, Rule::Type::CLAM_BLITZ, Stage::Type::BLUEFIN_DEPOT, Stage::Type::UMAMI_RUINS},
+        {BattleType::Type::BANKARA_CHALLENGE, Rule::Type::TOWER_CONTROL, Stage::Type::BARNACLE_AND_DIME,
+         Stage::Type::STURGEON_SHIPYARD},
+        {BattleType::Type::BANKARA_OPEN, Rule::Type::RAINMAKER, Stage::Type::MAKO_MART, Stage::Type::BLUEFIN_DEPOT},
+    };
+
+    // 指定した取得方法と1回に読める量で取得し、最初のスロットと次のスロットを確かめる
+    void expectRecordedSchedules(APIScheduleRepository::FetchMode mode, size_t chunkSize)
+    {
+        Domain::ScheduleSnapshot snapshot;
+        TEST_ASSERT_TRUE(TestSupport::fetchRecordedSnapshot(snapshot, mode, chunkSize));
+        for (const ExpectedSlot &expected : FIRST_SLOTS)
+        {
+            const Domain::BattleSchedule &current = snapshot.getCurrent(expected.battleType);
+            TEST_ASSERT_TRUE(current.isValid());
+            TEST_ASSERT_EQUAL(FIRST_SLOT_START, current.getStartEpoch());
+            TEST_ASSERT_EQUAL(FIRST_SLOT_START + SLOT_SECONDS, current.getEndEpoch());
+            TEST_ASSERT_TRUE(current.getRule().getType() == expected.rule);
+            TEST_ASSERT_TRUE(current.getStage1().getType() == expected.stage1);
+            TEST_ASSERT_TRUE(current.getStage2().getType() == expected.stage2);
+
+            const Domain::BattleSchedule &next = snapshot.getNext(expected.battleType);
+            TEST_ASSERT_TRUE(next.isValid());
+            TEST_ASSERT_EQUAL(FIRST_SLOT_START + SLOT_SECONDS, next.getStartEpoch());
+            TEST_ASSERT_TRUE(next.getRule().getType() != Rule::Type::UNKNOWN);
+            TEST_ASSERT_TRUE(next.getStage1().getType() != Stage::Type::UNKNOWN);
+        }
+    }
+}
+
+void setUp(void)
+{
+    TestSupport::resetRecordedClock();
+}
+
+void tearDown(void)
+{
+}
+
+// 一括取得のレスポンスを一度に渡しても、1バイトずつ渡しても同じ結果になる
+void test_bulk_response_parses_in_any_chunking(void)
+{
+    const size_t chunkSizes[] = {0, 1, 7, 61, 1460};
+    for (size_t chunkSize : chunkSizes)
+    {
+        expectRecordedSchedules(APIScheduleRepository::FetchMode::BULK, chunkSize);
+    }
+}
+
+// エンドポイントごとのレスポンスも同じく解析できる
+void test_endpoint_responses_parse_in_any_chunking(void)
+{
+    const size_t chunkSizes[] = {0, 1, 13};
+    for (size_t chunkSize : chunkSizes)
+    {
+        expectRecordedSchedules(APIScheduleRepository::FetchMode::PER_ENDPOINT, chunkSize);
+    }
+}
+
+// 一括取得（全バトルタイプ12スロット分）もエンドポイントごとの取得も、解析は汎用ヒープに溢れない
+void test_parse_stays_within_json_arena(void)
+{
+    const APIScheduleRepository::FetchMode modes[] = {
+        APIScheduleRepository::FetchMode::BULK,
+        APIScheduleRepository::FetchMode::PER_ENDPOINT};
+    for (APIScheduleRepository::FetchMode mode : modes)
+    {
+        TestSupport::FileNetworkService network;
+        APIScheduleRepository repository(network);
+        repository.setFetchMode(mode);
+
+        TEST_ASSERT_TRUE(repository.updateAllSchedules());
+        TEST_ASSERT_TRUE(repository.getLastUpdateStats().confirmed);
+        TEST_ASSERT_EQUAL(0, repository.getLastUpdateStats().heapFallbacks);
+        TEST_ASSERT_TRUE(repository.getLastUpdateStats().jsonPeakBytes > 0);
+    }
+}
+
+// 途中で切れたレスポンスは失敗として扱い、前回のスケジュールを使い続ける
+void test_truncated_response_keeps_previous_schedules(void)
+{
+    TestSupport::FileNetworkService network;
+    APIScheduleRepository repository(network);
+    TEST_ASSERT_TRUE(repository.updateAllSchedules());
+
+    // 一括取得は途中で切れ、エンドポイントごとのレスポンスは記録がないため失敗する
+    NativeHal::advanceMillis(60 * 1000);
+    network.setScenario("spla3_truncated");
+    network.setChunkSize(64);
+    repository.updateAllSchedules();
+    TEST_ASSERT_FALSE(repository.getLastUpdateStats().confirmed);
+
+    Domain::ScheduleSnapshot snapshot;
+    repository.readSnapshot(snapshot);
+    for (const ExpectedSlot &expected : FIRST_SLOTS)
+    {
+        const Domain::BattleSchedule &current = snapshot.getCurrent(expected.battleType);
+        TEST_ASSERT_EQUAL(FIRST_SLOT_START, current.getStartEpoch());
+        TEST_ASSERT_TRUE(current.getRule().getType() == expected.rule);
+        TEST_ASSERT_TRUE(current.getStage1().getType() == expected.stage1);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_bulk_response_parses_in_any_chunking);
+    RUN_TEST(test_endpoint_responses_parse_in_any_chunking);
+    RUN_TEST(test_parse_stays_within_json_arena);
+    RUN_TEST(test_truncated_response_keeps_previous_schedules);
+    return UNITY_END();
+}